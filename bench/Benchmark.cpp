@@ -0,0 +1,157 @@
+
+#include "Benchmark.h"
+
+#include <fmt/core.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+namespace Bench {
+    namespace {
+        std::vector<std::unique_ptr<Benchmark>>& registry() {
+            static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+            return benchmarks;
+        }
+
+        struct Result {
+            std::string name;
+            uint64_t iterations;
+            double real_time;
+            double cpu_time;
+            double items_per_second;
+            std::string label;
+            std::string error;
+        };
+
+        /// 解析非负的秒数，格式无效时返回 false
+        bool parseSeconds(const std::string& text, double& seconds) {
+            double value = 0;
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc() || end != text.data() + text.size() || !std::isfinite(value) || value < 0) {
+                return false;
+            }
+            seconds = value;
+            return true;
+        }
+
+        std::string escape(const std::string& text) {
+            std::string out;
+            for (auto c : text) {
+                if (c == '"' || c == '\\') out.push_back('\\');
+                if (static_cast<unsigned char>(c) >= 0x20) out.push_back(c);
+            }
+            return out;
+        }
+
+        Result runOne(const Benchmark& benchmark, const std::string& name, int64_t range, double min_time) {
+            // 迭代次数逐步翻倍，直至总耗时达到最短测试时间
+            uint64_t iterations = benchmark.fixedIterations() ? benchmark.fixedIterations() : 1;
+            while (true) {
+                State state(range, iterations);
+                benchmark.run(state);
+                const double seconds = state.realTime() / 1e9;
+                const bool is_done = benchmark.fixedIterations() || !state.error().empty() ||
+                                     seconds >= min_time || iterations >= 1'000'000'000;
+                if (is_done) {
+                    return {name, iterations, state.realTime() / static_cast<double>(iterations),
+                            state.cpuTime() / static_cast<double>(iterations),
+                            state.itemsProcessed() && seconds > 0
+                                ? static_cast<double>(state.itemsProcessed()) / seconds : 0.0,
+                            state.label(), state.error()};
+                }
+                // 根据本次耗时估算所需次数，最多扩大 10 倍
+                double multiplier = seconds > 0 ? min_time * 1.4 / seconds : 10.0;
+                multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+                iterations = static_cast<uint64_t>(static_cast<double>(iterations) * multiplier);
+            }
+        }
+
+        bool writeJSON(const std::string& path, const std::vector<Result>& results) {
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) {
+                fmt::print(stderr, "[ERROR] Can't open the file '{}' for writing results!\n", path);
+                return false;
+            }
+            auto now = std::time(nullptr);
+            char date[64] = {};
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+            file << "{\n  \"context\": {\n";
+            file << fmt::format("    \"date\": \"{}\",\n", date);
+            file << fmt::format("    \"num_cpus\": {},\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+            file << "    \"library_build_type\": \"release\"\n";
+#else
+            file << "    \"library_build_type\": \"debug\"\n";
+#endif
+            file << "  },\n  \"benchmarks\": [";
+            for (size_t i = 0; i < results.size(); ++i) {
+                auto& result = results[i];
+                file << (i ? ",\n" : "\n") << "    {\n";
+                file << fmt::format("      \"name\": \"{}\",\n", escape(result.name));
+                file << fmt::format("      \"run_name\": \"{}\",\n", escape(result.name));
+                file << "      \"run_type\": \"iteration\",\n";
+                if (!result.error.empty()) {
+                    file << "      \"error_occurred\": true,\n";
+                    file << fmt::format("      \"error_message\": \"{}\",\n", escape(result.error));
+                }
+                file << fmt::format("      \"iterations\": {},\n", result.iterations);
+                file << fmt::format("      \"real_time\": {:.4f},\n", result.real_time);
+                file << fmt::format("      \"cpu_time\": {:.4f},\n", result.cpu_time);
+                if (result.items_per_second > 0) {
+                    file << fmt::format("      \"items_per_second\": {:.4f},\n", result.items_per_second);
+                }
+                if (!result.label.empty()) {
+                    file << fmt::format("      \"label\": \"{}\",\n", escape(result.label));
+                }
+                file << "      \"time_unit\": \"ns\"\n    }";
+            }
+            file << "\n  ]\n}\n";
+            return file.good();
+        }
+    }
+
+    Benchmark* registerBenchmark(const std::string& name, const std::function<void(State&)>& function) {
+        registry().push_back(std::make_unique<Benchmark>(name, function));
+        return registry().back().get();
+    }
+
+    int runAll(int argc, char** argv) {
+        std::string filter, output;
+        double min_time = 0.5;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.starts_with("--filter=")) filter = arg.substr(9);
+            else if (arg.starts_with("--out=")) output = arg.substr(6);
+            else if (arg.starts_with("--min-time=") && parseSeconds(arg.substr(11), min_time)) continue;
+            else {
+                fmt::print("Usage: {} [--filter=<name>] [--out=<result.json>] [--min-time=<seconds>]\n", argv[0]);
+                return arg == "--help" ? 0 : 1;
+            }
+        }
+        std::vector<Result> results;
+        fmt::print("{:<40} {:>15} {:>15} {:>12} {:>15}\n", "Benchmark", "Time (ns)", "CPU (ns)",
+                   "Iterations", "Items/s");
+        fmt::print("{}\n", std::string(101, '-'));
+        for (auto& benchmark : registry()) {
+            std::vector<int64_t> args = benchmark->args();
+            if (args.empty()) args.push_back(0);
+            for (auto arg : args) {
+                auto name = benchmark->args().empty() ? benchmark->name()
+                                                      : fmt::format("{}/{}", benchmark->name(), arg);
+                if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+                auto result = runOne(*benchmark, name, arg, min_time);
+                if (!result.error.empty()) {
+                    fmt::print("{:<40} ERROR: {}\n", result.name, result.error);
+                } else {
+                    fmt::print("{:<40} {:>15.1f} {:>15.1f} {:>12} {:>15.0f} {}\n", result.name, result.real_time,
+                               result.cpu_time, result.iterations, result.items_per_second, result.label);
+                }
+                results.push_back(std::move(result));
+            }
+        }
+        if (!output.empty() && !writeJSON(output, results)) return 1;
+        return 0;
+    }
+}
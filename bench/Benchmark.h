@@ -0,0 +1,158 @@
+#pragma once
+#ifndef EASYENGINE_BENCHMARK_H
+#define EASYENGINE_BENCHMARK_H
+
+/**
+ * @file Benchmark.h
+ * @brief 基准测试框架
+ *
+ * 仿照 Google Benchmark 的轻量级基准测试框架，无需额外依赖。
+ * 结果可输出为与 Google Benchmark 相同格式的 JSON，便于在各版本之间对比性能。
+ *
+ * @copyright Copyright © 2025 CatIsNotFound
+ * @author CatIsNotFound
+ */
+
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Bench {
+    /**
+     * @class State
+     * @brief 单次基准测试的运行状态
+     *
+     * @code
+     * void BM_Example(Bench::State& state) {
+     *     for (auto _ : state) {
+     *         // 被测代码
+     *     }
+     *     state.setItemsProcessed(state.iterations() * state.range());
+     * }
+     * @endcode
+     */
+    class State {
+    public:
+        struct Iterator {
+            State* state;
+            uint64_t remaining;
+            bool operator!=(const Iterator&) const {
+                if (remaining) return true;
+                state->stopTiming();
+                return false;
+            }
+            void operator++() { --remaining; }
+            int operator*() const { return 0; }
+        };
+        State(int64_t range, uint64_t iterations) : _range(range), _iterations(iterations) {}
+        Iterator begin() {
+            startTiming();
+            return {this, _iterations};
+        }
+        Iterator end() { return {this, 0}; }
+        /// 获取当前参数
+        int64_t range() const { return _range; }
+        /// 获取迭代次数
+        uint64_t iterations() const { return _iterations; }
+        /// 暂停计时（用于排除每次迭代的准备工作）
+        void pauseTiming() { stopTiming(); }
+        /// 恢复计时
+        void resumeTiming() { startTiming(); }
+        /// 设置处理的元素总数，用于计算每秒处理量
+        void setItemsProcessed(uint64_t items) { _items = items; }
+        /// 设置额外的说明
+        void setLabel(const std::string& label) { _label = label; }
+        /// 标记此次测试出错并跳过
+        void skipWithError(const std::string& error) { _error = error; }
+        double realTime() const { return _real_ns; }
+        double cpuTime() const { return _cpu_ns; }
+        uint64_t itemsProcessed() const { return _items; }
+        const std::string& label() const { return _label; }
+        const std::string& error() const { return _error; }
+    private:
+        void startTiming() {
+            if (_timing) return;
+            _timing = true;
+            _real_start = std::chrono::steady_clock::now();
+            _cpu_start = std::clock();
+        }
+        void stopTiming() {
+            if (!_timing) return;
+            _timing = false;
+            _real_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - _real_start).count();
+            _cpu_ns += static_cast<double>(std::clock() - _cpu_start) * 1e9 / CLOCKS_PER_SEC;
+        }
+        int64_t _range;
+        uint64_t _iterations;
+        uint64_t _items{0};
+        bool _timing{false};
+        std::chrono::steady_clock::time_point _real_start;
+        std::clock_t _cpu_start{0};
+        double _real_ns{0.0};
+        double _cpu_ns{0.0};
+        std::string _label;
+        std::string _error;
+    };
+
+    /**
+     * @class Benchmark
+     * @brief 已注册的基准测试
+     */
+    class Benchmark {
+    public:
+        Benchmark(std::string name, std::function<void(State&)> function)
+            : _name(std::move(name)), _function(std::move(function)) {}
+        /// 追加一个参数，每个参数单独运行一次
+        Benchmark* arg(int64_t value) { _args.push_back(value); return this; }
+        /// 指定固定的迭代次数（适用于耗时较长的宏观测试）
+        Benchmark* iterations(uint64_t count) { _fixed_iterations = count; return this; }
+        const std::string& name() const { return _name; }
+        const std::vector<int64_t>& args() const { return _args; }
+        uint64_t fixedIterations() const { return _fixed_iterations; }
+        void run(State& state) const { _function(state); }
+    private:
+        std::string _name;
+        std::function<void(State&)> _function;
+        std::vector<int64_t> _args;
+        uint64_t _fixed_iterations{0};
+    };
+
+    /**
+     * @brief 注册基准测试
+     */
+    Benchmark* registerBenchmark(const std::string& name, const std::function<void(State&)>& function);
+    /**
+     * @brief 运行所有已注册的基准测试
+     * @param argc 命令行参数个数
+     * @param argv 命令行参数（支持 `--filter=`、`--out=`、`--min-time=`）
+     * @return 返回程序退出码
+     */
+    int runAll(int argc, char** argv);
+    /**
+     * @brief 防止编译器优化掉无用的计算结果
+     */
+    template<typename T>
+    inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+/**
+ * @def BENCHMARK
+ * @brief 注册基准测试函数
+ */
+#define BENCHMARK(function) \
+    static Bench::Benchmark* BENCH_CONCAT(_bench_, __LINE__) = Bench::registerBenchmark(#function, function)
+
+#endif //EASYENGINE_BENCHMARK_H
@@ -0,0 +1,315 @@
+#include "../src/Core.h"
+#include "Benchmark.h"
+
+#include <random>
+
+using namespace EasyEngine;
+
+namespace {
+    Engine* engine = nullptr;
+    std::string temp_dir;
+
+    /// 生成固定种子的随机数，保证每次运行的输入一致
+    std::mt19937& random() {
+        static std::mt19937 generator(20250101);
+        return generator;
+    }
+
+    float randomFloat(float min, float max) {
+        return std::uniform_real_distribution<float>(min, max)(random());
+    }
+
+    /// 准备基准测试所需的资源文件
+    void prepareResources() {
+        temp_dir = (std::filesystem::temp_directory_path() / "easyengine_bench").string();
+        std::filesystem::create_directories(temp_dir);
+        auto surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_RGBA8888);
+        SDL_FillSurfaceRect(surface, nullptr, SDL_MapSurfaceRGBA(surface, 255, 128, 0, 255));
+        SDL_SaveBMP(surface, (temp_dir + "/sprite.bmp").c_str());
+        SDL_DestroySurface(surface);
+        std::ofstream text(temp_dir + "/text.txt", std::ios::out | std::ios::trunc);
+        for (int i = 0; i < 16384; ++i) text << "EasyEngine benchmark 基准测试 " << i << '\n';
+        text.close();
+        auto res = ResourceSystem::global();
+        res->append("bench_sprite", temp_dir + "/sprite.bmp", Resource::Image);
+        res->append("bench_text", temp_dir + "/text.txt", Resource::Text);
+    }
+
+    std::vector<Vector2> randomPositions(size_t count) {
+        std::vector<Vector2> positions(count);
+        for (auto& pos : positions) pos.reset(randomFloat(0, 768), randomFloat(0, 568));
+        return positions;
+    }
+}
+
+/// 记录绘制命令（不执行）
+void BM_PainterRecord(Bench::State& state) {
+    auto painter = engine->painter();
+    Components::Sprite sprite("sprite", "bench_sprite", painter);
+    auto positions = randomPositions(static_cast<size_t>(state.range()));
+    for (auto _ : state) {
+        for (auto& pos : positions) painter->drawSprite(sprite, pos);
+        state.pauseTiming();
+        painter->clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_PainterRecord)->arg(1000)->arg(10000)->arg(100000);
+
+/// 完整的帧：记录、执行命令并刷新画面（无窗口模式下的软件渲染器）
+void BM_PainterFrame(Bench::State& state) {
+    constexpr uint64_t FRAMES = 30;
+    auto painter = engine->painter();
+    Components::Sprite sprite("sprite", "bench_sprite", painter);
+    auto positions = randomPositions(static_cast<size_t>(state.range()));
+    painter->installPaintEvent([&](Painter& p) {
+        p.fillBackColor(StdColor::Black);
+        for (auto& pos : positions) p.drawSprite(sprite, pos);
+    });
+    engine->setFPS(0);
+    engine->setFrameLimit(FRAMES);
+    double render_time = 0;
+    for (auto _ : state) {
+        engine->exec();
+        for (auto& timing : engine->frameTimings()) render_time += timing.render_time;
+    }
+    engine->setFrameLimit(0);
+    painter->installPaintEvent(nullptr);
+    painter->clear();
+    state.setItemsProcessed(state.iterations() * FRAMES * positions.size());
+    state.setLabel(fmt::format("avg frame {:.3f} ms, saved {} draw calls",
+                               render_time / static_cast<double>(state.iterations() * FRAMES),
+                               painter->drawCallsSaved()));
+}
+BENCHMARK(BM_PainterFrame)->arg(1000)->arg(10000)->arg(100000)->iterations(3);
+
+/// 两两检测由 `make` 创建的碰撞器
+template<class Factory>
+void colliderCheck(Bench::State& state, Factory&& make) {
+    std::vector<Components::Collider> colliders;
+    colliders.reserve(static_cast<size_t>(state.range()));
+    for (int64_t i = 0; i < state.range(); ++i) {
+        colliders.push_back(make(i));
+        colliders.back().setEnabled(true);
+    }
+    uint64_t pairs = 0;
+    for (auto _ : state) {
+        int hits = 0;
+        for (size_t i = 0; i < colliders.size(); ++i) {
+            for (size_t j = i + 1; j < colliders.size(); ++j) {
+                hits += colliders[i].check(colliders[j]) >= 0;
+            }
+        }
+        Bench::doNotOptimize(hits);
+        pairs += colliders.size() * (colliders.size() - 1) / 2;
+    }
+    state.setItemsProcessed(pairs);
+}
+
+/// 两两检测碰撞器
+void BM_ColliderCheck(Bench::State& state) {
+    colliderCheck(state, [](int64_t i) {
+        return Components::Collider(randomFloat(0, 1000), randomFloat(0, 1000), randomFloat(4, 32),
+                                    randomFloat(4, 32), static_cast<uint8_t>(1 + i % 2));
+    });
+}
+BENCHMARK(BM_ColliderCheck)->arg(100)->arg(1000);
+
+/// 碰撞世界每帧移动四分之一的碰撞器后检测接触
+void collisionWorldStep(Bench::State& state, Components::CollisionWorld::BroadPhase broad_phase) {
+    Components::CollisionWorld world(broad_phase, 32.0f);
+    std::vector<Components::Collider*> colliders;
+    for (int64_t i = 0; i < state.range(); ++i) {
+        colliders.push_back(world.create(randomFloat(0, 4000), randomFloat(0, 4000), randomFloat(4, 32),
+                                         randomFloat(4, 32), static_cast<uint8_t>(1 + i % 2)));
+    }
+    world.step();
+    for (auto _ : state) {
+        for (size_t i = 0; i < colliders.size(); i += 4) {
+            colliders[i]->moveBounds(randomFloat(0, 4000), randomFloat(0, 4000));
+        }
+        world.step();
+        Bench::doNotOptimize(world.stayContacts().size());
+    }
+    state.setItemsProcessed(state.iterations() * colliders.size());
+}
+
+void BM_SpatialHashStep(Bench::State& state) {
+    collisionWorldStep(state, Components::CollisionWorld::SpatialHash);
+}
+BENCHMARK(BM_SpatialHashStep)->arg(1000)->arg(10000);
+
+void BM_AABBTreeStep(Bench::State& state) {
+    collisionWorldStep(state, Components::CollisionWorld::AABBTree);
+}
+BENCHMARK(BM_AABBTreeStep)->arg(1000)->arg(10000);
+
+/// 批量检测矩形（分别使用标量、SSE2 与 AVX2 实现）
+void compareRectBatch(Bench::State& state, Algorithm::SIMDLevel level) {
+    Algorithm::ShapeArray rects;
+    rects.reserve(static_cast<size_t>(state.range()));
+    for (int64_t i = 0; i < state.range(); ++i) {
+        rects.append(randomFloat(0, 4000), randomFloat(0, 4000), randomFloat(4, 32), randomFloat(4, 32));
+    }
+    const Graphics::Rectangle rect({1000, 1000}, {300, 300}, StdColor::Black);
+    std::vector<uint64_t> mask;
+    const auto previous = Algorithm::simdLevel();
+    Algorithm::setSIMDLevel(level);
+    // CPU 不支持时会回退到较低的级别，需在恢复之前记录实际测量的级别
+    const auto measured = Algorithm::simdLevel();
+    state.setLabel(measured == Algorithm::AVX2 ? "AVX2" : measured == Algorithm::SSE2 ? "SSE2" : "Scalar");
+    for (auto _ : state) {
+        Bench::doNotOptimize(Algorithm::compareRectBatch(rect, rects, mask));
+    }
+    Algorithm::setSIMDLevel(previous);
+    state.setItemsProcessed(state.iterations() * rects.size());
+}
+
+void BM_CompareRectScalar(Bench::State& state) {
+    compareRectBatch(state, Algorithm::Scalar);
+}
+BENCHMARK(BM_CompareRectScalar)->arg(1000)->arg(100000);
+
+void BM_CompareRectSIMD(Bench::State& state) {
+    compareRectBatch(state, Algorithm::AVX2);
+}
+BENCHMARK(BM_CompareRectSIMD)->arg(1000)->arg(100000);
+
+/// 两两检测像素级遮罩碰撞器（遮罩由资源系统缓存并共享）
+void BM_MaskColliderCheck(Bench::State& state) {
+    auto mask = ResourceSystem::global()->alphaMask("bench_sprite");
+    if (!mask) {
+        state.skipWithError("Can't create the alpha mask of 'bench_sprite'");
+        return;
+    }
+    colliderCheck(state, [&mask](int64_t) {
+        return Components::Collider(Vector2(randomFloat(0, 1000), randomFloat(0, 1000)), mask);
+    });
+}
+BENCHMARK(BM_MaskColliderCheck)->arg(100)->arg(1000);
+
+/// 图层遍历所有元素并记录绘制命令
+void BM_LayerUpdate(Bench::State& state) {
+    auto painter = engine->painter();
+    Components::Layer layer("bench");
+    layer.setViewportPainter(painter);
+    for (int64_t i = 0; i < state.range(); ++i) {
+        auto sprite = new Components::Sprite(fmt::format("sprite{}", i), "bench_sprite", painter);
+        sprite->properties()->position.reset(randomFloat(0, 768), randomFloat(0, 568));
+        layer.append(static_cast<uint32_t>(i), sprite);
+    }
+    for (auto _ : state) {
+        layer.draw();
+        state.pauseTiming();
+        painter->clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(state.range()));
+}
+BENCHMARK(BM_LayerUpdate)->arg(1000)->arg(10000);
+
+/// 在图层中拾取随机位置上的元素
+void BM_LayerPick(Bench::State& state) {
+    auto painter = engine->painter();
+    Components::Layer layer("bench");
+    for (int64_t i = 0; i < state.range(); ++i) {
+        auto sprite = new Components::Sprite(fmt::format("sprite{}", i), "bench_sprite", painter);
+        sprite->properties()->position.reset(randomFloat(0, 768), randomFloat(0, 568));
+        layer.append(static_cast<uint32_t>(i), sprite);
+    }
+    layer.refreshSpatialIndex();
+    auto positions = randomPositions(1024);
+    size_t index = 0;
+    for (auto _ : state) {
+        Bench::doNotOptimize(layer.pick(positions[index++ % positions.size()]).size());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LayerPick)->arg(1000)->arg(10000);
+
+Matrix2D<float> randomMatrix(uint32_t size) {
+    Matrix2D<float> matrix(size, size, 0.0f);
+    for (uint32_t r = 0; r < size; ++r) {
+        for (uint32_t c = 0; c < size; ++c) {
+            // 对角占优，保证矩阵可逆
+            matrix(r, c) = randomFloat(-1, 1) + (r == c ? static_cast<float>(size) : 0.0f);
+        }
+    }
+    return matrix;
+}
+
+void BM_MatrixMultiply(Bench::State& state) {
+    auto a = randomMatrix(static_cast<uint32_t>(state.range()));
+    auto b = randomMatrix(static_cast<uint32_t>(state.range()));
+    for (auto _ : state) {
+        auto c = a * b;
+        Bench::doNotOptimize(c);
+    }
+}
+BENCHMARK(BM_MatrixMultiply)->arg(4)->arg(16)->arg(64);
+
+void BM_MatrixInverse(Bench::State& state) {
+    auto a = randomMatrix(static_cast<uint32_t>(state.range()));
+    for (auto _ : state) {
+        auto c = a.inverse();
+        Bench::doNotOptimize(c);
+    }
+}
+BENCHMARK(BM_MatrixInverse)->arg(4)->arg(16)->arg(64);
+
+/// 拆分中英文混合的 UTF-8 字符串
+void BM_SplitUTF8(Bench::State& state) {
+    std::string text;
+    while (text.size() < static_cast<size_t>(state.range())) text += "EasyEngine 简易引擎 ゲーム 🎮 ";
+    for (auto _ : state) {
+        auto chars = Algorithm::splitUTF8(text);
+        Bench::doNotOptimize(chars);
+    }
+    state.setItemsProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_SplitUTF8)->arg(1024)->arg(65536);
+
+/// 加载并卸载资源
+void BM_ResourceLoad(Bench::State& state) {
+    auto res = ResourceSystem::global();
+    const std::string name = state.range() ? "bench_sprite" : "bench_text";
+    state.setLabel(state.range() ? "image" : "text");
+    for (auto _ : state) {
+        if (!res->load(name)) {
+            state.skipWithError(fmt::format("Can't load resource '{}'", name));
+            break;
+        }
+        state.pauseTiming();
+        res->unload(name);
+        state.resumeTiming();
+    }
+}
+BENCHMARK(BM_ResourceLoad)->arg(0)->arg(1);
+
+/// 事件循环中分发大量计时器
+void BM_TimerDispatch(Bench::State& state) {
+    auto events = EventSystem::global();
+    uint64_t triggered = 0;
+    for (int64_t i = 0; i < state.range(); ++i) {
+        auto timer = new Components::Timer(0, [&triggered] { triggered += 1; });
+        timer->start(true);
+    }
+    for (auto _ : state) {
+        events->handler();
+    }
+    events->clearTimer();
+    Bench::doNotOptimize(triggered);
+    state.setItemsProcessed(state.iterations() * static_cast<uint64_t>(state.range()));
+}
+BENCHMARK(BM_TimerDispatch)->arg(1000)->arg(10000);
+
+int main(int argc, char** argv) {
+    Engine bench_engine("EasyEngine Benchmark", 800, 600, true);
+    engine = &bench_engine;
+    prepareResources();
+    int ret = Bench::runAll(argc, argv);
+    std::error_code ec;
+    std::filesystem::remove_all(temp_dir, ec);
+    return ret;
+}
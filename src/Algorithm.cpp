@@ -1,11 +1,21 @@
 
 #include "Algorithm.h"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EASYENGINE_X86_SIMD
+#include <immintrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define EASYENGINE_TARGET(name) __attribute__((target(name)))
+#else
+#define EASYENGINE_TARGET(name)
+#endif
+
 using namespace EasyEngine;
 
 uint64_t Algorithm::getTimeMillisec() {
-    return std::chrono::duration_cast<std::chrono::milliseconds>
-            (std::chrono::steady_clock::now().time_since_epoch()).count();
+    // 录制或回放时使用按帧锁定的虚拟时钟
+    return Replay::global()->timeMillisec();
 }
 
 uint64_t Algorithm::getTimeSec() {
@@ -385,31 +395,636 @@ int8_t Algorithm::compareRectEllipse(const Graphics::Rectangle &rect, const Grap
     return -1;
 }
 
-SSurface *Algorithm::captureWindow(Painter *painter) {
-    if (!painter) {
-        SDL_Log("[ERROR] The specified painter is not valid!");
-        return nullptr;
+namespace {
+    /// 线段与轴对齐包围盒的求交（slab 算法）
+    float raycastBox(const Vector2 &origin, const Vector2 &delta, float min_x, float min_y, float max_x, float max_y,
+                     Vector2 *normal) {
+        float t_min = 0.0f, t_max = 1.0f;
+        Vector2 n(0, 0);
+        const float o[2] = {origin.x, origin.y}, d[2] = {delta.x, delta.y};
+        const float lo[2] = {min_x, min_y}, hi[2] = {max_x, max_y};
+        for (int axis = 0; axis < 2; ++axis) {
+            if (std::fabs(d[axis]) < 1e-12f) {
+                if (o[axis] < lo[axis] || o[axis] > hi[axis]) return -1;
+                continue;
+            }
+            float t1 = (lo[axis] - o[axis]) / d[axis], t2 = (hi[axis] - o[axis]) / d[axis];
+            float side = -1.0f;
+            if (t1 > t2) {
+                std::swap(t1, t2);
+                side = 1.0f;
+            }
+            if (t1 > t_min) {
+                t_min = t1;
+                n = axis == 0 ? Vector2(side, 0) : Vector2(0, side);
+            }
+            t_max = std::min(t_max, t2);
+            if (t_min > t_max) return -1;
+        }
+        if (normal) *normal = n;
+        return t_min;
+    }
+
+    /// 线段与轴对齐椭圆的求交（缩放为单位圆后解二次方程）
+    float raycastAxes(const Vector2 &origin, const Vector2 &delta, const Vector2 &center, float a, float b,
+                      Vector2 *normal) {
+        if (a <= 0 || b <= 0) return -1;
+        const float ox = (origin.x - center.x) / a, oy = (origin.y - center.y) / b;
+        const float dx = delta.x / a, dy = delta.y / b;
+        const float c = ox * ox + oy * oy - 1.0f;
+        if (c <= 0) {
+            if (normal) normal->reset(0, 0);
+            return 0;
+        }
+        const float qa = dx * dx + dy * dy, qb = ox * dx + oy * dy;
+        // 起点在外部且远离椭圆时不可能相交
+        if (qa <= 0 || qb >= 0) return -1;
+        const float discriminant = qb * qb - qa * c;
+        if (discriminant < 0) return -1;
+        const float t = (-qb - std::sqrt(discriminant)) / qa;
+        if (t < 0 || t > 1) return -1;
+        if (normal) {
+            const float nx = (ox + dx * t) / a, ny = (oy + dy * t) / b;
+            const float length = std::sqrt(nx * nx + ny * ny);
+            normal->reset(nx / length, ny / length);
+        }
+        return t;
+    }
+
+    /// 将缩放空间中的法线换算回原空间
+    void unscaleNormal(Vector2 *normal, float sx, float sy) {
+        if (!normal) return;
+        const float nx = normal->x * sx, ny = normal->y * sy;
+        const float length = std::sqrt(nx * nx + ny * ny);
+        if (length > 0) normal->reset(nx / length, ny / length);
+    }
+}
+
+float Algorithm::raycastRect(const Vector2 &origin, const Vector2 &delta, const Graphics::Rectangle &rect,
+                             Vector2 *normal) {
+    return raycastBox(origin, delta, rect.pos.x, rect.pos.y,
+                      rect.pos.x + rect.size.width, rect.pos.y + rect.size.height, normal);
+}
+
+float Algorithm::raycastEllipse(const Vector2 &origin, const Vector2 &delta, const Graphics::Ellipse &ellipse,
+                                Vector2 *normal) {
+    return raycastAxes(origin, delta, ellipse.pos, ellipse.area.width * 0.5f, ellipse.area.height * 0.5f, normal);
+}
+
+float Algorithm::sweepRect(const Graphics::Rectangle &moving, const Vector2 &delta,
+                           const Graphics::Rectangle &target, Vector2 *normal) {
+    // 闵可夫斯基和：将目标矩形按移动矩形的尺寸扩展，转换为左上角的线段求交
+    return raycastBox(moving.pos, delta, target.pos.x - moving.size.width, target.pos.y - moving.size.height,
+                      target.pos.x + target.size.width, target.pos.y + target.size.height, normal);
+}
+
+float Algorithm::sweepEllipseRect(const Graphics::Ellipse &moving, const Vector2 &delta,
+                                  const Graphics::Rectangle &target, Vector2 *normal) {
+    const float a = moving.area.width * 0.5f, b = moving.area.height * 0.5f;
+    if (a <= 0 || b <= 0) return raycastRect(moving.pos, delta, target, normal);
+    // 缩放空间使椭圆成为单位圆，矩形扩展为圆角半径为 1 的圆角矩形
+    const float sx = 1.0f / a, sy = 1.0f / b;
+    const Vector2 origin(moving.pos.x * sx, moving.pos.y * sy), scaled(delta.x * sx, delta.y * sy);
+    const float min_x = target.pos.x * sx, min_y = target.pos.y * sy;
+    const float max_x = (target.pos.x + target.size.width) * sx, max_y = (target.pos.y + target.size.height) * sy;
+    const float cx = std::clamp(origin.x, min_x, max_x), cy = std::clamp(origin.y, min_y, max_y);
+    if ((origin.x - cx) * (origin.x - cx) + (origin.y - cy) * (origin.y - cy) <= 1.0f) {
+        if (normal) normal->reset(0, 0);
+        return 0;
+    }
+    float t = raycastBox(origin, scaled, min_x - 1, min_y - 1, max_x + 1, max_y + 1, normal);
+    if (t < 0) return -1;
+    // 落在扩展后的角落区域时，改为与对应顶点处的单位圆求交
+    const float px = origin.x + scaled.x * t, py = origin.y + scaled.y * t;
+    const bool outside_x = px < min_x || px > max_x, outside_y = py < min_y || py > max_y;
+    if (outside_x && outside_y) {
+        const Vector2 corner(px < min_x ? min_x : max_x, py < min_y ? min_y : max_y);
+        t = raycastAxes(origin, scaled, corner, 1.0f, 1.0f, normal);
+        if (t < 0) return -1;
+    }
+    unscaleNormal(normal, sx, sy);
+    return t;
+}
+
+float Algorithm::sweepEllipse(const Graphics::Ellipse &moving, const Vector2 &delta,
+                              const Graphics::Ellipse &target, Vector2 *normal) {
+    const float a = moving.area.width * 0.5f, b = moving.area.height * 0.5f;
+    if (a <= 0 || b <= 0) return raycastEllipse(moving.pos, delta, target, normal);
+    // 缩放空间使移动的椭圆成为单位圆，两者的闵可夫斯基和近似为半轴各加 1 的椭圆
+    const float sx = 1.0f / a, sy = 1.0f / b;
+    const float t = raycastAxes({moving.pos.x * sx, moving.pos.y * sy}, {delta.x * sx, delta.y * sy},
+                                {target.pos.x * sx, target.pos.y * sy},
+                                target.area.width * 0.5f * sx + 1.0f, target.area.height * 0.5f * sy + 1.0f, normal);
+    if (t > 0) unscaleNormal(normal, sx, sy);
+    return t;
+}
+
+namespace {
+    /// 取出遮罩某行自第 start 个像素起的 64 位，超出该行范围的部分为 0
+    uint64_t maskWord(const uint64_t* row, int64_t words, int64_t start) {
+        const int64_t word = start >> 6, shift = start & 63;
+        uint64_t ret = 0;
+        if (word >= 0 && word < words) ret = row[word] >> shift;
+        if (shift && word + 1 >= 0 && word + 1 < words) ret |= row[word + 1] << (64 - shift);
+        return ret;
+    }
+
+    /// 第 word 个字中位于像素范围 [first, last] 内的位
+    uint64_t rangeWord(int64_t word, int64_t first, int64_t last) {
+        const int64_t low = std::max<int64_t>(first - word * 64, 0), high = std::min<int64_t>(last - word * 64, 63);
+        if (low > high) return 0;
+        return (~uint64_t(0) >> (63 - high)) & (~uint64_t(0) << low);
+    }
+
+    /// 遮罩第 y 行的像素范围 [first, last] 内是否存在不透明像素
+    bool anyInRow(const AlphaMask& mask, int64_t y, int64_t first, int64_t last) {
+        const uint64_t* row = mask.row(static_cast<uint32_t>(y));
+        for (int64_t word = first >> 6; word <= last >> 6; ++word) {
+            if (row[word] & rangeWord(word, first, last)) return true;
+        }
+        return false;
     }
-    if (!painter->window() || !painter->window()->window) {
-        SDL_Log("[ERROR] Failed to get window! The window is not valid!");
+
+    /// 计算中心点位于区间 [min, max] 内的像素范围，并限制在 [0, size) 内
+    bool pixelSpan(float min, float max, uint32_t size, int64_t& first, int64_t& last) {
+        if (!(min <= max)) return false;
+        min = std::max(min, -1.0f);
+        max = std::min(max, static_cast<float>(size) + 1.0f);
+        first = std::max<int64_t>(static_cast<int64_t>(std::ceil(min - 0.5f)), 0);
+        last = std::min<int64_t>(static_cast<int64_t>(std::floor(max - 0.5f)), static_cast<int64_t>(size) - 1);
+        return first <= last;
+    }
+}
+
+std::shared_ptr<AlphaMask> Algorithm::createAlphaMask(SSurface *surface, uint8_t threshold) {
+    if (!surface) {
+        SDL_Log("[ERROR] The specified surface is not valid!");
         return nullptr;
     }
-    SSurface *_window = SDL_GetWindowSurface(painter->window()->window);
-    if (!_window) {
-        SDL_Log("[ERROR] Failed to get window surface! Exception: %s", SDL_GetError());
+    SDL_Rect clip;
+    if (!SDL_GetSurfaceClipRect(surface, &clip)) clip = {0, 0, surface->w, surface->h};
+    // 统一转换为按字节排列的 RGBA，透明度位于每个像素的第 4 个字节
+    SSurface* rgba = surface->format == SDL_PIXELFORMAT_RGBA32 ? surface
+                                                               : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if (!rgba) {
+        SDL_Log("[ERROR] Can't convert the surface to create the alpha mask!\nException: %s", SDL_GetError());
         return nullptr;
     }
-    if (SDL_UpdateWindowSurface(painter->window()->window) == false) {
-        SDL_Log("[ERROR] Failed to update the current window! Exception: %s", SDL_GetError());
+    auto mask = std::make_shared<AlphaMask>();
+    mask->width = static_cast<uint32_t>(std::max(clip.w, 0));
+    mask->height = static_cast<uint32_t>(std::max(clip.h, 0));
+    mask->words_per_row = (mask->width + 63) / 64;
+    mask->bits.assign(static_cast<size_t>(mask->words_per_row) * mask->height, 0);
+    SDL_LockSurface(rgba);
+    for (uint32_t y = 0; y < mask->height; ++y) {
+        auto pixels = static_cast<const uint8_t*>(rgba->pixels) +
+                      static_cast<size_t>(clip.y + static_cast<int>(y)) * rgba->pitch + static_cast<size_t>(clip.x) * 4;
+        uint64_t* row = mask->bits.data() + static_cast<size_t>(y) * mask->words_per_row;
+        for (uint32_t x = 0; x < mask->width; ++x) {
+            if (pixels[x * 4 + 3] >= threshold) row[x >> 6] |= uint64_t(1) << (x & 63);
+        }
+    }
+    SDL_UnlockSurface(rgba);
+    if (rgba != surface) SDL_DestroySurface(rgba);
+    return mask;
+}
+
+int8_t Algorithm::comparePosMask(const Vector2 &pos, const AlphaMask &mask, const Vector2 &mask_pos) {
+    const float x = std::floor(pos.x - mask_pos.x), y = std::floor(pos.y - mask_pos.y);
+    if (!(x >= 0 && y >= 0 && x < static_cast<float>(mask.width) && y < static_cast<float>(mask.height))) return -1;
+    return mask.test(static_cast<int64_t>(x), static_cast<int64_t>(y)) ? 1 : -1;
+}
+
+int8_t Algorithm::compareMask(const AlphaMask &mask1, const Vector2 &pos1, const AlphaMask &mask2, const Vector2 &pos2) {
+    // 第二个遮罩的像素 (i, j) 对应第一个遮罩的像素 (i + dx, j + dy)
+    const float fx = std::round(pos2.x - pos1.x), fy = std::round(pos2.y - pos1.y);
+    if (!(fx < static_cast<float>(mask1.width) && fx > -static_cast<float>(mask2.width) &&
+          fy < static_cast<float>(mask1.height) && fy > -static_cast<float>(mask2.height))) return -1;
+    const auto dx = static_cast<int64_t>(fx), dy = static_cast<int64_t>(fy);
+    const int64_t x0 = std::max<int64_t>(dx, 0), x1 = std::min<int64_t>(mask1.width, dx + mask2.width) - 1,
+                  y0 = std::max<int64_t>(dy, 0), y1 = std::min<int64_t>(mask1.height, dy + mask2.height) - 1;
+    for (int64_t y = y0; y <= y1; ++y) {
+        const uint64_t* row1 = mask1.row(static_cast<uint32_t>(y));
+        const uint64_t* row2 = mask2.row(static_cast<uint32_t>(y - dy));
+        for (int64_t word = x0 >> 6; word <= x1 >> 6; ++word) {
+            if (row1[word] & maskWord(row2, mask2.words_per_row, word * 64 - dx)) return 1;
+        }
+    }
+    return -1;
+}
+
+int8_t Algorithm::compareMaskRect(const AlphaMask &mask, const Vector2 &mask_pos, const Graphics::Rectangle &rect) {
+    int64_t x0, x1, y0, y1;
+    if (!pixelSpan(rect.pos.x - mask_pos.x, rect.pos.x + rect.size.width - mask_pos.x, mask.width, x0, x1) ||
+        !pixelSpan(rect.pos.y - mask_pos.y, rect.pos.y + rect.size.height - mask_pos.y, mask.height, y0, y1)) {
+        return -1;
+    }
+    for (int64_t y = y0; y <= y1; ++y) {
+        if (anyInRow(mask, y, x0, x1)) return 1;
+    }
+    return -1;
+}
+
+int8_t Algorithm::compareMaskEllipse(const AlphaMask &mask, const Vector2 &mask_pos, const Graphics::Ellipse &ellipse) {
+    const float a = ellipse.area.width * 0.5f, b = ellipse.area.height * 0.5f;
+    const float cx = ellipse.pos.x - mask_pos.x, cy = ellipse.pos.y - mask_pos.y;
+    int64_t x0, x1, y0, y1;
+    if (!pixelSpan(cx - a, cx + a, mask.width, x0, x1) || !pixelSpan(cy - b, cy + b, mask.height, y0, y1)) return -1;
+    // 逐行求出椭圆覆盖的像素范围
+    for (int64_t y = y0; y <= y1; ++y) {
+        const float t = (static_cast<float>(y) + 0.5f - cy) / b;
+        if (!(t * t <= 1.0f)) continue;
+        const float half = a * std::sqrt(1.0f - t * t);
+        if (pixelSpan(cx - half, cx + half, mask.width, x0, x1) && anyInRow(mask, y, x0, x1)) return 1;
+    }
+    return -1;
+}
+
+namespace {
+    /*
+     * 批量检测的内核
+     * 每个内核提供标量、SSE2 与 AVX2 三种实现，比较时使用取反的无序比较（如 `!(a > b)`），
+     * 以保证结果（包括 NaN 等边界情况）与逐个调用的结果完全一致。
+     * SIMD 实现返回已处理的数量，余下不足一组的部分由标量实现处理。
+     */
+    constexpr float BATCH_EPSILON = 1e-6f;
+
+    std::atomic<int> simd_level{-1};
+
+    Algorithm::SIMDLevel supportedSIMDLevel() {
+#ifdef EASYENGINE_X86_SIMD
+        static const Algorithm::SIMDLevel level =
+                SDL_HasAVX2() ? Algorithm::AVX2 : (SDL_HasSSE2() ? Algorithm::SSE2 : Algorithm::Scalar);
+        return level;
+#else
+        return Algorithm::Scalar;
+#endif
+    }
+
+    bool isValidArray(const Algorithm::ShapeArray &shapes) {
+        const size_t count = shapes.x.size();
+        if (shapes.y.size() != count || shapes.width.size() != count || shapes.height.size() != count) {
+            SDL_Log("[ERROR] The specified shape array is not valid! The sizes of all members must be equal.");
+            return false;
+        }
+        return true;
+    }
+
+    size_t countHits(const std::vector<uint64_t> &mask) {
+        size_t hits = 0;
+        for (auto bits : mask) hits += std::popcount(bits);
+        return hits;
+    }
+
+    void posRectScalar(float px, float py, const Algorithm::ShapeArray &rects, size_t begin, uint64_t *mask) {
+        for (size_t i = begin; i < rects.x.size(); ++i) {
+            const float max_x = rects.width[i] + rects.x[i], max_y = rects.height[i] + rects.y[i];
+            if (px > max_x + BATCH_EPSILON || px < rects.x[i] - BATCH_EPSILON ||
+                py > max_y + BATCH_EPSILON || py < rects.y[i] - BATCH_EPSILON) {
+                continue;
+            }
+            mask[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+
+    void posEllipseScalar(float px, float py, const Algorithm::ShapeArray &ellipses, size_t begin, uint64_t *mask) {
+        for (size_t i = begin; i < ellipses.x.size(); ++i) {
+            const float dx = px - ellipses.x[i], dy = py - ellipses.y[i];
+            const float a = ellipses.width[i] * 0.5f, b = ellipses.height[i] * 0.5f;
+            const float value = (dx * dx) / (a * a) + (dy * dy) / (b * b);
+            if (value > 1.0f + BATCH_EPSILON) continue;
+            mask[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+
+    void rectScalar(const Graphics::Rectangle &rect, const Algorithm::ShapeArray &rects, size_t begin, uint64_t *mask) {
+        const float x1 = rect.pos.x, x2 = rect.pos.x + rect.size.width,
+                    y1 = rect.pos.y, y2 = rect.pos.y + rect.size.height;
+        for (size_t i = begin; i < rects.x.size(); ++i) {
+            const float x3 = rects.x[i], x4 = rects.x[i] + rects.width[i],
+                        y3 = rects.y[i], y4 = rects.y[i] + rects.height[i];
+            if (x2 < x3 || x1 > x4 || y2 < y3 || y1 > y4) continue;
+            mask[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+
+    /// 与 `Algorithm::compareEllipse()` 中判断分离的部分一致
+    struct EllipseParams {
+        float x, y, a, b, left, right, bottom, top;
+        explicit EllipseParams(const Graphics::Ellipse &ellipse) {
+            const float fa = ellipse.area.width * 0.5f, fb = ellipse.area.height * 0.5f;
+            x = ellipse.pos.x;
+            y = ellipse.pos.y;
+            a = std::max(fa, fb);
+            b = std::min(fa, fb);
+            left = x - fa;
+            right = x + fa;
+            bottom = y - fb;
+            top = y + fb;
+        }
+    };
+
+    void ellipseScalar(const EllipseParams &e, const Algorithm::ShapeArray &ellipses, size_t begin, uint64_t *mask) {
+        for (size_t i = begin; i < ellipses.x.size(); ++i) {
+            const float fa = ellipses.width[i] * 0.5f, fb = ellipses.height[i] * 0.5f;
+            const float a = std::max(fa, fb), b = std::min(fa, fb);
+            if (e.right < ellipses.x[i] - fa || e.left > ellipses.x[i] + fa ||
+                e.top < ellipses.y[i] - fb || e.bottom > ellipses.y[i] + fb) {
+                continue;
+            }
+            const float dx = e.x - ellipses.x[i], dy = e.y - ellipses.y[i];
+            if (dx * dx + dy * dy > (e.a + a) * (e.a + a)) continue;
+            const float fx = std::fabs(dx), sx = e.a + a, fy = std::fabs(dy), sy = e.b + b;
+            if (fx > sx || std::fabs(fx - sx) < BATCH_EPSILON) continue;
+            if (fy > sy || std::fabs(fy - sy) < BATCH_EPSILON) continue;
+            mask[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+
+#ifdef EASYENGINE_X86_SIMD
+    EASYENGINE_TARGET("sse2")
+    size_t posRectSSE2(float px, float py, const Algorithm::ShapeArray &rects, uint64_t *mask) {
+        const __m128 vx = _mm_set1_ps(px), vy = _mm_set1_ps(py), eps = _mm_set1_ps(BATCH_EPSILON);
+        size_t i = 0;
+        for (; i + 4 <= rects.x.size(); i += 4) {
+            const __m128 x = _mm_loadu_ps(rects.x.data() + i), y = _mm_loadu_ps(rects.y.data() + i);
+            const __m128 w = _mm_loadu_ps(rects.width.data() + i), h = _mm_loadu_ps(rects.height.data() + i);
+            __m128 hit = _mm_and_ps(_mm_cmpngt_ps(vx, _mm_add_ps(_mm_add_ps(w, x), eps)),
+                                    _mm_cmpnlt_ps(vx, _mm_sub_ps(x, eps)));
+            hit = _mm_and_ps(hit, _mm_cmpngt_ps(vy, _mm_add_ps(_mm_add_ps(h, y), eps)));
+            hit = _mm_and_ps(hit, _mm_cmpnlt_ps(vy, _mm_sub_ps(y, eps)));
+            mask[i >> 6] |= uint64_t(_mm_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("avx2")
+    size_t posRectAVX2(float px, float py, const Algorithm::ShapeArray &rects, uint64_t *mask) {
+        const __m256 vx = _mm256_set1_ps(px), vy = _mm256_set1_ps(py), eps = _mm256_set1_ps(BATCH_EPSILON);
+        size_t i = 0;
+        for (; i + 8 <= rects.x.size(); i += 8) {
+            const __m256 x = _mm256_loadu_ps(rects.x.data() + i), y = _mm256_loadu_ps(rects.y.data() + i);
+            const __m256 w = _mm256_loadu_ps(rects.width.data() + i), h = _mm256_loadu_ps(rects.height.data() + i);
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(vx, _mm256_add_ps(_mm256_add_ps(w, x), eps), _CMP_NGT_UQ),
+                                       _mm256_cmp_ps(vx, _mm256_sub_ps(x, eps), _CMP_NLT_UQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(vy, _mm256_add_ps(_mm256_add_ps(h, y), eps), _CMP_NGT_UQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(vy, _mm256_sub_ps(y, eps), _CMP_NLT_UQ));
+            mask[i >> 6] |= uint64_t(_mm256_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("sse2")
+    size_t posEllipseSSE2(float px, float py, const Algorithm::ShapeArray &ellipses, uint64_t *mask) {
+        const __m128 vx = _mm_set1_ps(px), vy = _mm_set1_ps(py);
+        const __m128 half = _mm_set1_ps(0.5f), limit = _mm_set1_ps(1.0f + BATCH_EPSILON);
+        size_t i = 0;
+        for (; i + 4 <= ellipses.x.size(); i += 4) {
+            const __m128 dx = _mm_sub_ps(vx, _mm_loadu_ps(ellipses.x.data() + i));
+            const __m128 dy = _mm_sub_ps(vy, _mm_loadu_ps(ellipses.y.data() + i));
+            const __m128 a = _mm_mul_ps(_mm_loadu_ps(ellipses.width.data() + i), half);
+            const __m128 b = _mm_mul_ps(_mm_loadu_ps(ellipses.height.data() + i), half);
+            const __m128 value = _mm_add_ps(_mm_div_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(a, a)),
+                                            _mm_div_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(b, b)));
+            mask[i >> 6] |= uint64_t(_mm_movemask_ps(_mm_cmpngt_ps(value, limit))) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("avx2")
+    size_t posEllipseAVX2(float px, float py, const Algorithm::ShapeArray &ellipses, uint64_t *mask) {
+        const __m256 vx = _mm256_set1_ps(px), vy = _mm256_set1_ps(py);
+        const __m256 half = _mm256_set1_ps(0.5f), limit = _mm256_set1_ps(1.0f + BATCH_EPSILON);
+        size_t i = 0;
+        for (; i + 8 <= ellipses.x.size(); i += 8) {
+            const __m256 dx = _mm256_sub_ps(vx, _mm256_loadu_ps(ellipses.x.data() + i));
+            const __m256 dy = _mm256_sub_ps(vy, _mm256_loadu_ps(ellipses.y.data() + i));
+            const __m256 a = _mm256_mul_ps(_mm256_loadu_ps(ellipses.width.data() + i), half);
+            const __m256 b = _mm256_mul_ps(_mm256_loadu_ps(ellipses.height.data() + i), half);
+            const __m256 value = _mm256_add_ps(_mm256_div_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(a, a)),
+                                               _mm256_div_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(b, b)));
+            mask[i >> 6] |= uint64_t(_mm256_movemask_ps(_mm256_cmp_ps(value, limit, _CMP_NGT_UQ))) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("sse2")
+    size_t rectSSE2(const Graphics::Rectangle &rect, const Algorithm::ShapeArray &rects, uint64_t *mask) {
+        const __m128 x1 = _mm_set1_ps(rect.pos.x), x2 = _mm_set1_ps(rect.pos.x + rect.size.width);
+        const __m128 y1 = _mm_set1_ps(rect.pos.y), y2 = _mm_set1_ps(rect.pos.y + rect.size.height);
+        size_t i = 0;
+        for (; i + 4 <= rects.x.size(); i += 4) {
+            const __m128 x3 = _mm_loadu_ps(rects.x.data() + i), y3 = _mm_loadu_ps(rects.y.data() + i);
+            const __m128 x4 = _mm_add_ps(x3, _mm_loadu_ps(rects.width.data() + i));
+            const __m128 y4 = _mm_add_ps(y3, _mm_loadu_ps(rects.height.data() + i));
+            __m128 hit = _mm_and_ps(_mm_cmpnlt_ps(x2, x3), _mm_cmpngt_ps(x1, x4));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(y2, y3), _mm_cmpngt_ps(y1, y4)));
+            mask[i >> 6] |= uint64_t(_mm_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("avx2")
+    size_t rectAVX2(const Graphics::Rectangle &rect, const Algorithm::ShapeArray &rects, uint64_t *mask) {
+        const __m256 x1 = _mm256_set1_ps(rect.pos.x), x2 = _mm256_set1_ps(rect.pos.x + rect.size.width);
+        const __m256 y1 = _mm256_set1_ps(rect.pos.y), y2 = _mm256_set1_ps(rect.pos.y + rect.size.height);
+        size_t i = 0;
+        for (; i + 8 <= rects.x.size(); i += 8) {
+            const __m256 x3 = _mm256_loadu_ps(rects.x.data() + i), y3 = _mm256_loadu_ps(rects.y.data() + i);
+            const __m256 x4 = _mm256_add_ps(x3, _mm256_loadu_ps(rects.width.data() + i));
+            const __m256 y4 = _mm256_add_ps(y3, _mm256_loadu_ps(rects.height.data() + i));
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(x2, x3, _CMP_NLT_UQ), _mm256_cmp_ps(x1, x4, _CMP_NGT_UQ));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(y2, y3, _CMP_NLT_UQ),
+                                                   _mm256_cmp_ps(y1, y4, _CMP_NGT_UQ)));
+            mask[i >> 6] |= uint64_t(_mm256_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("sse2")
+    size_t ellipseSSE2(const EllipseParams &e, const Algorithm::ShapeArray &ellipses, uint64_t *mask) {
+        const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ea = _mm_set1_ps(e.a), eb = _mm_set1_ps(e.b);
+        const __m128 left = _mm_set1_ps(e.left), right = _mm_set1_ps(e.right);
+        const __m128 bottom = _mm_set1_ps(e.bottom), top = _mm_set1_ps(e.top);
+        const __m128 half = _mm_set1_ps(0.5f), eps = _mm_set1_ps(BATCH_EPSILON), sign = _mm_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 4 <= ellipses.x.size(); i += 4) {
+            const __m128 x = _mm_loadu_ps(ellipses.x.data() + i), y = _mm_loadu_ps(ellipses.y.data() + i);
+            const __m128 fa = _mm_mul_ps(_mm_loadu_ps(ellipses.width.data() + i), half);
+            const __m128 fb = _mm_mul_ps(_mm_loadu_ps(ellipses.height.data() + i), half);
+            const __m128 a = _mm_max_ps(fa, fb), b = _mm_min_ps(fa, fb);
+            __m128 hit = _mm_and_ps(_mm_cmpnlt_ps(right, _mm_sub_ps(x, fa)), _mm_cmpngt_ps(left, _mm_add_ps(x, fa)));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(top, _mm_sub_ps(y, fb)),
+                                             _mm_cmpngt_ps(bottom, _mm_add_ps(y, fb))));
+            const __m128 dx = _mm_sub_ps(ex, x), dy = _mm_sub_ps(ey, y);
+            const __m128 sx = _mm_add_ps(ea, a), sy = _mm_add_ps(eb, b);
+            hit = _mm_and_ps(hit, _mm_cmpngt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(sx, sx)));
+            const __m128 fx = _mm_andnot_ps(sign, dx), fy = _mm_andnot_ps(sign, dy);
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpngt_ps(fx, sx),
+                                             _mm_cmpnlt_ps(_mm_andnot_ps(sign, _mm_sub_ps(fx, sx)), eps)));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpngt_ps(fy, sy),
+                                             _mm_cmpnlt_ps(_mm_andnot_ps(sign, _mm_sub_ps(fy, sy)), eps)));
+            mask[i >> 6] |= uint64_t(_mm_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+
+    EASYENGINE_TARGET("avx2")
+    size_t ellipseAVX2(const EllipseParams &e, const Algorithm::ShapeArray &ellipses, uint64_t *mask) {
+        const __m256 ex = _mm256_set1_ps(e.x), ey = _mm256_set1_ps(e.y);
+        const __m256 ea = _mm256_set1_ps(e.a), eb = _mm256_set1_ps(e.b);
+        const __m256 left = _mm256_set1_ps(e.left), right = _mm256_set1_ps(e.right);
+        const __m256 bottom = _mm256_set1_ps(e.bottom), top = _mm256_set1_ps(e.top);
+        const __m256 half = _mm256_set1_ps(0.5f), eps = _mm256_set1_ps(BATCH_EPSILON), sign = _mm256_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 8 <= ellipses.x.size(); i += 8) {
+            const __m256 x = _mm256_loadu_ps(ellipses.x.data() + i), y = _mm256_loadu_ps(ellipses.y.data() + i);
+            const __m256 fa = _mm256_mul_ps(_mm256_loadu_ps(ellipses.width.data() + i), half);
+            const __m256 fb = _mm256_mul_ps(_mm256_loadu_ps(ellipses.height.data() + i), half);
+            const __m256 a = _mm256_max_ps(fa, fb), b = _mm256_min_ps(fa, fb);
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(right, _mm256_sub_ps(x, fa), _CMP_NLT_UQ),
+                                       _mm256_cmp_ps(left, _mm256_add_ps(x, fa), _CMP_NGT_UQ));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(top, _mm256_sub_ps(y, fb), _CMP_NLT_UQ),
+                                                   _mm256_cmp_ps(bottom, _mm256_add_ps(y, fb), _CMP_NGT_UQ)));
+            const __m256 dx = _mm256_sub_ps(ex, x), dy = _mm256_sub_ps(ey, y);
+            const __m256 sx = _mm256_add_ps(ea, a), sy = _mm256_add_ps(eb, b);
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                                   _mm256_mul_ps(sx, sx), _CMP_NGT_UQ));
+            const __m256 fx = _mm256_andnot_ps(sign, dx), fy = _mm256_andnot_ps(sign, dy);
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(fx, sx, _CMP_NGT_UQ),
+                    _mm256_cmp_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(fx, sx)), eps, _CMP_NLT_UQ)));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(fy, sy, _CMP_NGT_UQ),
+                    _mm256_cmp_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(fy, sy)), eps, _CMP_NLT_UQ)));
+            mask[i >> 6] |= uint64_t(_mm256_movemask_ps(hit)) << (i & 63);
+        }
+        return i;
+    }
+#endif
+}
+
+void Algorithm::ShapeArray::append(float x, float y, float width, float height) {
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->width.push_back(width);
+    this->height.push_back(height);
+}
+
+void Algorithm::ShapeArray::append(const Graphics::Rectangle &rect) {
+    append(rect.pos.x, rect.pos.y, rect.size.width, rect.size.height);
+}
+
+void Algorithm::ShapeArray::append(const Graphics::Ellipse &ellipse) {
+    append(ellipse.pos.x, ellipse.pos.y, ellipse.area.width, ellipse.area.height);
+}
+
+void Algorithm::ShapeArray::reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    width.reserve(count);
+    height.reserve(count);
+}
+
+void Algorithm::ShapeArray::clear() {
+    x.clear();
+    y.clear();
+    width.clear();
+    height.clear();
+}
+
+size_t Algorithm::ShapeArray::size() const {
+    return x.size();
+}
+
+Algorithm::SIMDLevel Algorithm::simdLevel() {
+    int level = simd_level.load(std::memory_order_relaxed);
+    if (level < 0) {
+        level = supportedSIMDLevel();
+        simd_level.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SIMDLevel>(level);
+}
+
+void Algorithm::setSIMDLevel(SIMDLevel level) {
+    if (level > supportedSIMDLevel()) {
+        SDL_Log("[WARNING] The specified SIMD level is not supported by the CPU! Fall back to level %d.",
+                supportedSIMDLevel());
+        level = supportedSIMDLevel();
+    }
+    simd_level.store(level, std::memory_order_relaxed);
+}
+
+size_t Algorithm::comparePosRectBatch(const Vector2 &pos, const ShapeArray &rects, std::vector<uint64_t> &mask) {
+    mask.assign((rects.size() + 63) / 64, 0);
+    if (!isValidArray(rects)) return 0;
+    size_t done = 0;
+#ifdef EASYENGINE_X86_SIMD
+    if (simdLevel() == AVX2) done = posRectAVX2(pos.x, pos.y, rects, mask.data());
+    else if (simdLevel() == SSE2) done = posRectSSE2(pos.x, pos.y, rects, mask.data());
+#endif
+    posRectScalar(pos.x, pos.y, rects, done, mask.data());
+    return countHits(mask);
+}
+
+size_t Algorithm::comparePosEllipseBatch(const Vector2 &pos, const ShapeArray &ellipses, std::vector<uint64_t> &mask) {
+    mask.assign((ellipses.size() + 63) / 64, 0);
+    if (!isValidArray(ellipses)) return 0;
+    size_t done = 0;
+#ifdef EASYENGINE_X86_SIMD
+    if (simdLevel() == AVX2) done = posEllipseAVX2(pos.x, pos.y, ellipses, mask.data());
+    else if (simdLevel() == SSE2) done = posEllipseSSE2(pos.x, pos.y, ellipses, mask.data());
+#endif
+    posEllipseScalar(pos.x, pos.y, ellipses, done, mask.data());
+    return countHits(mask);
+}
+
+size_t Algorithm::compareRectBatch(const Graphics::Rectangle &rect, const ShapeArray &rects,
+                                   std::vector<uint64_t> &mask) {
+    mask.assign((rects.size() + 63) / 64, 0);
+    if (!isValidArray(rects)) return 0;
+    size_t done = 0;
+#ifdef EASYENGINE_X86_SIMD
+    if (simdLevel() == AVX2) done = rectAVX2(rect, rects, mask.data());
+    else if (simdLevel() == SSE2) done = rectSSE2(rect, rects, mask.data());
+#endif
+    rectScalar(rect, rects, done, mask.data());
+    return countHits(mask);
+}
+
+size_t Algorithm::compareEllipseBatch(const Graphics::Ellipse &ellipse, const ShapeArray &ellipses,
+                                      std::vector<uint64_t> &mask) {
+    mask.assign((ellipses.size() + 63) / 64, 0);
+    if (!isValidArray(ellipses)) return 0;
+    const EllipseParams params(ellipse);
+    size_t done = 0;
+#ifdef EASYENGINE_X86_SIMD
+    if (simdLevel() == AVX2) done = ellipseAVX2(params, ellipses, mask.data());
+    else if (simdLevel() == SSE2) done = ellipseSSE2(params, ellipses, mask.data());
+#endif
+    ellipseScalar(params, ellipses, done, mask.data());
+    return countHits(mask);
+}
+
+void Algorithm::maskToIndices(const std::vector<uint64_t> &mask, std::vector<uint32_t> &indices) {
+    indices.clear();
+    for (size_t word = 0; word < mask.size(); ++word) {
+        for (uint64_t bits = mask[word]; bits; bits &= bits - 1) {
+            indices.push_back(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+        }
+    }
+}
+
+SSurface *Algorithm::captureWindow(Painter *painter) {
+    if (!painter) {
+        SDL_Log("[ERROR] The specified painter is not valid!");
+        return nullptr;
     }
-    _window = SDL_GetWindowSurface(painter->window()->window);
-    if (!_window) {
-        SDL_Log("[ERROR] Failed to get window surface! Exception: %s", SDL_GetError());
+    if (!painter->window() || !painter->window()->renderer) {
+        SDL_Log("[ERROR] Failed to get renderer! The window is not valid!");
         return nullptr;
     }
-    auto _new = SDL_RenderReadPixels(painter->window()->renderer, nullptr);
+    auto _new = painter->readFrame();
     if (!_new) {
-        SDL_Log("[ERROR] Failed to get window surface! Exception: %s", SDL_GetError());
+        SDL_Log("[ERROR] Failed to read the pixels of the window! Exception: %s", SDL_GetError());
         return nullptr;
     }
 
@@ -28,6 +28,8 @@ namespace EasyEngine {
         /**
          * @brief 获取当前时间（毫秒）
          * @return 返回毫秒数（从 1970/01/01 开始计算）
+         * @note 录制或回放录像时返回按帧锁定的虚拟时钟
+         * @see Replay
          * @since v1.1.0-alpha
          */
         static uint64_t getTimeMillisec();
@@ -185,10 +187,220 @@ namespace EasyEngine {
          */
         static int8_t compareRectEllipse(const Graphics::Rectangle &rect, const Graphics::Ellipse &ellipse);
 
+        /**
+         * @brief 计算线段与矩形首次相交的时刻
+         * @param origin 线段起点
+         * @param delta  线段的位移（终点 = 起点 + 位移）
+         * @param rect   指定矩形
+         * @param normal 用于接收相交处的法线（指向线段一侧，可为 `nullptr`）
+         * @return 返回 0 ~ 1 之间的相交时刻（位移的比例）
+         * @retval -1 表示不相交
+         * @retval 0  表示起点已位于矩形上或内部（此时法线为零向量）
+         * @since v1.1.0-alpha
+         */
+        static float raycastRect(const Vector2 &origin, const Vector2 &delta, const Graphics::Rectangle &rect,
+                                 Vector2 *normal = nullptr);
+        /**
+         * @brief 计算线段与椭圆首次相交的时刻
+         * @param origin  线段起点
+         * @param delta   线段的位移
+         * @param ellipse 指定椭圆
+         * @param normal  用于接收相交处的法线（可为 `nullptr`）
+         * @return 返回 0 ~ 1 之间的相交时刻，不相交时返回 -1
+         * @since v1.1.0-alpha
+         */
+        static float raycastEllipse(const Vector2 &origin, const Vector2 &delta, const Graphics::Ellipse &ellipse,
+                                    Vector2 *normal = nullptr);
+        /**
+         * @brief 计算移动的矩形与静止的矩形首次接触的时刻（扫掠 AABB）
+         * @param moving 移动的矩形（位于起始位置）
+         * @param delta  移动的位移
+         * @param target 静止的矩形
+         * @param normal 用于接收接触处的法线（指向移动的矩形，可为 `nullptr`）
+         * @return 返回 0 ~ 1 之间的接触时刻，不接触时返回 -1
+         * @since v1.1.0-alpha
+         */
+        static float sweepRect(const Graphics::Rectangle &moving, const Vector2 &delta,
+                               const Graphics::Rectangle &target, Vector2 *normal = nullptr);
+        /**
+         * @brief 计算移动的椭圆与静止的矩形首次接触的时刻
+         * @param moving 移动的椭圆（位于起始位置）
+         * @param delta  移动的位移
+         * @param target 静止的矩形
+         * @param normal 用于接收接触处的法线（指向移动的椭圆，可为 `nullptr`）
+         * @return 返回 0 ~ 1 之间的接触时刻，不接触时返回 -1
+         * @note 将椭圆缩放为单位圆后与圆角矩形求交，结果是精确的
+         * @since v1.1.0-alpha
+         */
+        static float sweepEllipseRect(const Graphics::Ellipse &moving, const Vector2 &delta,
+                                      const Graphics::Rectangle &target, Vector2 *normal = nullptr);
+        /**
+         * @brief 计算移动的椭圆与静止的椭圆首次接触的时刻
+         * @param moving 移动的椭圆（位于起始位置）
+         * @param delta  移动的位移
+         * @param target 静止的椭圆
+         * @param normal 用于接收接触处的法线（指向移动的椭圆，可为 `nullptr`）
+         * @return 返回 0 ~ 1 之间的接触时刻，不接触时返回 -1
+         * @note 对于圆形或宽高比相同的椭圆，结果是精确的；
+         * @note 宽高比相差越大，误差越大（与 `compareEllipse()` 类似）！
+         * @since v1.1.0-alpha
+         */
+        static float sweepEllipse(const Graphics::Ellipse &moving, const Vector2 &delta,
+                                  const Graphics::Ellipse &target, Vector2 *normal = nullptr);
+
+        /**
+         * @brief 根据表面的透明度生成 1 位遮罩
+         * @param surface   指定表面（仅使用其裁剪区域内的像素）
+         * @param threshold 透明度阈值，不低于此值的像素视为不透明
+         * @return 返回生成的遮罩，失败时返回 `nullptr`
+         * @see ResourceSystem::alphaMask
+         * @see Components::Sprite::alphaMask
+         * @since v1.1.0-alpha
+         */
+        static std::shared_ptr<AlphaMask> createAlphaMask(SSurface *surface, uint8_t threshold = 128);
+        /**
+         * @brief 判断点是否位于遮罩的不透明像素上
+         * @param pos       指定的点所在的坐标
+         * @param mask      指定遮罩
+         * @param mask_pos  遮罩左上角所在的坐标
+         * @retval -1 表示点位于透明像素上或遮罩之外
+         * @retval 1  表示点位于不透明像素上
+         * @since v1.1.0-alpha
+         */
+        static int8_t comparePosMask(const Vector2 &pos, const AlphaMask &mask, const Vector2 &mask_pos);
+        /**
+         * @brief 判断两个遮罩的不透明像素是否重叠
+         * @param mask1 指定第一个遮罩
+         * @param pos1  第一个遮罩左上角所在的坐标
+         * @param mask2 指定第二个遮罩
+         * @param pos2  第二个遮罩左上角所在的坐标
+         * @retval -1 表示不重叠
+         * @retval 1  表示存在重叠的不透明像素
+         *
+         * 先比较两者的包围盒，仅在包围盒相交的行内逐字（64 像素）进行按位与运算，
+         * 第二个遮罩按两者的相对位置移位后对齐到第一个遮罩。相对位置取整到像素。
+         * @since v1.1.0-alpha
+         */
+        static int8_t compareMask(const AlphaMask &mask1, const Vector2 &pos1,
+                                  const AlphaMask &mask2, const Vector2 &pos2);
+        /**
+         * @brief 判断遮罩的不透明像素是否与矩形重叠
+         * @param mask     指定遮罩
+         * @param mask_pos 遮罩左上角所在的坐标
+         * @param rect     指定矩形
+         * @retval -1 表示不重叠
+         * @retval 1  表示存在中心点位于矩形内的不透明像素
+         * @since v1.1.0-alpha
+         */
+        static int8_t compareMaskRect(const AlphaMask &mask, const Vector2 &mask_pos, const Graphics::Rectangle &rect);
+        /**
+         * @brief 判断遮罩的不透明像素是否与椭圆重叠
+         * @param mask     指定遮罩
+         * @param mask_pos 遮罩左上角所在的坐标
+         * @param ellipse  指定椭圆
+         * @retval -1 表示不重叠
+         * @retval 1  表示存在中心点位于椭圆内的不透明像素
+         * @since v1.1.0-alpha
+         */
+        static int8_t compareMaskEllipse(const AlphaMask &mask, const Vector2 &mask_pos,
+                                         const Graphics::Ellipse &ellipse);
+
+        /**
+         * @enum SIMDLevel
+         * @brief 批量检测使用的指令集
+         */
+        enum SIMDLevel : uint8_t {
+            /// 标量实现（所有平台可用）
+            Scalar,
+            /// SSE2，每次检测 4 个图形
+            SSE2,
+            /// AVX2，每次检测 8 个图形
+            AVX2
+        };
+        /**
+         * @struct ShapeArray
+         * @brief 以 SoA（结构数组）形式存储的图形数组
+         *
+         * 仅保存位置与尺寸，便于批量检测时连续加载。
+         * 存储矩形时 `x`、`y` 为左上角坐标；存储椭圆时为中心坐标（与 `Graphics::Ellipse` 一致）。
+         * @since v1.1.0-alpha
+         */
+        struct ShapeArray {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> width;
+            std::vector<float> height;
+            void append(float x, float y, float width, float height);
+            void append(const Graphics::Rectangle& rect);
+            void append(const Graphics::Ellipse& ellipse);
+            void reserve(size_t count);
+            void clear();
+            size_t size() const;
+        };
+        /**
+         * @brief 获取批量检测当前使用的指令集
+         * @note 首次调用时根据 CPU 自动选择可用的最高级别
+         */
+        static SIMDLevel simdLevel();
+        /**
+         * @brief 指定批量检测使用的指令集
+         * @param level 指令集，超过 CPU 支持的级别时自动降级
+         * @note 主要用于性能对比及验证结果一致
+         */
+        static void setSIMDLevel(SIMDLevel level);
+        /**
+         * @brief 批量判断点是否位于各个矩形上或内部
+         * @param pos   指定的点所在的坐标
+         * @param rects 指定的矩形数组
+         * @param mask  用于接收结果的位掩码，第 i 位表示第 i 个矩形是否命中
+         * @return 返回命中的数量
+         * @note 结果与逐个调用 `comparePosRect() >= 0` 一致
+         * @see maskToIndices
+         */
+        static size_t comparePosRectBatch(const Vector2 &pos, const ShapeArray &rects, std::vector<uint64_t> &mask);
+        /**
+         * @brief 批量判断点是否位于各个椭圆上或内部
+         * @param pos      指定的点所在的坐标
+         * @param ellipses 指定的椭圆数组
+         * @param mask     用于接收结果的位掩码
+         * @return 返回命中的数量
+         * @note 结果与逐个调用 `comparePosEllipse() >= 0` 一致
+         */
+        static size_t comparePosEllipseBatch(const Vector2 &pos, const ShapeArray &ellipses, std::vector<uint64_t> &mask);
+        /**
+         * @brief 批量判断矩形是否与各个矩形相交或包含
+         * @param rect  指定矩形
+         * @param rects 指定的矩形数组
+         * @param mask  用于接收结果的位掩码
+         * @return 返回命中的数量
+         * @note 结果与逐个调用 `compareRect() >= 0` 一致
+         */
+        static size_t compareRectBatch(const Graphics::Rectangle &rect, const ShapeArray &rects, std::vector<uint64_t> &mask);
+        /**
+         * @brief 批量判断椭圆是否与各个椭圆相交或包含
+         * @param ellipse  指定椭圆
+         * @param ellipses 指定的椭圆数组
+         * @param mask     用于接收结果的位掩码
+         * @return 返回命中的数量
+         * @note 结果与逐个调用 `compareEllipse() >= 0` 一致
+         */
+        static size_t compareEllipseBatch(const Graphics::Ellipse &ellipse, const ShapeArray &ellipses,
+                                          std::vector<uint64_t> &mask);
+        /**
+         * @brief 将位掩码转换为命中的索引列表
+         * @param mask    批量检测得到的位掩码
+         * @param indices 用于接收按升序排列的索引
+         */
+        static void maskToIndices(const std::vector<uint64_t> &mask, std::vector<uint32_t> &indices);
+
         /**
          * @brief 捕获当前窗口下的所有内容
          * @param painter 指定窗口下使用的绘图器
          * @return 返回生成的捕获画面
+         * @note 读取绘图器保留的最近一帧（见 `Painter::setFrameRetained()`），未保留时返回 `nullptr`，
+         *       并从下一帧起开始保留
+         * @note 不希望阻塞帧循环时，请使用 `Painter::requestScreenshot()` 或 `Painter::startRecording()`
+         * @see Painter::readFrame
          */
         static SSurface *captureWindow(Painter* painter);
 
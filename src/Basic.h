@@ -284,6 +284,50 @@ namespace EasyEngine {
         }
     };
 
+    /**
+     * @struct MemoryUsage
+     * @brief 内存占用
+     *
+     * 分别统计驻留在 CPU（表面）与 GPU（纹理）上的字节数
+     * @since v1.1.0-alpha
+     */
+    struct MemoryUsage {
+        /// CPU 端驻留字节数
+        uint64_t cpu_bytes{0};
+        /// GPU 端驻留字节数
+        uint64_t gpu_bytes{0};
+    };
+
+    /**
+     * @struct AlphaMask
+     * @brief 1 位透明度遮罩
+     *
+     * 将图片中透明度不低于阈值的像素记为 1，其余记为 0，每行按 64 位紧凑存储（低位对应左侧的像素），
+     * 行末不足 64 位的部分始终为 0。用于像素级的碰撞检测。
+     * @see Algorithm::createAlphaMask
+     * @see ResourceSystem::alphaMask
+     * @since v1.1.0-alpha
+     */
+    struct AlphaMask {
+        /// 宽度（像素）
+        uint32_t width{0};
+        /// 高度（像素）
+        uint32_t height{0};
+        /// 每行占用的 64 位字数
+        uint32_t words_per_row{0};
+        /// 逐行存储的位数据
+        std::vector<uint64_t> bits;
+        /// 获取第 y 行的位数据
+        const uint64_t* row(uint32_t y) const {
+            return bits.data() + static_cast<size_t>(y) * words_per_row;
+        }
+        /// 查看指定像素是否不透明（超出范围时返回 false）
+        bool test(int64_t x, int64_t y) const {
+            if (x < 0 || y < 0 || x >= width || y >= height) return false;
+            return (row(static_cast<uint32_t>(y))[x >> 6] >> (x & 63)) & 1;
+        }
+    };
+
     /**
      * @struct Matrix2D
      * @brief 二维矩阵
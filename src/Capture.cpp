@@ -0,0 +1,128 @@
+
+#include "Capture.h"
+#include "Profiler.h"
+
+namespace EasyEngine {
+    std::unique_ptr<FrameCapture> FrameCapture::_instance(new FrameCapture());
+
+    FrameCapture* FrameCapture::global() {
+        return _instance.get();
+    }
+
+    FrameCapture::~FrameCapture() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop_worker = true;
+        }
+        _job_cv.notify_all();
+        if (_worker.joinable()) _worker.join();
+    }
+
+    void FrameCapture::setMaxPendingFrames(size_t count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _max_pending = std::max<size_t>(count, 1);
+    }
+
+    size_t FrameCapture::maxPendingFrames() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _max_pending;
+    }
+
+    bool FrameCapture::submit(SSurface* surface, const std::string& path, Format format,
+                              const std::function<void(bool)>& callback) {
+        if (!surface) {
+            SDL_Log("[ERROR] The specified surface is not valid!");
+            if (callback) callback(false);
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.submitted += 1;
+            if (_jobs.size() >= _max_pending) {
+                _stats.dropped += 1;
+                SDL_DestroySurface(surface);
+                if (callback) callback(false);
+                return false;
+            }
+            if (!_worker.joinable()) _worker = std::thread(&FrameCapture::workerLoop, this);
+            _jobs.push_back({surface, path, format, callback});
+        }
+        _job_cv.notify_one();
+        return true;
+    }
+
+    void FrameCapture::wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle_cv.wait(lock, [this] { return _jobs.empty() && !_is_encoding; });
+    }
+
+    FrameCapture::Stats FrameCapture::stats() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Stats stats = _stats;
+        stats.pending = _jobs.size() + (_is_encoding ? 1 : 0);
+        return stats;
+    }
+
+    void FrameCapture::workerLoop() {
+        bool named = false;
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _job_cv.wait(lock, [this] { return _stop_worker || !_jobs.empty(); });
+                // 退出前仍会保存队列中剩余的画面
+                if (_jobs.empty()) return;
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                _is_encoding = true;
+            }
+            if (!named && Profiler::global()->enabled()) {
+                Profiler::global()->setThreadName("CaptureWorker");
+                named = true;
+            }
+            bool ok;
+            {
+                EASYENGINE_PROFILE_ZONE("Encode");
+                ok = encode(job);
+            }
+            SDL_DestroySurface(job.surface);
+            if (job.callback) job.callback(ok);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ok ? _stats.saved += 1 : _stats.failed += 1;
+                _is_encoding = false;
+            }
+            _idle_cv.notify_all();
+        }
+    }
+
+    bool FrameCapture::encode(const Job& job) {
+        if (job.format == PNG) {
+            if (!IMG_SavePNG(job.surface, job.path.c_str())) {
+                SDL_Log("[ERROR] Can't save the frame to '%s'!\nException: %s", job.path.c_str(), SDL_GetError());
+                return false;
+            }
+            return true;
+        }
+        SSurface* rgba = job.surface->format == SDL_PIXELFORMAT_RGBA32
+                         ? job.surface : SDL_ConvertSurface(job.surface, SDL_PIXELFORMAT_RGBA32);
+        if (!rgba) {
+            SDL_Log("[ERROR] Can't convert the frame to RGBA32!\nException: %s", SDL_GetError());
+            return false;
+        }
+        std::ofstream file(job.path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            const auto row_size = static_cast<std::streamsize>(rgba->w) * 4;
+            for (int y = 0; y < rgba->h; ++y) {
+                file.write(static_cast<const char*>(rgba->pixels) + static_cast<ptrdiff_t>(y) * rgba->pitch,
+                           row_size);
+            }
+        }
+        if (rgba != job.surface) SDL_DestroySurface(rgba);
+        if (!file.good()) {
+            SDL_Log("[ERROR] Can't save the frame to '%s'!", job.path.c_str());
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef EASYENGINE_CAPTURE_H
+#define EASYENGINE_CAPTURE_H
+
+/**
+ * @file Capture.h
+ * @brief 画面捕获
+ *
+ * 异步的截图与录制管线：绘制器将画面绘制到离屏纹理中并读取像素，
+ * 编码与写入文件在后台线程中完成，不会阻塞帧循环。
+ *
+ * @copyright Copyright © 2025 CatIsNotFound
+ * @author CatIsNotFound
+ */
+
+#include "Basic.h"
+
+namespace EasyEngine {
+    /**
+     * @class FrameCapture
+     * @brief 画面捕获管线
+     *
+     * 负责在后台线程中编码由绘制器读取的画面。
+     * 待编码的画面数量有上限（见 `setMaxPendingFrames()`），超过上限时直接丢弃新的画面，
+     * 以保证录制不会拖慢帧循环。
+     * @code
+     * engine.painter()->requestScreenshot("shot.png");
+     * engine.painter()->startRecording("record", FrameCapture::Raw);
+     * @endcode
+     * @see Painter::requestScreenshot
+     * @see Painter::startRecording
+     * @since v1.1.0-alpha
+     */
+    class FrameCapture {
+    public:
+        /**
+         * @enum Format
+         * @brief 画面保存格式
+         */
+        enum Format : uint8_t {
+            /// PNG 图片
+            PNG,
+            /// 无文件头的 RGBA32 像素数据（可直接交给 `ffmpeg -f rawvideo -pix_fmt rgba` 编码）
+            Raw
+        };
+        /**
+         * @struct Stats
+         * @brief 捕获统计信息
+         */
+        struct Stats {
+            /// 已提交的画面数
+            uint64_t submitted{0};
+            /// 已成功保存的画面数
+            uint64_t saved{0};
+            /// 因待编码画面过多而丢弃的画面数
+            uint64_t dropped{0};
+            /// 保存失败的画面数
+            uint64_t failed{0};
+            /// 当前待编码的画面数
+            size_t pending{0};
+        };
+
+        /**
+         * @brief 获取全局画面捕获管线
+         */
+        static FrameCapture* global();
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+        ~FrameCapture();
+        /**
+         * @brief 设置待编码画面数量的上限
+         * @param count 上限（默认为 4，最小为 1）
+         */
+        void setMaxPendingFrames(size_t count);
+        /**
+         * @brief 获取待编码画面数量的上限
+         */
+        size_t maxPendingFrames() const;
+        /**
+         * @brief 提交画面进行编码
+         * @param surface  由 `SDL_RenderReadPixels()` 读取的画面，提交后由管线负责释放
+         * @param path     保存路径
+         * @param format   保存格式
+         * @param callback 保存完成后的回调函数（在后台线程中调用），参数表示是否保存成功
+         * @return 返回是否已加入队列，待编码画面过多时返回 false 并丢弃此画面
+         */
+        bool submit(SSurface* surface, const std::string& path, Format format = PNG,
+                    const std::function<void(bool)>& callback = {});
+        /**
+         * @brief 阻塞直至所有待编码画面保存完毕
+         */
+        void wait();
+        /**
+         * @brief 获取捕获统计信息
+         */
+        Stats stats() const;
+
+    private:
+        struct Job {
+            SSurface* surface;
+            std::string path;
+            Format format;
+            std::function<void(bool)> callback;
+        };
+        explicit FrameCapture() = default;
+        static std::unique_ptr<FrameCapture> _instance;
+        void workerLoop();
+        static bool encode(const Job& job);
+        mutable std::mutex _mutex;
+        std::condition_variable _job_cv;
+        std::condition_variable _idle_cv;
+        std::deque<Job> _jobs;
+        std::thread _worker;
+        bool _stop_worker{false};
+        bool _is_encoding{false};
+        size_t _max_pending{4};
+        Stats _stats;
+    };
+}
+
+#endif //EASYENGINE_CAPTURE_H
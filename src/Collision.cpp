@@ -0,0 +1,745 @@
+#include "Collision.h"
+
+using namespace EasyEngine;
+
+namespace {
+    uint64_t pairKey(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+    /// 单个碰撞器最多写入的单元格数量，超出时改为存放在大型碰撞器列表中
+    constexpr double MAX_PROXY_CELLS = 64;
+}
+
+Components::CollisionWorld::CollisionWorld(BroadPhase broad_phase, float cell_size)
+    : _broad_phase(broad_phase), _cell_size(cell_size > 0 ? cell_size : 64.0f) {}
+
+Components::CollisionWorld::~CollisionWorld() {
+    clear();
+}
+
+Components::Collider *Components::CollisionWorld::create(float x, float y, float width, float height,
+                                                         uint8_t shape_mode) {
+    if (shape_mode < 1 || shape_mode > 3) {
+        SDL_Log("[ERROR] The specified shape mode %u is not valid!", shape_mode);
+        return nullptr;
+    }
+    auto collider = std::make_unique<Collider>(x, y, width, height, shape_mode);
+    collider->setEnabled(true);
+    auto ptr = collider.get();
+    addProxy(ptr, nullptr, std::move(collider));
+    return ptr;
+}
+
+Components::Collider *Components::CollisionWorld::create(const Components::Collider &collider) {
+    auto copy = std::make_unique<Collider>(collider);
+    auto ptr = copy.get();
+    addProxy(ptr, nullptr, std::move(copy));
+    return ptr;
+}
+
+bool Components::CollisionWorld::append(Components::Collider *collider) {
+    if (!collider) {
+        SDL_Log("[ERROR] The specified collider is not valid!");
+        return false;
+    }
+    if (collider->_world) {
+        SDL_Log("[ERROR] The specified collider is already in a collision world!");
+        return false;
+    }
+    addProxy(collider, nullptr, nullptr);
+    return true;
+}
+
+bool Components::CollisionWorld::append(Components::Entity *entity) {
+    if (!entity || !entity->collider()) {
+        SDL_Log("[ERROR] The specified entity is not valid!");
+        return false;
+    }
+    if (entity->collider()->_world) {
+        SDL_Log("[ERROR] The collider of entity '%s' is already in a collision world!", entity->name().c_str());
+        return false;
+    }
+    addProxy(entity->collider(), entity, nullptr);
+    return true;
+}
+
+bool Components::CollisionWorld::remove(Components::Collider *collider) {
+    if (!collider || collider->_world != this) {
+        SDL_Log("[ERROR] The specified collider is not in this collision world!");
+        return false;
+    }
+    removeProxy(collider->_proxy);
+    return true;
+}
+
+bool Components::CollisionWorld::remove(Components::Entity *entity) {
+    if (!entity) {
+        SDL_Log("[ERROR] The specified entity is not valid!");
+        return false;
+    }
+    return remove(entity->collider());
+}
+
+void Components::CollisionWorld::clear() {
+    for (uint32_t i = 0; i < _proxies.size(); ++i) {
+        if (_proxies[i].collider) _proxies[i].collider->_world = nullptr;
+    }
+    _proxies.clear();
+    _free_proxies.clear();
+    _moved_list.clear();
+    _count = 0;
+    _nodes.clear();
+    _root = _free_node = -1;
+    _cells.clear();
+    _large_proxies.clear();
+    _contacts.clear();
+    _begin_contacts.clear();
+    _stay_contacts.clear();
+    _end_contacts.clear();
+}
+
+size_t Components::CollisionWorld::count() const {
+    return _count;
+}
+
+void Components::CollisionWorld::setBroadPhase(BroadPhase broad_phase) {
+    if (_broad_phase == broad_phase) return;
+    _broad_phase = broad_phase;
+    rebuild();
+}
+
+Components::CollisionWorld::BroadPhase Components::CollisionWorld::broadPhase() const {
+    return _broad_phase;
+}
+
+void Components::CollisionWorld::setCellSize(float size) {
+    if (size <= 0) {
+        SDL_Log("[ERROR] The cell size must be greater than 0!");
+        return;
+    }
+    _cell_size = size;
+    if (_broad_phase == SpatialHash) rebuild();
+}
+
+float Components::CollisionWorld::cellSize() const {
+    return _cell_size;
+}
+
+void Components::CollisionWorld::setTreeMargin(float margin) {
+    _tree_margin = std::max(margin, 0.0f);
+}
+
+float Components::CollisionWorld::treeMargin() const {
+    return _tree_margin;
+}
+
+void Components::CollisionWorld::step() {
+    updateProxies();
+    _next_contacts.clear();
+    // 两个碰撞器均未变化时，接触状态保持不变
+    for (auto key : _contacts) {
+        if (!_proxies[key >> 32].moved && !_proxies[key & 0xFFFFFFFF].moved) _next_contacts.push_back(key);
+    }
+    // 仅为变化过的碰撞器查找候选对；双方都变化时只由序号较小的一方记录
+    for (auto id : _moved_list) {
+        auto& proxy = _proxies[id];
+        if (!proxy.collider->enabled() || !proxy.collider->isValid()) continue;
+        queryBox(proxy.box, [this, id](uint32_t other) {
+            if (other == id) return;
+            auto& candidate = _proxies[other];
+            if (candidate.moved && other < id) return;
+            if (_proxies[id].collider->check(*candidate.collider) >= 0) _next_contacts.push_back(pairKey(id, other));
+        });
+    }
+    for (auto id : _moved_list) _proxies[id].moved = false;
+    _moved_list.clear();
+    std::sort(_next_contacts.begin(), _next_contacts.end());
+
+    _begin_contacts.clear();
+    _stay_contacts.clear();
+    _end_contacts.clear();
+    size_t i = 0, j = 0;
+    while (i < _contacts.size() || j < _next_contacts.size()) {
+        if (j == _next_contacts.size() || (i < _contacts.size() && _contacts[i] < _next_contacts[j])) {
+            _end_contacts.push_back(makeContact(_contacts[i++]));
+        } else if (i == _contacts.size() || _next_contacts[j] < _contacts[i]) {
+            _begin_contacts.push_back(makeContact(_next_contacts[j++]));
+        } else {
+            _stay_contacts.push_back(makeContact(_next_contacts[j]));
+            ++i, ++j;
+        }
+    }
+    _contacts.swap(_next_contacts);
+    if (_contact_event) {
+        for (auto& contact : _begin_contacts) _contact_event(contact, Begin);
+        for (auto& contact : _stay_contacts) _contact_event(contact, Stay);
+        for (auto& contact : _end_contacts) _contact_event(contact, End);
+    }
+}
+
+const std::vector<Components::CollisionWorld::Contact> &Components::CollisionWorld::beginContacts() const {
+    return _begin_contacts;
+}
+
+const std::vector<Components::CollisionWorld::Contact> &Components::CollisionWorld::stayContacts() const {
+    return _stay_contacts;
+}
+
+const std::vector<Components::CollisionWorld::Contact> &Components::CollisionWorld::endContacts() const {
+    return _end_contacts;
+}
+
+void Components::CollisionWorld::installContactEvent(
+        const std::function<void(const Contact &, ContactState)> &function) {
+    _contact_event = function;
+}
+
+std::vector<Components::Collider *> Components::CollisionWorld::query(const GeometryF &area) {
+    updateProxies();
+    std::vector<Collider*> result;
+    const Box box{area.pos.x, area.pos.y, area.pos.x + area.size.width, area.pos.y + area.size.height};
+    queryBox(box, [this, &result](uint32_t id) { result.push_back(_proxies[id].collider); });
+    return result;
+}
+
+std::vector<Components::CollisionWorld::RayHit> Components::CollisionWorld::raycast(const Vector2 &origin,
+                                                                                    const Vector2 &delta) {
+    updateProxies();
+    std::vector<RayHit> hits;
+    const auto test = [this, &hits, &origin, &delta](uint32_t id) {
+        auto& proxy = _proxies[id];
+        auto impact = proxy.collider->raycast(origin, delta);
+        if (impact.collided) hits.push_back({proxy.collider, proxy.entity, impact});
+    };
+    const Box bounds{std::min(origin.x, origin.x + delta.x), std::min(origin.y, origin.y + delta.y),
+                     std::max(origin.x, origin.x + delta.x), std::max(origin.y, origin.y + delta.y)};
+    if (_broad_phase == AABBTree) {
+        // 仅进入与线段相交的节点（slab 算法）
+        const auto crosses = [&origin, &delta](const Box& box) {
+            float t_min = 0.0f, t_max = 1.0f;
+            const float o[2] = {origin.x, origin.y}, d[2] = {delta.x, delta.y};
+            const float lo[2] = {box.min_x, box.min_y}, hi[2] = {box.max_x, box.max_y};
+            for (int axis = 0; axis < 2; ++axis) {
+                if (d[axis] == 0) {
+                    if (o[axis] < lo[axis] || o[axis] > hi[axis]) return false;
+                    continue;
+                }
+                float t1 = (lo[axis] - o[axis]) / d[axis], t2 = (hi[axis] - o[axis]) / d[axis];
+                if (t1 > t2) std::swap(t1, t2);
+                t_min = std::max(t_min, t1);
+                t_max = std::min(t_max, t2);
+                if (t_min > t_max) return false;
+            }
+            return true;
+        };
+        if (_root >= 0) {
+            _stack.clear();
+            _stack.push_back(_root);
+            while (!_stack.empty()) {
+                auto& node = _nodes[_stack.back()];
+                _stack.pop_back();
+                if (!node.box.overlaps(bounds) || !crosses(node.box)) continue;
+                if (!node.isLeaf()) {
+                    _stack.push_back(node.child1);
+                    _stack.push_back(node.child2);
+                    continue;
+                }
+                auto& proxy = _proxies[node.proxy];
+                if (proxy.collider->enabled() && proxy.collider->isValid()) test(node.proxy);
+            }
+        }
+    } else {
+        queryBox(bounds, test);
+    }
+    std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) {
+        return a.impact.time < b.impact.time;
+    });
+    return hits;
+}
+
+std::vector<Components::Collider *> Components::CollisionWorld::nearest(const Vector2 &point, size_t count) {
+    updateProxies();
+    std::vector<Collider*> result;
+    if (count == 0 || _count == 0) return result;
+    // 查找范围以指定点为中心扩大，点坐标无效时范围永远无法覆盖所有碰撞器
+    if (!std::isfinite(point.x) || !std::isfinite(point.y)) return result;
+    // 所有碰撞器的范围，用于判断查找范围是否已覆盖全部
+    Box world{};
+    if (_broad_phase == AABBTree) {
+        if (_root < 0) return result;
+        world = _nodes[_root].box;
+    } else {
+        bool first = true;
+        for (auto& proxy : _proxies) {
+            if (!proxy.collider || !proxy.box.isFinite()) continue;
+            if (first) world = proxy.box;
+            world = {std::min(world.min_x, proxy.box.min_x), std::min(world.min_y, proxy.box.min_y),
+                     std::max(world.max_x, proxy.box.max_x), std::max(world.max_y, proxy.box.max_y)};
+            first = false;
+        }
+    }
+    std::vector<std::pair<float, uint32_t>> found;
+    float radius = _broad_phase == SpatialHash ? _cell_size : 64.0f;
+    while (true) {
+        found.clear();
+        const Box range{point.x - radius, point.y - radius, point.x + radius, point.y + radius};
+        queryBox(range, [this, &found, &point](uint32_t id) {
+            found.emplace_back(_proxies[id].box.distanceSquared(point.x, point.y), id);
+        });
+        // 范围外的碰撞器距离必然大于 radius，因此第 count 近的距离不超过 radius 时即可结束
+        if (found.size() >= count) {
+            std::nth_element(found.begin(), found.begin() + static_cast<ptrdiff_t>(count - 1), found.end());
+            if (found[count - 1].first <= radius * radius) break;
+        }
+        if (range.contains(world)) break;
+        radius *= 2;
+    }
+    const size_t size = std::min(count, found.size());
+    std::partial_sort(found.begin(), found.begin() + static_cast<ptrdiff_t>(size), found.end());
+    result.reserve(size);
+    for (size_t i = 0; i < size; ++i) result.push_back(_proxies[found[i].second].collider);
+    return result;
+}
+
+const std::vector<Components::CollisionWorld::SweepHit> &Components::CollisionWorld::sweepEntities() {
+    updateProxies();
+    _sweep_hits.clear();
+    const auto motion = [](const Entity* entity) {
+        return entity ? entity->position() - entity->previousPosition() : Vector2(0, 0);
+    };
+    // 目标同样可能移动，查询范围需再扩展所有实体中最大的位移
+    float reach_x = 0, reach_y = 0;
+    for (auto& proxy : _proxies) {
+        if (!proxy.entity) continue;
+        const auto delta = motion(proxy.entity);
+        reach_x = std::max(reach_x, std::fabs(delta.x));
+        reach_y = std::max(reach_y, std::fabs(delta.y));
+    }
+    for (uint32_t id = 0; id < _proxies.size(); ++id) {
+        auto& proxy = _proxies[id];
+        if (!proxy.entity || !proxy.collider->enabled() || !proxy.collider->isValid()) continue;
+        const auto delta = motion(proxy.entity);
+        if (delta.x == 0 && delta.y == 0) continue;
+        const Box swept{std::min(proxy.box.min_x, proxy.box.min_x - delta.x) - reach_x,
+                        std::min(proxy.box.min_y, proxy.box.min_y - delta.y) - reach_y,
+                        std::max(proxy.box.max_x, proxy.box.max_x - delta.x) + reach_x,
+                        std::max(proxy.box.max_y, proxy.box.max_y - delta.y) + reach_y};
+        const auto to = proxy.entity->position();
+        SweepHit hit{proxy.entity, nullptr, nullptr, Collider::Impact(), to - delta, to};
+        queryBox(swept, [&](uint32_t other) {
+            if (other == id) return;
+            auto& candidate = _proxies[other];
+            const auto target_delta = motion(candidate.entity);
+            // 碰撞器已位于当前位置，需先退回到上一位置
+            auto impact = proxy.collider->sweepFrom(delta * -1, delta, *candidate.collider,
+                                                    target_delta * -1, target_delta);
+            if (impact.collided && (!hit.target || impact.time < hit.impact.time)) {
+                hit.target = candidate.collider;
+                hit.target_entity = candidate.entity;
+                hit.impact = impact;
+            }
+        });
+        if (hit.target) _sweep_hits.push_back(hit);
+    }
+    // 位移仅在本次检测中有效，避免停止移动的实体在之后的每次检测中重复扫掠
+    for (auto& proxy : _proxies) {
+        if (proxy.entity) proxy.entity->resetMotion();
+    }
+    return _sweep_hits;
+}
+
+void Components::CollisionWorld::_markMoved(uint32_t proxy) {
+    auto& target = _proxies[proxy];
+    target.dirty = true;
+    if (!target.moved) {
+        target.moved = true;
+        _moved_list.push_back(proxy);
+    }
+}
+
+uint32_t Components::CollisionWorld::addProxy(Components::Collider *collider, Components::Entity *entity,
+                                              std::unique_ptr<Collider> owned) {
+    uint32_t id;
+    if (!_free_proxies.empty()) {
+        id = _free_proxies.back();
+        _free_proxies.pop_back();
+    } else {
+        id = static_cast<uint32_t>(_proxies.size());
+        _proxies.emplace_back();
+    }
+    auto& proxy = _proxies[id];
+    proxy = Proxy();
+    proxy.collider = collider;
+    proxy.entity = entity;
+    proxy.owned = std::move(owned);
+    collider->_world = this;
+    collider->_proxy = id;
+    _count += 1;
+    _markMoved(id);
+    auto bounds = collider->boundingBox();
+    proxy.box = {bounds.pos.x, bounds.pos.y, bounds.pos.x + bounds.size.width, bounds.pos.y + bounds.size.height};
+    proxy.dirty = false;
+    insertBroadPhase(id);
+    return id;
+}
+
+void Components::CollisionWorld::removeProxy(uint32_t id) {
+    auto& proxy = _proxies[id];
+    removeBroadPhase(id);
+    if (proxy.moved) std::erase(_moved_list, id);
+    std::erase_if(_contacts, [id](uint64_t key) {
+        return static_cast<uint32_t>(key >> 32) == id || static_cast<uint32_t>(key & 0xFFFFFFFF) == id;
+    });
+    proxy.collider->_world = nullptr;
+    // 先移出再销毁，避免碰撞器析构时再次移除
+    auto owned = std::move(proxy.owned);
+    proxy = Proxy();
+    _free_proxies.push_back(id);
+    _count -= 1;
+}
+
+void Components::CollisionWorld::updateProxies() {
+    for (auto id : _moved_list) {
+        auto& proxy = _proxies[id];
+        if (!proxy.dirty) continue;
+        proxy.dirty = false;
+        auto bounds = proxy.collider->boundingBox();
+        const Box box{bounds.pos.x, bounds.pos.y, bounds.pos.x + bounds.size.width, bounds.pos.y + bounds.size.height};
+        proxy.box = box;
+        if (_broad_phase == AABBTree) {
+            // 仍在扩展后的包围盒内时无需更新树
+            if (proxy.node >= 0 && _nodes[proxy.node].box.contains(box)) continue;
+        } else {
+            int32_t min_x, min_y, max_x, max_y;
+            if (cellRange(box, MAX_PROXY_CELLS, min_x, min_y, max_x, max_y)) {
+                if (!proxy.large && min_x == proxy.cell_min_x && min_y == proxy.cell_min_y &&
+                    max_x == proxy.cell_max_x && max_y == proxy.cell_max_y) {
+                    continue;
+                }
+            } else if (proxy.large && box.isFinite()) {
+                continue;
+            }
+        }
+        removeBroadPhase(id);
+        insertBroadPhase(id);
+    }
+}
+
+void Components::CollisionWorld::insertBroadPhase(uint32_t id) {
+    auto& proxy = _proxies[id];
+    // 包含 NaN 或无穷大的包围盒无法参与检测，也会破坏加速结构
+    if (!proxy.box.isFinite()) {
+        SDL_Log("[WARNING] The bounding box of collider %u is not finite! It will be ignored.", id);
+        return;
+    }
+    if (_broad_phase == AABBTree) {
+        const int32_t leaf = allocateNode();
+        _nodes[leaf].box = {proxy.box.min_x - _tree_margin, proxy.box.min_y - _tree_margin,
+                            proxy.box.max_x + _tree_margin, proxy.box.max_y + _tree_margin};
+        _nodes[leaf].proxy = id;
+        _proxies[id].node = leaf;
+        insertLeaf(leaf);
+        return;
+    }
+    if (!cellRange(proxy.box, MAX_PROXY_CELLS, proxy.cell_min_x, proxy.cell_min_y,
+                   proxy.cell_max_x, proxy.cell_max_y)) {
+        proxy.cell_min_x = proxy.cell_min_y = 0;
+        proxy.cell_max_x = proxy.cell_max_y = -1;
+        proxy.large = true;
+        _large_proxies.push_back(id);
+        return;
+    }
+    for (int32_t y = proxy.cell_min_y; y <= proxy.cell_max_y; ++y) {
+        for (int32_t x = proxy.cell_min_x; x <= proxy.cell_max_x; ++x) {
+            _cells[cellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void Components::CollisionWorld::removeBroadPhase(uint32_t id) {
+    auto& proxy = _proxies[id];
+    if (proxy.node >= 0) {
+        removeLeaf(proxy.node);
+        freeNode(proxy.node);
+        proxy.node = -1;
+    }
+    if (proxy.large) {
+        auto pos = std::find(_large_proxies.begin(), _large_proxies.end(), id);
+        *pos = _large_proxies.back();
+        _large_proxies.pop_back();
+        proxy.large = false;
+    }
+    for (int32_t y = proxy.cell_min_y; y <= proxy.cell_max_y; ++y) {
+        for (int32_t x = proxy.cell_min_x; x <= proxy.cell_max_x; ++x) {
+            auto it = _cells.find(cellKey(x, y));
+            if (it == _cells.end()) continue;
+            auto& cell = it->second;
+            auto pos = std::find(cell.begin(), cell.end(), id);
+            if (pos != cell.end()) {
+                *pos = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty()) _cells.erase(it);
+        }
+    }
+    proxy.cell_min_x = proxy.cell_min_y = 0;
+    proxy.cell_max_x = proxy.cell_max_y = -1;
+}
+
+void Components::CollisionWorld::rebuild() {
+    _nodes.clear();
+    _root = _free_node = -1;
+    _cells.clear();
+    _large_proxies.clear();
+    for (uint32_t id = 0; id < _proxies.size(); ++id) {
+        auto& proxy = _proxies[id];
+        if (!proxy.collider) continue;
+        proxy.node = -1;
+        proxy.cell_min_x = proxy.cell_min_y = 0;
+        proxy.cell_max_x = proxy.cell_max_y = -1;
+        proxy.large = false;
+        insertBroadPhase(id);
+    }
+}
+
+template<class Function>
+void Components::CollisionWorld::queryBox(const Box &box, Function &&function) {
+    const auto visit = [this, &box, &function](uint32_t id) {
+        auto& proxy = _proxies[id];
+        if (proxy.stamp == _stamp) return;
+        proxy.stamp = _stamp;
+        if (!proxy.collider->enabled() || !proxy.collider->isValid() || !proxy.box.overlaps(box)) return;
+        function(id);
+    };
+    // 同一碰撞器可能位于多个单元格中，通过标记去重
+    if (++_stamp == 0) {
+        for (auto& proxy : _proxies) proxy.stamp = 0;
+        _stamp = 1;
+    }
+    if (_broad_phase == AABBTree) {
+        if (_root < 0) return;
+        _stack.clear();
+        _stack.push_back(_root);
+        while (!_stack.empty()) {
+            const int32_t index = _stack.back();
+            _stack.pop_back();
+            auto& node = _nodes[index];
+            if (!node.box.overlaps(box)) continue;
+            if (node.isLeaf()) {
+                visit(node.proxy);
+            } else {
+                _stack.push_back(node.child1);
+                _stack.push_back(node.child2);
+            }
+        }
+        return;
+    }
+    for (auto id : _large_proxies) visit(id);
+    // 查询范围覆盖的单元格多于碰撞器时，直接遍历所有碰撞器更快
+    int32_t min_x, min_y, max_x, max_y;
+    if (!cellRange(box, static_cast<double>(_proxies.size()), min_x, min_y, max_x, max_y)) {
+        for (uint32_t id = 0; id < _proxies.size(); ++id) {
+            if (_proxies[id].collider && _proxies[id].box.isFinite()) visit(id);
+        }
+        return;
+    }
+    for (int32_t y = min_y; y <= max_y; ++y) {
+        for (int32_t x = min_x; x <= max_x; ++x) {
+            auto it = _cells.find(cellKey(x, y));
+            if (it == _cells.end()) continue;
+            for (auto id : it->second) visit(id);
+        }
+    }
+}
+
+Components::CollisionWorld::Contact Components::CollisionWorld::makeContact(uint64_t key) const {
+    auto& first = _proxies[key >> 32];
+    auto& second = _proxies[key & 0xFFFFFFFF];
+    return {first.collider, second.collider, first.entity, second.entity};
+}
+
+int32_t Components::CollisionWorld::allocateNode() {
+    int32_t node;
+    if (_free_node >= 0) {
+        node = _free_node;
+        _free_node = _nodes[node].parent;
+    } else {
+        node = static_cast<int32_t>(_nodes.size());
+        _nodes.emplace_back();
+    }
+    _nodes[node] = TreeNode();
+    return node;
+}
+
+void Components::CollisionWorld::freeNode(int32_t node) {
+    // 空闲节点通过 parent 串联
+    _nodes[node].parent = _free_node;
+    _nodes[node].height = -1;
+    _free_node = node;
+}
+
+void Components::CollisionWorld::insertLeaf(int32_t leaf) {
+    if (_root < 0) {
+        _root = leaf;
+        _nodes[leaf].parent = -1;
+        return;
+    }
+    const auto merge = [](const Box& a, const Box& b) {
+        return Box{std::min(a.min_x, b.min_x), std::min(a.min_y, b.min_y),
+                   std::max(a.max_x, b.max_x), std::max(a.max_y, b.max_y)};
+    };
+    const auto perimeter = [](const Box& box) {
+        return 2.0f * ((box.max_x - box.min_x) + (box.max_y - box.min_y));
+    };
+    // 按表面积启发式（周长）选择代价最小的兄弟节点
+    const Box leaf_box = _nodes[leaf].box;
+    int32_t index = _root;
+    while (!_nodes[index].isLeaf()) {
+        const auto& node = _nodes[index];
+        const float area = perimeter(node.box);
+        const float combined_area = perimeter(merge(node.box, leaf_box));
+        const float cost = 2.0f * combined_area;
+        const float inheritance = 2.0f * (combined_area - area);
+        const auto child_cost = [&](int32_t child) {
+            const auto& c = _nodes[child];
+            const float merged = perimeter(merge(leaf_box, c.box));
+            return (c.isLeaf() ? merged : merged - perimeter(c.box)) + inheritance;
+        };
+        const float cost1 = child_cost(node.child1);
+        const float cost2 = child_cost(node.child2);
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    const int32_t sibling = index;
+    const int32_t old_parent = _nodes[sibling].parent;
+    const int32_t new_parent = allocateNode();
+    _nodes[new_parent].parent = old_parent;
+    _nodes[new_parent].box = merge(leaf_box, _nodes[sibling].box);
+    _nodes[new_parent].height = _nodes[sibling].height + 1;
+    if (old_parent >= 0) {
+        if (_nodes[old_parent].child1 == sibling) _nodes[old_parent].child1 = new_parent;
+        else _nodes[old_parent].child2 = new_parent;
+    } else {
+        _root = new_parent;
+    }
+    _nodes[new_parent].child1 = sibling;
+    _nodes[new_parent].child2 = leaf;
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    index = _nodes[leaf].parent;
+    while (index >= 0) {
+        index = balance(index);
+        auto& node = _nodes[index];
+        node.height = 1 + std::max(_nodes[node.child1].height, _nodes[node.child2].height);
+        node.box = merge(_nodes[node.child1].box, _nodes[node.child2].box);
+        index = node.parent;
+    }
+}
+
+void Components::CollisionWorld::removeLeaf(int32_t leaf) {
+    if (leaf == _root) {
+        _root = -1;
+        return;
+    }
+    const int32_t parent = _nodes[leaf].parent;
+    const int32_t grand_parent = _nodes[parent].parent;
+    const int32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+    if (grand_parent < 0) {
+        _root = sibling;
+        _nodes[sibling].parent = -1;
+        freeNode(parent);
+        return;
+    }
+    if (_nodes[grand_parent].child1 == parent) _nodes[grand_parent].child1 = sibling;
+    else _nodes[grand_parent].child2 = sibling;
+    _nodes[sibling].parent = grand_parent;
+    freeNode(parent);
+
+    int32_t index = grand_parent;
+    while (index >= 0) {
+        index = balance(index);
+        auto& node = _nodes[index];
+        const auto& c1 = _nodes[node.child1];
+        const auto& c2 = _nodes[node.child2];
+        node.box = {std::min(c1.box.min_x, c2.box.min_x), std::min(c1.box.min_y, c2.box.min_y),
+                    std::max(c1.box.max_x, c2.box.max_x), std::max(c1.box.max_y, c2.box.max_y)};
+        node.height = 1 + std::max(c1.height, c2.height);
+        index = node.parent;
+    }
+}
+
+int32_t Components::CollisionWorld::balance(int32_t index_a) {
+    auto& a = _nodes[index_a];
+    if (a.isLeaf() || a.height < 2) return index_a;
+    const auto merge = [](const Box& x, const Box& y) {
+        return Box{std::min(x.min_x, y.min_x), std::min(x.min_y, y.min_y),
+                   std::max(x.max_x, y.max_x), std::max(x.max_y, y.max_y)};
+    };
+    const int32_t index_b = a.child1;
+    const int32_t index_c = a.child2;
+    auto& b = _nodes[index_b];
+    auto& c = _nodes[index_c];
+    const int32_t diff = c.height - b.height;
+    // 通过旋转使左右子树的高度差不超过 1
+    const auto rotate = [&](int32_t index_up, TreeNode& up, TreeNode& other, bool up_is_child2) {
+        const int32_t index_f = up.child1;
+        const int32_t index_g = up.child2;
+        auto& f = _nodes[index_f];
+        auto& g = _nodes[index_g];
+        up.child1 = index_a;
+        up.parent = a.parent;
+        a.parent = index_up;
+        if (up.parent >= 0) {
+            if (_nodes[up.parent].child1 == index_a) _nodes[up.parent].child1 = index_up;
+            else _nodes[up.parent].child2 = index_up;
+        } else {
+            _root = index_up;
+        }
+        // 较高的子树留在上升的节点下，较矮的子树交给原节点
+        const bool keep_f = f.height > g.height;
+        const int32_t index_keep = keep_f ? index_f : index_g;
+        const int32_t index_move = keep_f ? index_g : index_f;
+        auto& keep = keep_f ? f : g;
+        auto& move = keep_f ? g : f;
+        up.child2 = index_keep;
+        if (up_is_child2) a.child2 = index_move;
+        else a.child1 = index_move;
+        move.parent = index_a;
+        a.box = merge(other.box, move.box);
+        up.box = merge(a.box, keep.box);
+        a.height = 1 + std::max(other.height, move.height);
+        up.height = 1 + std::max(a.height, keep.height);
+    };
+    if (diff > 1) {
+        rotate(index_c, c, b, true);
+        return index_c;
+    }
+    if (diff < -1) {
+        rotate(index_b, b, c, false);
+        return index_b;
+    }
+    return index_a;
+}
+
+int64_t Components::CollisionWorld::cellKey(int32_t x, int32_t y) {
+    return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+bool Components::CollisionWorld::cellRange(const Box &box, double max_cells, int32_t &min_x, int32_t &min_y,
+                                           int32_t &max_x, int32_t &max_y) const {
+    if (!box.isFinite()) return false;
+    const double x0 = std::floor(static_cast<double>(box.min_x) / _cell_size);
+    const double y0 = std::floor(static_cast<double>(box.min_y) / _cell_size);
+    const double x1 = std::floor(static_cast<double>(box.max_x) / _cell_size);
+    const double y1 = std::floor(static_cast<double>(box.max_y) / _cell_size);
+    // 先在浮点数下检查范围，避免转换为整数时溢出
+    constexpr double lower = std::numeric_limits<int32_t>::min(), upper = std::numeric_limits<int32_t>::max();
+    if (x0 < lower || y0 < lower || x1 > upper || y1 > upper) return false;
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > max_cells) return false;
+    min_x = static_cast<int32_t>(x0);
+    min_y = static_cast<int32_t>(y0);
+    max_x = static_cast<int32_t>(x1);
+    max_y = static_cast<int32_t>(y1);
+    return true;
+}
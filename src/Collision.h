@@ -0,0 +1,361 @@
+#pragma once
+#ifndef EASYENGINE_COLLISION_H
+#define EASYENGINE_COLLISION_H
+/**
+ * @file Collision.h
+ * @brief 碰撞世界
+ *
+ * 通过宽阶段（均匀空间哈希或动态 AABB 树）筛选可能碰撞的碰撞器，
+ * 避免对 N 个碰撞器进行 O(N²) 的两两检测。
+ *
+ * @copyright Copyright © 2025 CatIsNotFound
+ * @author CatIsNotFound
+ */
+#include "Components.h"
+
+namespace EasyEngine {
+    namespace Components {
+        /**
+         * @class CollisionWorld
+         * @brief 碰撞世界
+         *
+         * 管理一组碰撞器，每次调用 `step()` 时找出所有接触的碰撞器对，
+         * 并与上一次比较得出开始接触、持续接触及结束接触三种状态。
+         *
+         * 碰撞器移动（`moveBounds()`、`Entity::setPosition()` 等）时会自动通知碰撞世界，
+         * 仅移动过的碰撞器需要重新检测，未移动的碰撞器对直接沿用上一次的结果。
+         * @code
+         * CollisionWorld world(CollisionWorld::SpatialHash, 32.0f);
+         * world.append(&player);
+         * auto bullet = world.create(100, 100, 8, 8, 2);
+         * world.installContactEvent([](const CollisionWorld::Contact& contact, CollisionWorld::ContactState state) {
+         *     if (state == CollisionWorld::Begin) { ... }
+         * });
+         * engine.installUpdateEvent([&](float dt) {
+         *     bullet->moveBounds(...);
+         *     world.step();
+         * });
+         * @endcode
+         * @since v1.1.0-alpha
+         */
+        class CollisionWorld {
+        public:
+            /**
+             * @enum BroadPhase
+             * @brief 宽阶段算法
+             */
+            enum BroadPhase : uint8_t {
+                /// 均匀空间哈希，适用于大小相近、分布均匀的碰撞器（如弹幕）
+                SpatialHash,
+                /// 动态 AABB 树，适用于大小差异较大或分布稀疏的碰撞器
+                AABBTree
+            };
+            /**
+             * @enum ContactState
+             * @brief 接触状态
+             */
+            enum ContactState : uint8_t {
+                /// 本次开始接触
+                Begin,
+                /// 持续接触
+                Stay,
+                /// 本次结束接触
+                End
+            };
+            /**
+             * @struct Contact
+             * @brief 接触的碰撞器对
+             */
+            struct Contact {
+                Collider* first;
+                Collider* second;
+                /// 通过 `append(Entity*)` 加入时对应的实体，否则为 `nullptr`
+                Entity* first_entity;
+                Entity* second_entity;
+            };
+
+            /**
+             * @struct SweepHit
+             * @brief 实体在本次位移中首次碰撞的结果
+             * @see sweepEntities
+             */
+            struct SweepHit {
+                /// 移动的实体
+                Entity* entity;
+                /// 首次接触的碰撞器
+                Collider* target;
+                /// 首次接触的碰撞器所属的实体，否则为 `nullptr`
+                Entity* target_entity;
+                Collider::Impact impact;
+                /// 本次位移的起点
+                Vector2 from;
+                /// 本次位移的终点
+                Vector2 to;
+            };
+            /**
+             * @struct RayHit
+             * @brief 线段与碰撞器的相交结果
+             * @see raycast
+             */
+            struct RayHit {
+                Collider* collider;
+                /// 通过 `append(Entity*)` 加入时对应的实体，否则为 `nullptr`
+                Entity* entity;
+                Collider::Impact impact;
+            };
+
+            /**
+             * @brief 创建碰撞世界
+             * @param broad_phase 宽阶段算法
+             * @param cell_size   空间哈希的单元格大小（建议略大于常见碰撞器的尺寸）
+             */
+            explicit CollisionWorld(BroadPhase broad_phase = AABBTree, float cell_size = 64.0f);
+            CollisionWorld(const CollisionWorld&) = delete;
+            CollisionWorld& operator=(const CollisionWorld&) = delete;
+            ~CollisionWorld();
+            /**
+             * @brief 创建由碰撞世界管理的碰撞器
+             * @param x          所在位置 x 轴
+             * @param y          所在位置 y 轴
+             * @param width      碰撞器的宽度
+             * @param height     碰撞器的高度
+             * @param shape_mode 碰撞器形状（1 = 矩形，2 = 椭圆，3 = 圆点）
+             * @return 返回已启用的碰撞器，其生命周期由碰撞世界管理
+             */
+            Collider* create(float x, float y, float width, float height, uint8_t shape_mode);
+            /**
+             * @brief 复制碰撞器并交由碰撞世界管理
+             * @param collider 指定碰撞器
+             */
+            Collider* create(const Collider& collider);
+            /**
+             * @brief 加入外部的碰撞器
+             * @param collider 指定碰撞器（不会转移所有权）
+             * @return 返回是否加入成功
+             * @note 碰撞器销毁时会自动从碰撞世界中移除；同一碰撞器同时只能加入一个碰撞世界
+             */
+            bool append(Collider* collider);
+            /**
+             * @brief 加入实体的碰撞器
+             * @param entity 指定实体
+             * @see Contact::first_entity
+             */
+            bool append(Entity* entity);
+            /**
+             * @brief 移除碰撞器
+             * @param collider 指定碰撞器，若由 `create()` 创建则同时销毁
+             * @note 与其相关的接触将被直接丢弃，不会产生结束接触
+             */
+            bool remove(Collider* collider);
+            /**
+             * @brief 移除实体的碰撞器
+             * @param entity 指定实体
+             */
+            bool remove(Entity* entity);
+            /**
+             * @brief 移除所有碰撞器
+             */
+            void clear();
+            /**
+             * @brief 获取碰撞器数量
+             */
+            size_t count() const;
+            /**
+             * @brief 切换宽阶段算法（将重建加速结构）
+             * @param broad_phase 宽阶段算法
+             */
+            void setBroadPhase(BroadPhase broad_phase);
+            /**
+             * @brief 获取宽阶段算法
+             */
+            BroadPhase broadPhase() const;
+            /**
+             * @brief 设置空间哈希的单元格大小（将重建加速结构）
+             * @param size 单元格大小
+             * @note 覆盖单元格过多的碰撞器不会写入单元格，而是单独存放并在每次查询时逐个检测
+             */
+            void setCellSize(float size);
+            /**
+             * @brief 获取空间哈希的单元格大小
+             */
+            float cellSize() const;
+            /**
+             * @brief 设置 AABB 树中包围盒的扩展边距
+             * @param margin 边距
+             *
+             * 碰撞器在扩展后的包围盒内移动时无需更新树，边距越大更新越少，但筛选出的候选对越多。
+             */
+            void setTreeMargin(float margin);
+            /**
+             * @brief 获取 AABB 树中包围盒的扩展边距
+             */
+            float treeMargin() const;
+            /**
+             * @brief 更新加速结构并检测所有接触
+             *
+             * 检测完成后可通过 `beginContacts()`、`stayContacts()`、`endContacts()` 获取结果，
+             * 并依次调用 `installContactEvent()` 设置的函数。
+             */
+            void step();
+            /**
+             * @brief 获取本次开始接触的碰撞器对
+             */
+            const std::vector<Contact>& beginContacts() const;
+            /**
+             * @brief 获取持续接触的碰撞器对
+             */
+            const std::vector<Contact>& stayContacts() const;
+            /**
+             * @brief 获取本次结束接触的碰撞器对
+             */
+            const std::vector<Contact>& endContacts() const;
+            /**
+             * @brief 设置接触事件
+             * @param function 每次 `step()` 时，对每个接触的碰撞器对调用
+             * @warning 不要在事件中加入或移除碰撞器
+             */
+            void installContactEvent(const std::function<void(const Contact&, ContactState)>& function);
+            /**
+             * @brief 查找包围盒与指定区域相交的所有已启用的碰撞器
+             * @param area 指定区域
+             */
+            std::vector<Collider*> query(const GeometryF& area);
+            /**
+             * @brief 查找与线段相交的所有已启用的碰撞器
+             * @param origin 线段起点
+             * @param delta  线段的位移（终点 = 起点 + 位移）
+             * @return 返回按相交时刻从近到远排列的结果
+             * @see Collider::raycast
+             * @since v1.1.0-alpha
+             */
+            std::vector<RayHit> raycast(const Vector2& origin, const Vector2& delta);
+            /**
+             * @brief 查找距离指定点最近的若干个已启用的碰撞器
+             * @param point 指定点
+             * @param count 最多返回的数量
+             * @return 返回按包围盒距离从近到远排列的碰撞器（点位于包围盒内时距离为 0）
+             *
+             * 以指定点为中心逐步扩大查找范围，直到找到足够数量的碰撞器。
+             * @note 指定点的坐标为 NaN 或无穷大时返回空的结果
+             * @since v1.1.0-alpha
+             */
+            std::vector<Collider*> nearest(const Vector2& point, size_t count);
+            /**
+             * @brief 对通过 `append(Entity*)` 加入的实体进行连续碰撞检测
+             * @return 返回本次发生位移且中途发生碰撞的实体，以及各自最早的一次接触
+             *
+             * 位移取自 `Entity::previousPosition()` 与 `Entity::position()`，
+             * 目标同为实体时按两者的相对位移计算，因此较粗的固定时间步长下高速物体也不会穿过碰撞器。
+             * 候选对通过宽阶段筛选，仅对扫掠范围内的碰撞器进行检测。
+             * 检测结束后会清除所有实体的位移（见 `Entity::resetMotion()`），静止的实体不会被再次扫掠。
+             * @code
+             * engine.installUpdateEvent([&](float dt) {
+             *     bullet.setPosition(bullet.position() + velocity * dt);
+             *     for (auto& hit : world.sweepEntities()) {
+             *         // 退回到首次接触的位置，这一修正不应被视为下一次的位移
+             *         hit.entity->setPosition(hit.from + (hit.to - hit.from) * hit.impact.time);
+             *         hit.entity->resetMotion();
+             *     }
+             * });
+             * @endcode
+             * @note 返回的结果在下次调用前有效
+             * @see Collider::sweep
+             * @since v1.1.0-alpha
+             */
+            const std::vector<SweepHit>& sweepEntities();
+            /**
+             * @brief 标记碰撞器已变化
+             * @note 由碰撞器自动调用
+             */
+            void _markMoved(uint32_t proxy);
+
+        private:
+            struct Box {
+                float min_x, min_y, max_x, max_y;
+                bool overlaps(const Box& other) const {
+                    return min_x <= other.max_x && max_x >= other.min_x &&
+                           min_y <= other.max_y && max_y >= other.min_y;
+                }
+                float distanceSquared(float x, float y) const {
+                    const float dx = std::max({min_x - x, 0.0f, x - max_x});
+                    const float dy = std::max({min_y - y, 0.0f, y - max_y});
+                    return dx * dx + dy * dy;
+                }
+                bool contains(const Box& other) const {
+                    return min_x <= other.min_x && min_y <= other.min_y &&
+                           max_x >= other.max_x && max_y >= other.max_y;
+                }
+                bool isFinite() const {
+                    return std::isfinite(min_x) && std::isfinite(min_y) &&
+                           std::isfinite(max_x) && std::isfinite(max_y);
+                }
+            };
+            struct Proxy {
+                Collider* collider{nullptr};
+                Entity* entity{nullptr};
+                std::unique_ptr<Collider> owned;
+                Box box{};
+                /// 需要更新加速结构
+                bool dirty{false};
+                /// 本次需要重新检测接触
+                bool moved{false};
+                int32_t node{-1};
+                int32_t cell_min_x{0}, cell_min_y{0}, cell_max_x{-1}, cell_max_y{-1};
+                /// 位于大型碰撞器列表中
+                bool large{false};
+                uint32_t stamp{0};
+            };
+            struct TreeNode {
+                Box box{};
+                int32_t parent{-1};
+                int32_t child1{-1};
+                int32_t child2{-1};
+                int32_t height{0};
+                uint32_t proxy{0};
+                bool isLeaf() const { return child1 == -1; }
+            };
+            uint32_t addProxy(Collider* collider, Entity* entity, std::unique_ptr<Collider> owned);
+            void removeProxy(uint32_t id);
+            void updateProxies();
+            void insertBroadPhase(uint32_t id);
+            void removeBroadPhase(uint32_t id);
+            void rebuild();
+            template<class Function>
+            void queryBox(const Box& box, Function&& function);
+            Contact makeContact(uint64_t key) const;
+            /// 动态 AABB 树
+            int32_t allocateNode();
+            void freeNode(int32_t node);
+            void insertLeaf(int32_t leaf);
+            void removeLeaf(int32_t leaf);
+            int32_t balance(int32_t node);
+            /// 空间哈希
+            static int64_t cellKey(int32_t x, int32_t y);
+            bool cellRange(const Box& box, double max_cells,
+                           int32_t& min_x, int32_t& min_y, int32_t& max_x, int32_t& max_y) const;
+            BroadPhase _broad_phase;
+            float _cell_size;
+            float _tree_margin{4.0f};
+            std::vector<Proxy> _proxies;
+            std::vector<uint32_t> _free_proxies;
+            std::vector<uint32_t> _moved_list;
+            size_t _count{0};
+            uint32_t _stamp{0};
+            std::vector<TreeNode> _nodes;
+            int32_t _root{-1};
+            int32_t _free_node{-1};
+            std::vector<int32_t> _stack;
+            std::unordered_map<int64_t, std::vector<uint32_t>> _cells;
+            std::vector<uint32_t> _large_proxies;
+            std::vector<uint64_t> _contacts;
+            std::vector<uint64_t> _next_contacts;
+            std::vector<Contact> _begin_contacts;
+            std::vector<Contact> _stay_contacts;
+            std::vector<Contact> _end_contacts;
+            std::function<void(const Contact&, ContactState)> _contact_event;
+            std::vector<SweepHit> _sweep_hits;
+        };
+    }
+}
+
+#endif //EASYENGINE_COLLISION_H
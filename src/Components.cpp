@@ -3,6 +3,8 @@
 
 #include <memory>
 
+std::unordered_set<const EasyEngine::Components::Sprite*> EasyEngine::Components::Sprite::_live_sprites;
+
 EasyEngine::Components::BGM::BGM() {}
 
 EasyEngine::Components::BGM::~BGM() {}
@@ -192,9 +194,14 @@ uint64_t EasyEngine::Components::Timer::delay() const {
 }
 
 uint64_t EasyEngine::Components::Timer::_currentTimeMs() {
-    return std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()
-    ).count();
+    // 录制或回放时使用按帧锁定的虚拟时钟
+    return Replay::global()->timeMillisec();
+}
+
+uint64_t EasyEngine::Components::Timer::remaining() const {
+    if (!_enabled || !_timer_function) return UINT64_MAX;
+    uint64_t elapsed = _currentTimeMs() - _start_time;
+    return elapsed >= _delay ? 0 : _delay - elapsed;
 }
 
 void EasyEngine::Components::Timer::______() {
@@ -271,44 +278,74 @@ std::function<void()> &EasyEngine::Components::Trigger::event() {
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, Painter *painter)
     : _name(name), _painter(painter), _size(0, 0) {
+    _live_sprites.insert(this);
     _surface = SDL_CreateSurface(0, 0, SDL_PIXELFORMAT_RGBA64);
-    _texture = SDL_CreateTextureFromSurface(painter->window()->renderer, _surface);
+    _texture = painter->_createTexture(_surface);
     _properties = std::make_unique<Properties>();
 }
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, SSurface *surface, Painter *painter)
     : _name(name), _painter(painter) {
+    _live_sprites.insert(this);
     _surface = surface;
-    _texture = SDL_CreateTextureFromSurface(painter->window()->renderer, _surface);
+    _texture = painter->_createTexture(_surface);
     SDL_GetTextureSize(_texture, &_size.width, &_size.height);
     _properties = std::make_unique<Properties>();
 }
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, const std::string &resource_name, Painter *painter)
     : _name(name), _painter(painter) {
+    _live_sprites.insert(this);
     _path = ResourceSystem::global()->resourcePath(resource_name);
-    if (ResourceSystem::global()->resourceType(resource_name) == Resource::Image) {
-        _surface = IMG_Load(_path.c_str());
+    {
+        auto lock = painter->lockRenderer();
+        _shared_texture = ResourceSystem::global()->sharedTexture(resource_name, painter->window()->renderer);
+    }
+    if (_shared_texture) {
+        _surface = _shared_texture->surface;
+        _texture = _shared_texture->texture;
     } else {
-        SDL_Log("[ERROR] Resource '%s' is not the image file!", resource_name.c_str());
         _surface = SDL_CreateSurface(0, 0, SDL_PIXELFORMAT_RGBA64);
+        _texture = painter->_createTexture(_surface);
     }
-    _texture = SDL_CreateTextureFromSurface(painter->window()->renderer, _surface);
     SDL_GetTextureSize(_texture, &_size.width, &_size.height);
     _properties = std::make_unique<Properties>();
 }
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, const EasyEngine::Components::Sprite &sprite)
     : _name(name), _painter(sprite._painter), _size(sprite._size), _path(sprite._path) {
-    _surface = SDL_DuplicateSurface(sprite._surface);
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    _live_sprites.insert(this);
     _properties = std::make_unique<Properties>();
+    if (sprite._atlas) {
+        _atlas = sprite._atlas;
+        _atlas_region = sprite._atlas_region;
+        _texture = sprite._texture;
+        return;
+    }
+    if (sprite._shared_texture) {
+        _shared_texture = sprite._shared_texture;
+        _surface = _shared_texture->surface;
+        _texture = _shared_texture->texture;
+        return;
+    }
+    _surface = sprite.duplicateSurface();
+    _texture = _painter->_createTexture(_surface);
+    applyResidency();
 }
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, const EasyEngine::Components::Sprite &sprite,
                                        const EasyEngine::Vector2 &clip_pos, const EasyEngine::Size &clip_size)
-    : _name(name), _painter(sprite._painter), _size(sprite._size) {
-    _surface = SDL_DuplicateSurface(sprite._surface);
+    : _name(name), _painter(sprite._painter), _size(sprite._size), _path(sprite._path) {
+    _live_sprites.insert(this);
+    if (sprite._atlas) {
+        _atlas = sprite._atlas;
+        _atlas_region.reset(sprite._atlas_region.pos + clip_pos, clip_size);
+        _texture = sprite._texture;
+        _size = clip_size;
+        _properties = std::make_unique<Properties>();
+        return;
+    }
+    _surface = sprite.duplicateSurface();
     auto _rect = SDL_Rect(
             static_cast<int>(clip_pos.x),
             static_cast<int>(clip_pos.y),
@@ -316,16 +353,19 @@ EasyEngine::Components::Sprite::Sprite(const std::string &name, const EasyEngine
             static_cast<int>(clip_size.height)
     );
     SDL_SetSurfaceClipRect(_surface, &_rect);
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    _texture = _painter->_createTexture(_surface);
     _properties = std::make_unique<Properties>();
+    applyResidency();
 }
 
 EasyEngine::Components::Sprite::Sprite(const std::string &name, const std::string &resource_name,
                                        const EasyEngine::Vector2 &clip_pos, const EasyEngine::Size &clip_size,
                                        Painter *painter)
     : _name(name), _painter(painter), _size(0, 0) {
+    _live_sprites.insert(this);
     if (ResourceSystem::global()->resourceType(resource_name) == Resource::Image) {
-        _surface = IMG_Load(ResourceSystem::global()->resourcePath(resource_name).c_str());
+        _path = ResourceSystem::global()->resourcePath(resource_name);
+        _surface = ResourceSystem::global()->decodeImage(_path);
     } else {
         SDL_Log("[ERROR] Resource '%s' is not the image file!", resource_name.c_str());
         _surface = SDL_CreateSurface(0, 0, SDL_PIXELFORMAT_RGBA64);
@@ -342,13 +382,64 @@ EasyEngine::Components::Sprite::Sprite(const std::string &name, const std::strin
     );
     SDL_SetSurfaceClipRect(_surface, &_rect);
     _size.reset((float)_surface->w, (float)_surface->h);
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    _texture = _painter->_createTexture(_surface);
     _properties = std::make_unique<Properties>();
+    applyResidency();
+}
+
+EasyEngine::Components::Sprite::Sprite(const std::string &name, EasyEngine::Components::TextureAtlas *atlas,
+                                       const std::string &resource_name)
+    : _name(name), _painter(atlas ? atlas->painter() : nullptr), _size(0, 0) {
+    _live_sprites.insert(this);
+    _properties = std::make_unique<Properties>();
+    if (!atlas) {
+        SDL_Log("[ERROR] The specified texture atlas is not valid!");
+        return;
+    }
+    auto region = atlas->region(resource_name);
+    if (!region) return;
+    _atlas = atlas;
+    _atlas_region = region->geometry;
+    _texture = atlas->page(region->page);
+    _size = region->geometry.size;
+    _path = ResourceSystem::global()->resourcePath(resource_name);
 }
 
 EasyEngine::Components::Sprite::~Sprite() {
-    if (_texture) SDL_DestroyTexture(_texture);
-    if (_surface) SDL_DestroySurface(_surface);
+    releaseTexture();
+    _live_sprites.erase(this);
+}
+
+void EasyEngine::Components::Sprite::releaseTexture() {
+    if (_shared_texture) {
+        // 共享纹理由最后一个持有者负责释放，须等到渲染线程不再使用后
+        Painter::_deferRelease(_painter, [shared = std::move(_shared_texture)] {});
+        _shared_texture.reset();
+    } else {
+        if (_texture && !_atlas) {
+            Painter::_deferRelease(_painter, [texture = _texture] { SDL_DestroyTexture(texture); });
+        }
+        if (_surface) SDL_DestroySurface(_surface);
+    }
+    _texture = nullptr;
+    _surface = nullptr;
+    _atlas = nullptr;
+    _alpha_mask.reset();
+}
+
+SSurface *EasyEngine::Components::Sprite::duplicateSurface() const {
+    auto surface = _shared_texture ? _shared_texture->surface : _surface;
+    if (surface) return SDL_DuplicateSurface(surface);
+    // 表面已在仅 GPU 驻留模式下释放，从资源路径重新解码
+    if (!_path.empty()) return ResourceSystem::global()->decodeImage(_path);
+    return nullptr;
+}
+
+void EasyEngine::Components::Sprite::applyResidency() {
+    if (!ResourceSystem::global()->isGPUOnlyMode()) return;
+    if (!_surface || !_texture || _shared_texture || _atlas || _path.empty()) return;
+    SDL_DestroySurface(_surface);
+    _surface = nullptr;
 }
 
 void EasyEngine::Components::Sprite::copySprite(EasyEngine::Components::Sprite *sprite) {
@@ -356,11 +447,26 @@ void EasyEngine::Components::Sprite::copySprite(EasyEngine::Components::Sprite *
         SDL_Log("[ERROR] The specified sprite is not valid!");
         return;
     }
-    if (_texture) SDL_DestroyTexture(_texture);
-    if (_surface) SDL_DestroySurface(_surface);
-    _surface = SDL_DuplicateSurface(sprite->_surface);
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    releaseTexture();
+    if (sprite->_atlas) {
+        _atlas = sprite->_atlas;
+        _atlas_region = sprite->_atlas_region;
+        _texture = sprite->_texture;
+        _size = sprite->_size;
+        return;
+    }
+    if (sprite->_shared_texture) {
+        _shared_texture = sprite->_shared_texture;
+        _surface = _shared_texture->surface;
+        _texture = _shared_texture->texture;
+        _size = sprite->_size;
+        return;
+    }
+    _path = sprite->_path;
+    _surface = sprite->duplicateSurface();
+    _texture = _painter->_createTexture(_surface);
     SDL_GetTextureSize(_texture, &_size.width, &_size.height);
+    applyResidency();
 }
 
 void EasyEngine::Components::Sprite::setName(const std::string &new_name) {
@@ -378,14 +484,17 @@ bool EasyEngine::Components::Sprite::setResource(const std::string &resource_nam
         SDL_Log("[ERROR] Resource '%s' is not the image path!", resource_name.c_str());
         return false;
     }
-    if (_texture) SDL_DestroyTexture(_texture);
-    if (_surface) SDL_DestroySurface(_surface);
-    _surface = IMG_Load(_path.data());
-    if (!_surface) {
+    releaseTexture();
+    {
+        auto lock = _painter->lockRenderer();
+        _shared_texture = ResourceSystem::global()->sharedTexture(resource_name, _painter->window()->renderer);
+    }
+    if (!_shared_texture) {
         SDL_Log("[ERROR] Can't load image file: %s", _path.data());
         return false;
     }
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    _surface = _shared_texture->surface;
+    _texture = _shared_texture->texture;
     return true;
 }
 
@@ -397,10 +506,10 @@ void EasyEngine::Components::Sprite::setSurface(SSurface *surface) {
     if (!surface) {
         return;
     }
-    if (_texture) SDL_DestroyTexture(_texture);
-    if (_surface) SDL_DestroySurface(_surface);
+    releaseTexture();
+    _path.clear();
     _surface = surface;
-    _texture = SDL_CreateTextureFromSurface(_painter->window()->renderer, _surface);
+    _texture = _painter->_createTexture(_surface);
     if (!_texture) {
         return;
     }
@@ -409,7 +518,7 @@ void EasyEngine::Components::Sprite::setSurface(SSurface *surface) {
 
 bool EasyEngine::Components::Sprite::isValid(const std::string &path) const {
     if (!_painter) return false;
-    if (!_surface) return false;
+    if (!_surface && !_atlas && !_shared_texture) return false;
     if (!_texture) return false;
     return true;
 }
@@ -431,7 +540,16 @@ EasyEngine::Size EasyEngine::Components::Sprite::size() const {
 }
 
 STexture *EasyEngine::Components::Sprite::sprite() const {
-    return _texture;
+    // 共享纹理可能在渲染设备重置后被重新创建，始终从共享句柄中读取
+    return _shared_texture ? _shared_texture->texture : _texture;
+}
+
+EasyEngine::Components::TextureAtlas *EasyEngine::Components::Sprite::atlas() const {
+    return _atlas;
+}
+
+const EasyEngine::GeometryF &EasyEngine::Components::Sprite::atlasRegion() const {
+    return _atlas_region;
 }
 
 void EasyEngine::Components::Sprite::draw(const Vector2 &pos) const {
@@ -488,6 +606,302 @@ void EasyEngine::Components::Sprite::draw(EasyEngine::Painter *painter) const {
         _painter->drawSprite(*this, _properties.get());
 }
 
+EasyEngine::MemoryUsage EasyEngine::Components::Sprite::memoryUsage() const {
+    MemoryUsage usage;
+    if (_atlas) {
+        if (_texture) {
+            usage.gpu_bytes = static_cast<uint64_t>(_atlas_region.size.width * _atlas_region.size.height) *
+                              SDL_BYTESPERPIXEL(_texture->format);
+        }
+        return usage;
+    }
+    if (_shared_texture) {
+        usage.cpu_bytes = ResourceSystem::surfaceBytes(_shared_texture->surface);
+        usage.gpu_bytes = ResourceSystem::textureBytes(_shared_texture->texture);
+        return usage;
+    }
+    usage.cpu_bytes = ResourceSystem::surfaceBytes(_surface);
+    usage.gpu_bytes = ResourceSystem::textureBytes(_texture);
+    return usage;
+}
+
+std::shared_ptr<const EasyEngine::AlphaMask> EasyEngine::Components::Sprite::alphaMask(uint8_t threshold) const {
+    if (_shared_texture) return ResourceSystem::global()->alphaMask(_shared_texture->resource_name, threshold);
+    if (_atlas) {
+        SDL_Log("[ERROR] Sprite '%s' comes from the texture atlas, the alpha mask is not supported!", _name.c_str());
+        return nullptr;
+    }
+    if (_alpha_mask && _alpha_threshold == threshold) return _alpha_mask;
+    if (_surface) {
+        _alpha_mask = Algorithm::createAlphaMask(_surface, threshold);
+    } else {
+        // 表面已在仅 GPU 驻留模式下释放，临时从资源路径重新解码
+        auto surface = duplicateSurface();
+        _alpha_mask = Algorithm::createAlphaMask(surface, threshold);
+        if (surface) SDL_DestroySurface(surface);
+    }
+    _alpha_threshold = threshold;
+    return _alpha_mask;
+}
+
+void EasyEngine::Components::Sprite::_collectMemoryUsage(std::map<const void *, uint64_t> &cpu,
+                                                         std::map<const void *, uint64_t> &gpu) {
+    for (auto sprite : _live_sprites) {
+        // 图集精灵的纹理即图集页面，按完整页面计算一次
+        auto surface = sprite->_shared_texture ? sprite->_shared_texture->surface : sprite->_surface;
+        auto texture = sprite->sprite();
+        if (surface) cpu[surface] = ResourceSystem::surfaceBytes(surface);
+        if (texture) gpu[texture] = ResourceSystem::textureBytes(texture);
+    }
+}
+
+EasyEngine::Components::TextureAtlas::TextureAtlas(const std::string &name, Painter *painter, uint32_t page_width,
+                                                   uint32_t page_height, uint32_t padding)
+    : _name(name), _painter(painter), _page_width(page_width), _page_height(page_height), _padding(padding) {}
+
+EasyEngine::Components::TextureAtlas::~TextureAtlas() {
+    clear();
+}
+
+const std::string &EasyEngine::Components::TextureAtlas::name() const {
+    return _name;
+}
+
+EasyEngine::Painter *EasyEngine::Components::TextureAtlas::painter() const {
+    return _painter;
+}
+
+bool EasyEngine::Components::TextureAtlas::append(const std::string &resource_name) {
+    if (_is_built) {
+        SDL_Log("[ERROR] Texture atlas '%s' is already built! Did you mean to use `clear()` first?", _name.c_str());
+        return false;
+    }
+    if (ResourceSystem::global()->resourceType(resource_name) != Resource::Image) {
+        SDL_Log("[ERROR] Resource '%s' is not the image file!", resource_name.c_str());
+        return false;
+    }
+    if (std::find(_pending.begin(), _pending.end(), resource_name) != _pending.end()) {
+        SDL_Log("[ERROR] Resource '%s' is already appended to texture atlas '%s'!",
+                resource_name.c_str(), _name.c_str());
+        return false;
+    }
+    _pending.emplace_back(resource_name);
+    return true;
+}
+
+uint64_t EasyEngine::Components::TextureAtlas::append(const std::vector<std::string> &resource_names) {
+    uint64_t err = 0;
+    for (auto& name : resource_names) err += (!append(name));
+    return err;
+}
+
+bool EasyEngine::Components::TextureAtlas::build() {
+    if (_is_built) {
+        SDL_Log("[ERROR] Texture atlas '%s' is already built!", _name.c_str());
+        return false;
+    }
+    if (!_painter || !_painter->window()) {
+        SDL_Log("[ERROR] The painter of texture atlas '%s' is not valid!", _name.c_str());
+        return false;
+    }
+    struct Item {
+        std::string name;
+        SSurface* surface;
+        bool is_owned;
+        uint32_t page;
+        int x, y;
+    };
+    std::vector<Item> items;
+    items.reserve(_pending.size());
+    bool is_ok = true;
+    auto res = ResourceSystem::global();
+    for (auto& name : _pending) {
+        SSurface* surface = nullptr;
+        bool is_owned = false;
+        if (res->isLoaded(name)) {
+            surface = std::get<SSurface*>(res->metaData(name));
+        } else {
+            surface = res->decodeImage(res->resourcePath(name));
+            is_owned = true;
+        }
+        if (!surface) {
+            SDL_Log("[ERROR] Can't load resource '%s' for texture atlas '%s'!", name.c_str(), _name.c_str());
+            is_ok = false;
+            continue;
+        }
+        items.push_back({name, surface, is_owned, 0, 0, 0});
+    }
+    // 按高度（其次宽度）降序排列，可获得更紧凑的天际线
+    std::vector<size_t> order(items.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&items](size_t a, size_t b) {
+        if (items[a].surface->h != items[b].surface->h) return items[a].surface->h > items[b].surface->h;
+        return items[a].surface->w > items[b].surface->w;
+    });
+
+    const int page_w = static_cast<int>(_page_width), page_h = static_cast<int>(_page_height);
+    std::vector<std::vector<SkylineNode>> skylines;
+    std::vector<int> used_heights;
+    std::vector<bool> is_placed(items.size(), false);
+    for (auto idx : order) {
+        auto& item = items[idx];
+        const int w = item.surface->w + static_cast<int>(_padding),
+                  h = item.surface->h + static_cast<int>(_padding);
+        if (w > page_w || h > page_h) {
+            SDL_Log("[ERROR] Resource '%s' (%dx%d) is larger than the page of texture atlas '%s' (%ux%u)!",
+                    item.name.c_str(), item.surface->w, item.surface->h, _name.c_str(), _page_width, _page_height);
+            is_ok = false;
+            continue;
+        }
+        bool placed = false;
+        for (uint32_t p = 0; p <= skylines.size() && !placed; ++p) {
+            if (p == skylines.size()) {
+                skylines.push_back({{0, 0, page_w}});
+                used_heights.push_back(0);
+            }
+            auto& skyline = skylines[p];
+            int best_y = INT32_MAX, best_width = INT32_MAX;
+            size_t best_index = SIZE_MAX;
+            for (size_t i = 0; i < skyline.size(); ++i) {
+                int y = skylineFit(skyline, i, w, h, page_w, page_h);
+                if (y < 0) continue;
+                if (y + h < best_y || (y + h == best_y && skyline[i].width < best_width)) {
+                    best_y = y + h;
+                    best_width = skyline[i].width;
+                    best_index = i;
+                }
+            }
+            if (best_index == SIZE_MAX) continue;
+            item.page = p;
+            item.x = skyline[best_index].x;
+            item.y = best_y - h;
+            skylinePlace(skyline, best_index, item.x, item.y, w, h);
+            used_heights[p] = std::max(used_heights[p], best_y);
+            placed = true;
+        }
+        is_placed[idx] = placed;
+    }
+
+    for (size_t p = 0; p < skylines.size(); ++p) {
+        SSurface* page = SDL_CreateSurface(page_w, std::max(used_heights[p], 1), SDL_PIXELFORMAT_RGBA32);
+        if (!page) {
+            SDL_Log("[ERROR] Failed to create page %zu for texture atlas '%s'!\nException: %s",
+                    p, _name.c_str(), SDL_GetError());
+            is_ok = false;
+            _pages.push_back(nullptr);
+            continue;
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            auto& item = items[i];
+            if (!is_placed[i] || item.page != p) continue;
+            // 直接复制像素（包含透明通道），而不是与空白页混合
+            SDL_BlendMode old_mode = SDL_BLENDMODE_BLEND;
+            SDL_GetSurfaceBlendMode(item.surface, &old_mode);
+            SDL_SetSurfaceBlendMode(item.surface, SDL_BLENDMODE_NONE);
+            SDL_Rect dst = {item.x, item.y, item.surface->w, item.surface->h};
+            SDL_BlitSurface(item.surface, nullptr, page, &dst);
+            SDL_SetSurfaceBlendMode(item.surface, old_mode);
+            _regions.emplace(item.name, Region{static_cast<uint32_t>(p),
+                             {{(float)item.x, (float)item.y}, {(float)item.surface->w, (float)item.surface->h}}});
+        }
+        auto texture = _painter->_createTexture(page);
+        SDL_DestroySurface(page);
+        if (!texture) {
+            SDL_Log("[ERROR] Failed to upload page %zu of texture atlas '%s'!\nException: %s",
+                    p, _name.c_str(), SDL_GetError());
+            is_ok = false;
+            // 丢弃该页面上的区域，避免精灵引用空纹理
+            std::erase_if(_regions, [p](const auto& region) { return region.second.page == p; });
+        }
+        _pages.push_back(texture);
+    }
+    for (auto& item : items) {
+        if (item.is_owned) SDL_DestroySurface(item.surface);
+    }
+    _is_built = true;
+    SDL_Log("[INFO] Texture atlas '%s' is built! Packed %zu resources into %zu page(s).",
+            _name.c_str(), _regions.size(), _pages.size());
+    return is_ok;
+}
+
+bool EasyEngine::Components::TextureAtlas::isBuilt() const {
+    return _is_built;
+}
+
+void EasyEngine::Components::TextureAtlas::clear() {
+    Painter::_deferRelease(_painter, [pages = std::move(_pages)] {
+        for (auto& page : pages) {
+            if (page) SDL_DestroyTexture(page);
+        }
+    });
+    _pages.clear();
+    _regions.clear();
+    _pending.clear();
+    _is_built = false;
+}
+
+bool EasyEngine::Components::TextureAtlas::contains(const std::string &resource_name) const {
+    return _regions.contains(resource_name);
+}
+
+const EasyEngine::Components::TextureAtlas::Region *
+EasyEngine::Components::TextureAtlas::region(const std::string &resource_name) const {
+    if (!_regions.contains(resource_name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found in texture atlas '%s'!", resource_name.c_str(), _name.c_str());
+        return nullptr;
+    }
+    return &_regions.at(resource_name);
+}
+
+size_t EasyEngine::Components::TextureAtlas::pageCount() const {
+    return _pages.size();
+}
+
+STexture *EasyEngine::Components::TextureAtlas::page(size_t index) const {
+    if (index >= _pages.size()) {
+        SDL_Log("[ERROR] The specified page %zu is out of range!", index);
+        return nullptr;
+    }
+    return _pages[index];
+}
+
+int EasyEngine::Components::TextureAtlas::skylineFit(const std::vector<SkylineNode> &skyline, size_t index,
+                                                     int width, int height, int page_width, int page_height) {
+    if (skyline[index].x + width > page_width) return -1;
+    int y = skyline[index].y, width_left = width;
+    for (size_t i = index; width_left > 0; ++i) {
+        if (i >= skyline.size()) return -1;
+        y = std::max(y, skyline[i].y);
+        if (y + height > page_height) return -1;
+        width_left -= skyline[i].width;
+    }
+    return y;
+}
+
+void EasyEngine::Components::TextureAtlas::skylinePlace(std::vector<SkylineNode> &skyline, size_t index,
+                                                        int x, int y, int width, int height) {
+    skyline.insert(skyline.begin() + (int64_t)index, {x, y + height, width});
+    // 收缩或移除被新节点覆盖的节点
+    for (size_t i = index + 1; i < skyline.size();) {
+        const int right = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= right) break;
+        const int shrink = right - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if (skyline[i].width > 0) break;
+        skyline.erase(skyline.begin() + (int64_t)i);
+    }
+    // 合并相同高度的相邻节点
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + (int64_t)(i + 1));
+        } else {
+            ++i;
+        }
+    }
+}
+
 EasyEngine::Components::SpriteGroup::SpriteGroup(const std::string &name) : _name(name) {}
 
 EasyEngine::Components::SpriteGroup::SpriteGroup(const EasyEngine::Components::SpriteGroup &group)
@@ -647,6 +1061,25 @@ EasyEngine::Components::FrameAnimation::FrameAnimation(const std::string &name,
     }
 }
 
+EasyEngine::Components::FrameAnimation::FrameAnimation(const std::string &name,
+                                                       EasyEngine::Components::TextureAtlas *atlas,
+                                                       const std::vector<std::string> &resource_names,
+                                                       uint64_t duration_per_frame) : _name(name) {
+    if (!atlas) {
+        SDL_Log("[ERROR] The specified texture atlas is not valid!");
+        return;
+    }
+    for (auto& resource_name : resource_names) {
+        if (!atlas->contains(resource_name)) {
+            SDL_Log("[ERROR] Resource '%s' is not found in texture atlas '%s'!",
+                    resource_name.c_str(), atlas->name().c_str());
+            continue;
+        }
+        auto& sprite = _owned_sprites.emplace_back(std::make_shared<Sprite>(resource_name, atlas, resource_name));
+        _animations.push_back({sprite.get(), duration_per_frame});
+    }
+}
+
 EasyEngine::Components::FrameAnimation::~FrameAnimation() {
     if (_frame_changer) {
         EventSystem::global()->removeTimer(_frame_changer);
@@ -1075,6 +1508,11 @@ EasyEngine::Components::Collider::Collider(const EasyEngine::Graphics::Point &po
     _con.shape.point = point;
 }
 
+EasyEngine::Components::Collider::Collider(const EasyEngine::Vector2 &pos,
+                                           const std::shared_ptr<const EasyEngine::AlphaMask> &mask) : _enabled(false) {
+    setSelf(pos, mask);
+}
+
 EasyEngine::Components::Collider::Collider(float x, float y, float width, float height, uint8_t shape_mode) {
     _geometry.reset({x, y}, {width, height});
     _con.mode = shape_mode;
@@ -1089,6 +1527,23 @@ EasyEngine::Components::Collider::Collider(float x, float y, float width, float
     }
 }
 
+EasyEngine::Components::Collider::Collider(const EasyEngine::Components::Collider &collider)
+    : _con(collider._con), _enabled(collider._enabled), _geometry(collider._geometry) {}
+
+EasyEngine::Components::Collider &
+EasyEngine::Components::Collider::operator=(const EasyEngine::Components::Collider &collider) {
+    if (this == &collider) return *this;
+    _con = collider._con;
+    _enabled = collider._enabled;
+    _geometry = collider._geometry;
+    notifyWorld();
+    return *this;
+}
+
+EasyEngine::Components::Collider::~Collider() {
+    if (_world) _world->remove(this);
+}
+
 int8_t EasyEngine::Components::Collider::check(const EasyEngine::Components::Collider &collider) const {
     if (!_enabled) {
         SDL_Log("[WARNING] The current collider is not be enabled!");
@@ -1116,12 +1571,91 @@ int8_t EasyEngine::Components::Collider::check(const EasyEngine::Components::Col
         return Algorithm::comparePosEllipse(_con.shape.point.pos, collider._con.shape.ellipse);
     } else if (_con.mode == 2 && collider._con.mode == 3) {
         return Algorithm::comparePosEllipse(collider._con.shape.point.pos, _con.shape.ellipse);
+    } else if (_con.mode == 4 || collider._con.mode == 4) {
+        return checkMask(collider);
     } else {
         SDL_Log("[WARNING] The specified collider is not match by the current collider!");
         return 0;
     }
 }
 
+EasyEngine::Components::Collider::Impact
+EasyEngine::Components::Collider::sweep(const EasyEngine::Vector2 &displacement,
+                                        const EasyEngine::Components::Collider &collider,
+                                        const EasyEngine::Vector2 &target_displacement) const {
+    return sweepFrom({0, 0}, displacement, collider, {0, 0}, target_displacement);
+}
+
+EasyEngine::Components::Collider::Impact
+EasyEngine::Components::Collider::sweepFrom(const EasyEngine::Vector2 &offset, const EasyEngine::Vector2 &displacement,
+                                            const EasyEngine::Components::Collider &collider,
+                                            const EasyEngine::Vector2 &target_offset,
+                                            const EasyEngine::Vector2 &target_displacement) const {
+    Impact impact;
+    if (!_enabled || !collider._enabled || this == &collider) return impact;
+    const auto translated = [](const Container& con, const Vector2& offset) {
+        Container ret = con;
+        // 遮罩按其包围矩形计算
+        if (ret.mode == 4) ret.mode = 1;
+        if (ret.mode == 1) ret.shape.rectangle.pos += offset;
+        else if (ret.mode == 2) ret.shape.ellipse.pos += offset;
+        else if (ret.mode == 3) ret.shape.point.pos += offset;
+        return ret;
+    };
+    const Container self = translated(_con, offset), target = translated(collider._con, target_offset);
+    // 转换为相对运动：目标静止，此碰撞器按两者位移之差移动
+    const Vector2 delta = displacement - target_displacement, reversed = target_displacement - displacement;
+    Vector2 normal;
+    float time = -1;
+    if (self.mode == 1 && target.mode == 1) {
+        time = Algorithm::sweepRect(self.shape.rectangle, delta, target.shape.rectangle, &normal);
+    } else if (self.mode == 2 && target.mode == 2) {
+        time = Algorithm::sweepEllipse(self.shape.ellipse, delta, target.shape.ellipse, &normal);
+    } else if (self.mode == 2 && target.mode == 1) {
+        time = Algorithm::sweepEllipseRect(self.shape.ellipse, delta, target.shape.rectangle, &normal);
+    } else if (self.mode == 1 && target.mode == 2) {
+        time = Algorithm::sweepEllipseRect(target.shape.ellipse, reversed, self.shape.rectangle, &normal);
+        normal = normal * -1;
+    } else if (self.mode == 3 && target.mode == 1) {
+        time = Algorithm::raycastRect(self.shape.point.pos, delta, target.shape.rectangle, &normal);
+    } else if (self.mode == 3 && target.mode == 2) {
+        time = Algorithm::raycastEllipse(self.shape.point.pos, delta, target.shape.ellipse, &normal);
+    } else if (self.mode == 1 && target.mode == 3) {
+        time = Algorithm::raycastRect(target.shape.point.pos, reversed, self.shape.rectangle, &normal);
+        normal = normal * -1;
+    } else if (self.mode == 2 && target.mode == 3) {
+        time = Algorithm::raycastEllipse(target.shape.point.pos, reversed, self.shape.ellipse, &normal);
+        normal = normal * -1;
+    }
+    if (time < 0) return impact;
+    impact.collided = true;
+    impact.time = time;
+    impact.normal = normal;
+    if (self.mode == 1) impact.position = self.shape.rectangle.pos + displacement * time;
+    else if (self.mode == 2) impact.position = self.shape.ellipse.pos + displacement * time;
+    else impact.position = self.shape.point.pos + displacement * time;
+    return impact;
+}
+
+EasyEngine::Components::Collider::Impact
+EasyEngine::Components::Collider::raycast(const EasyEngine::Vector2 &origin, const EasyEngine::Vector2 &delta) const {
+    Impact impact;
+    if (!_enabled) return impact;
+    Vector2 normal;
+    float time = -1;
+    if (_con.mode == 1 || _con.mode == 4) {
+        time = Algorithm::raycastRect(origin, delta, _con.shape.rectangle, &normal);
+    } else if (_con.mode == 2) {
+        time = Algorithm::raycastEllipse(origin, delta, _con.shape.ellipse, &normal);
+    }
+    if (time < 0) return impact;
+    impact.collided = true;
+    impact.time = time;
+    impact.normal = normal;
+    impact.position = origin + delta * time;
+    return impact;
+}
+
 const EasyEngine::GeometryF& EasyEngine::Components::Collider::bounds() const {
     return _geometry;
 }
@@ -1136,7 +1670,11 @@ void EasyEngine::Components::Collider::setBoundsGeometry(float x, float y, float
         _con.shape.ellipse.area.reset(width, height);
     } else if (_con.mode == 3) {
         _con.shape.point.pos.reset(x, y);
+    } else if (_con.mode == 4) {
+        _con.shape.rectangle.pos.reset(x, y);
+        _geometry.size = _con.shape.rectangle.size;
     }
+    notifyWorld();
 }
 
 void EasyEngine::Components::Collider::setBoundsGeometry(const EasyEngine::Vector2 &position,
@@ -1155,13 +1693,14 @@ void EasyEngine::Components::Collider::moveBounds(const EasyEngine::Vector2 &pos
 void EasyEngine::Components::Collider::moveBounds(float x, float y) {
     _geometry.pos.x = x;
     _geometry.pos.y = y;
-    if (_con.mode == 1) {
+    if (_con.mode == 1 || _con.mode == 4) {
         _con.shape.rectangle.pos.reset(x, y);
     } else if (_con.mode == 2) {
         _con.shape.ellipse.pos.reset(x, y);
     } else if (_con.mode == 3) {
         _con.shape.point.pos.reset(x, y);
     }
+    notifyWorld();
 }
 
 void EasyEngine::Components::Collider::resizeBounds(const EasyEngine::Size &size) {
@@ -1175,11 +1714,16 @@ void EasyEngine::Components::Collider::resizeBounds(float width, float height) {
         _con.shape.rectangle.size.reset(width, height);
     } else if (_con.mode == 2) {
         _con.shape.ellipse.area.reset(width, height);
+    } else if (_con.mode == 4) {
+        return;
     }
+    notifyWorld();
 }
 
 void EasyEngine::Components::Collider::setEnabled(bool v) {
+    if (_enabled == v) return;
     _enabled = v;
+    notifyWorld();
 }
 
 bool EasyEngine::Components::Collider::enabled() const {
@@ -1190,7 +1734,7 @@ void EasyEngine::Components::Collider::setSelf(const EasyEngine::Graphics::Recta
     _con.mode = 1;
     _con.shape.rectangle = rect;
     _geometry.reset(rect.pos, rect.size);
-
+    notifyWorld();
 }
 
 void EasyEngine::Components::Collider::setSelf(const EasyEngine::Graphics::Ellipse &ellipse) {
@@ -1199,12 +1743,32 @@ void EasyEngine::Components::Collider::setSelf(const EasyEngine::Graphics::Ellip
     Vector2 real_pos = {ellipse.pos.x + ellipse.area.width / 2, 
                      ellipse.pos.y + ellipse.area.height / 2};
     _geometry.reset(real_pos, ellipse.area);
+    notifyWorld();
 }
 
 void EasyEngine::Components::Collider::setSelf(const EasyEngine::Graphics::Point &point) {
     _con.mode = 3;
     _con.shape.point = point;
     _geometry.reset(point.pos.x, point.pos.y, 1, 1);
+    notifyWorld();
+}
+
+void EasyEngine::Components::Collider::setSelf(const EasyEngine::Vector2 &pos,
+                                               const std::shared_ptr<const EasyEngine::AlphaMask> &mask) {
+    if (!mask) {
+        SDL_Log("[ERROR] The specified alpha mask is not valid!");
+        return;
+    }
+    _con.mode = 4;
+    _con.mask = mask;
+    _con.shape.rectangle.pos = pos;
+    _con.shape.rectangle.size.reset(static_cast<float>(mask->width), static_cast<float>(mask->height));
+    _geometry.reset(pos, _con.shape.rectangle.size);
+    notifyWorld();
+}
+
+const EasyEngine::AlphaMask *EasyEngine::Components::Collider::mask() const {
+    return _con.mode == 4 ? _con.mask.get() : nullptr;
 }
 
 bool EasyEngine::Components::Collider::isValid() const {
@@ -1218,11 +1782,57 @@ const std::type_info& EasyEngine::Components::Collider::shapeType() const {
         return typeid(Graphics::Ellipse);
     } else if (_con.mode == 3) {
         return typeid(Graphics::Point);
+    } else if (_con.mode == 4) {
+        return typeid(AlphaMask);
     } else {
         return typeid(void);
     }
 }
 
+EasyEngine::GeometryF EasyEngine::Components::Collider::boundingBox() const {
+    GeometryF box;
+    if (_con.mode == 1 || _con.mode == 4) {
+        box.reset(_con.shape.rectangle.pos, _con.shape.rectangle.size);
+    } else if (_con.mode == 2) {
+        auto& ellipse = _con.shape.ellipse;
+        box.reset(ellipse.pos.x - ellipse.area.width / 2, ellipse.pos.y - ellipse.area.height / 2,
+                  ellipse.area.width, ellipse.area.height);
+    } else if (_con.mode == 3) {
+        box.reset(_con.shape.point.pos.x - 1, _con.shape.point.pos.y - 1, 2, 2);
+    } else {
+        box = _geometry;
+    }
+    return box;
+}
+
+EasyEngine::Components::CollisionWorld *EasyEngine::Components::Collider::world() const {
+    return _world;
+}
+
+void EasyEngine::Components::Collider::notifyWorld() {
+    if (_world) _world->_markMoved(_proxy);
+}
+
+int8_t EasyEngine::Components::Collider::checkMask(const EasyEngine::Components::Collider &collider) const {
+    // 交换后保证此碰撞器为遮罩
+    if (_con.mode != 4) return collider.checkMask(*this);
+    auto& mask = *_con.mask;
+    auto& pos = _con.shape.rectangle.pos;
+    auto& target = collider._con;
+    // 包围盒预检测，相交后再逐像素比较
+    const GeometryF box = collider.boundingBox();
+    if (box.pos.x > pos.x + static_cast<float>(mask.width) || box.pos.x + box.size.width < pos.x ||
+        box.pos.y > pos.y + static_cast<float>(mask.height) || box.pos.y + box.size.height < pos.y) {
+        return -1;
+    }
+    if (target.mode == 1) return Algorithm::compareMaskRect(mask, pos, target.shape.rectangle);
+    if (target.mode == 2) return Algorithm::compareMaskEllipse(mask, pos, target.shape.ellipse);
+    if (target.mode == 3) return Algorithm::comparePosMask(target.shape.point.pos, mask, pos);
+    if (target.mode == 4) return Algorithm::compareMask(mask, pos, *target.mask, target.shape.rectangle.pos);
+    SDL_Log("[WARNING] The specified collider is not match by the current collider!");
+    return 0;
+}
+
 EasyEngine::Components::Entity::Entity(const std::string &name) : _obj_name(name) {
     _collider = std::make_unique<Collider>();
     _container = std::make_shared<Element>();
@@ -1339,9 +1949,12 @@ void EasyEngine::Components::Entity::setPosition(EasyEngine::Vector2 pos) {
 }
 
 void EasyEngine::Components::Entity::setPosition(float x, float y) {
+    _prev_pos = _pos;
     _pos.reset(x, y);
     if (_collider->isValid()) {
-        if (_collider->shapeType() != typeid(Graphics::Rectangle)) {
+        // 矩形与遮罩碰撞器以左上角定位，其余以中心点定位
+        const auto& type = _collider->shapeType();
+        if (type != typeid(Graphics::Rectangle) && type != typeid(AlphaMask)) {
             _collider->moveBounds(x + _center_pos.x, y + _center_pos.y);
         } else {
             _collider->moveBounds(x, y);
@@ -1361,6 +1974,28 @@ EasyEngine::Vector2 EasyEngine::Components::Entity::position() const {
     return _pos;
 }
 
+EasyEngine::Size EasyEngine::Components::Entity::size() const {
+    if (_container->type_id == 1) {
+        return _container->self.sprite->size();
+    } else if (_container->type_id == 2) {
+        return _container->self.sprite_group->size();
+    } else if (_container->type_id == 3) {
+        auto animation = _container->self.frame_animation.get();
+        if (animation->framesCount() > 0) return animation->sprite(animation->currentFrame())->size();
+    } else if (_container->type_id == 4) {
+        return _container->self.clip_sprite.size;
+    }
+    return {0, 0};
+}
+
+EasyEngine::Vector2 EasyEngine::Components::Entity::previousPosition() const {
+    return _prev_pos;
+}
+
+void EasyEngine::Components::Entity::resetMotion() {
+    _prev_pos = _pos;
+}
+
 EasyEngine::Vector2 EasyEngine::Components::Entity::centerPosition() const {
     return _center_pos;
 }
@@ -1403,7 +2038,8 @@ void EasyEngine::Components::Entity::update() const {
 
 EasyEngine::Components::Font::Font(const std::string &name, float font_size)
     : _font_size(font_size), _font_direction(LeftToRight), _font_outline(0), _font_style_flags(0) {
-    _font = TTF_OpenFont(ResourceSystem::global()->resourcePath(name).c_str(), font_size);
+    _font = TTF_OpenFontIO(ResourceSystem::global()->openIO(ResourceSystem::global()->resourcePath(name)),
+                           true, font_size);
     if (!_font) {
         SDL_Log("[ERROR] Can't load the specified font!\nException: %s", SDL_GetError());
         _font_is_loaded = false;
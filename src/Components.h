@@ -17,6 +17,7 @@
 
 namespace EasyEngine {
     class Painter;
+    struct SharedTexture;
     class EventSystem;
     class AudioSystem;
     /**
@@ -27,6 +28,8 @@ namespace EasyEngine {
      */
     namespace Components {
         class Timer;
+        class TextureAtlas;
+        class CollisionWorld;
         /**
          * @class BGM
          * @brief 背景音乐
@@ -247,6 +250,12 @@ namespace EasyEngine {
              * @see setDelay
              */
             uint64_t delay() const;
+            /**
+             * @brief 获取距离下一次触发的剩余时间（毫秒）
+             * @return 若定时器未启用，则返回 `UINT64_MAX`；若已到期，则返回 0
+             * @since v1.1.0-alpha
+             */
+            uint64_t remaining() const;
             /**
              * @brief 更新定时器状态（无需手动调用）
              */
@@ -385,6 +394,18 @@ namespace EasyEngine {
              */
             Sprite(const std::string& name, const std::string& resource_name,
                    const EasyEngine::Vector2 &clip_pos, const EasyEngine::Size &clip_size, Painter *painter);
+            /**
+             * @brief 从纹理图集中创建一个精灵
+             * @param name          精灵别名
+             * @param atlas         指定已构建的纹理图集
+             * @param resource_name 指定图集中的资源名称
+             *
+             * 精灵将直接引用图集中对应的子区域，不再单独创建纹理。
+             * @warning 纹理图集必须比使用它的精灵存活更久！
+             * @see TextureAtlas
+             * @since v1.1.0-alpha
+             */
+            Sprite(const std::string& name, TextureAtlas* atlas, const std::string& resource_name);
             ~Sprite();
             /**
              * @brief 复制并替换原有的精灵
@@ -446,6 +467,20 @@ namespace EasyEngine {
              * @since v1.1.0-alpha
              */
             STexture* sprite() const;
+            /**
+             * @brief 获取精灵所引用的纹理图集
+             * @return 若精灵并非来自纹理图集，则返回 `nullptr`
+             * @see TextureAtlas
+             * @since v1.1.0-alpha
+             */
+            TextureAtlas* atlas() const;
+            /**
+             * @brief 获取精灵在纹理图集中所在的子区域
+             * @note 仅当 `atlas()` 不为 `nullptr` 时有效
+             * @see atlas
+             * @since v1.1.0-alpha
+             */
+            const GeometryF& atlasRegion() const;
             /**
              * @brief 在指定位置上绘制精灵
              * @param pos 指定绘制坐标
@@ -554,15 +589,183 @@ namespace EasyEngine {
              * @see properties
              */
             void draw(Painter* painter = nullptr) const;
+            /**
+             * @brief 获取精灵当前驻留的内存
+             *
+             * 共享纹理按完整的表面与纹理计算；来自纹理图集的精灵仅计算其子区域在图集页面中所占的字节数。
+             * @note 多个精灵共享的部分会在各自的结果中重复出现，总量请使用 `ResourceSystem::memoryUsage()`。
+             * @see ResourceSystem::memoryUsage
+             * @since v1.1.0-alpha
+             */
+            MemoryUsage memoryUsage() const;
+            /**
+             * @brief 获取精灵图片的 1 位透明度遮罩，用于像素级的碰撞检测
+             * @param threshold 透明度阈值，不低于此值的像素视为不透明
+             * @return 返回遮罩，失败时返回 `nullptr`
+             *
+             * 使用共享纹理的精灵（通过资源名称创建）直接取用资源系统中缓存的遮罩，与其它精灵共享；
+             * 其余精灵根据自身的表面（及裁剪区域）生成一次并缓存，更换图片后重新生成。
+             * @note 不支持来自纹理图集的精灵
+             * @see ResourceSystem::alphaMask
+             * @see Collider::setSelf
+             * @since v1.1.0-alpha
+             */
+            std::shared_ptr<const AlphaMask> alphaMask(uint8_t threshold = 128) const;
+            /**
+             * @brief 收集所有存活精灵持有的表面与纹理（以对象地址去重）
+             * @param cpu 表面地址与字节数
+             * @param gpu 纹理地址与字节数
+             * @note 供 `ResourceSystem::memoryUsage()` 内部使用
+             */
+            static void _collectMemoryUsage(std::map<const void*, uint64_t>& cpu,
+                                            std::map<const void*, uint64_t>& gpu);
 
         private:
-            SSurface* _surface;
-            STexture* _texture;
+            /**
+             * @brief 释放当前持有的表面及纹理（图集纹理仅解除引用）
+             */
+            void releaseTexture();
+            /**
+             * @brief 复制一份当前精灵的表面，若表面已被释放，则从资源路径重新解码
+             * @return 返回新的表面（由调用者持有），失败时返回 `nullptr`
+             */
+            SSurface* duplicateSurface() const;
+            /**
+             * @brief 在仅 GPU 驻留模式下，释放可从资源路径重新解码的表面
+             */
+            void applyResidency();
+            static std::unordered_set<const Sprite*> _live_sprites;
+            SSurface* _surface{nullptr};
+            STexture* _texture{nullptr};
             Painter* _painter;
             std::unique_ptr<Properties> _properties;
             std::string _name;
             std::string _path;
             Size _size;
+            TextureAtlas* _atlas{nullptr};
+            GeometryF _atlas_region{{0, 0}, {0, 0}};
+            std::shared_ptr<SharedTexture> _shared_texture;
+            mutable std::shared_ptr<const AlphaMask> _alpha_mask;
+            mutable uint8_t _alpha_threshold{0};
+        };
+
+        /**
+         * @class TextureAtlas
+         * @brief 纹理图集
+         *
+         * 使用天际线（Skyline）算法将多个图片资源打包至少量的大纹理中，
+         * 精灵及帧动画可直接引用图集中的子区域，从而减少纹理切换并便于合批绘制。
+         * @code
+         * Components::TextureAtlas atlas("loading", engine.painter());
+         * atlas.append({"load1", "load2", "load3"});
+         * atlas.build();
+         * Components::Sprite sprite("load1", &atlas, "load1");
+         * @endcode
+         * @since v1.1.0-alpha
+         */
+        class TextureAtlas {
+        public:
+            /**
+             * @struct Region
+             * @brief 图集子区域
+             */
+            struct Region {
+                /// 所在图集页
+                uint32_t page;
+                /// 在图集页中的位置、大小
+                GeometryF geometry;
+            };
+            /**
+             * @brief 创建纹理图集
+             * @param name          图集别名
+             * @param painter       使用的绘图器
+             * @param page_width    每页图集的最大宽度（默认 2048）
+             * @param page_height   每页图集的最大高度（默认 2048）
+             * @param padding       子区域之间的间距（默认 1 像素，用于避免采样溢出）
+             */
+            explicit TextureAtlas(const std::string& name, Painter* painter, uint32_t page_width = 2048,
+                                  uint32_t page_height = 2048, uint32_t padding = 1);
+            ~TextureAtlas();
+            TextureAtlas(const TextureAtlas&) = delete;
+            TextureAtlas& operator=(const TextureAtlas&) = delete;
+            /**
+             * @brief 获取图集别名
+             */
+            const std::string& name() const;
+            /**
+             * @brief 获取当前使用的绘图器
+             */
+            Painter* painter() const;
+            /**
+             * @brief 登记需要打包的图片资源
+             * @param resource_name 资源系统中的资源名称（类型必须为 `Resource::Image`）
+             * @return 返回是否成功登记
+             * @note 必须在 `build()` 之前调用
+             * @see build
+             */
+            bool append(const std::string& resource_name);
+            /**
+             * @brief 登记多个需要打包的图片资源
+             * @param resource_names 资源名称列表
+             * @return 返回登记失败的个数
+             * @see build
+             */
+            uint64_t append(const std::vector<std::string>& resource_names);
+            /**
+             * @brief 打包所有已登记的资源并生成图集纹理
+             * @return 返回是否全部打包成功
+             * @note 若资源已由资源系统加载，将直接使用已加载的表面；否则临时从文件中读取。
+             * @see append
+             * @see clear
+             */
+            bool build();
+            /**
+             * @brief 是否已构建图集
+             */
+            bool isBuilt() const;
+            /**
+             * @brief 清空图集，释放所有图集纹理
+             * @warning 调用后，引用此图集的精灵将失效！
+             */
+            void clear();
+            /**
+             * @brief 图集中是否包含指定资源
+             * @param resource_name 指定资源名称
+             */
+            bool contains(const std::string& resource_name) const;
+            /**
+             * @brief 获取指定资源所在的子区域
+             * @param resource_name 指定资源名称
+             * @return 返回对应子区域，若找不到则返回 `nullptr`
+             */
+            const Region* region(const std::string& resource_name) const;
+            /**
+             * @brief 获取图集页数
+             */
+            size_t pageCount() const;
+            /**
+             * @brief 获取指定图集页的纹理
+             * @param index 指定页数
+             * @return 返回对应纹理，若超出范围则返回 `nullptr`
+             */
+            STexture* page(size_t index) const;
+        private:
+            struct SkylineNode {
+                int x, y, width;
+            };
+            static int skylineFit(const std::vector<SkylineNode>& skyline, size_t index,
+                                  int width, int height, int page_width, int page_height);
+            static void skylinePlace(std::vector<SkylineNode>& skyline, size_t index,
+                                     int x, int y, int width, int height);
+            std::string _name;
+            Painter* _painter;
+            uint32_t _page_width;
+            uint32_t _page_height;
+            uint32_t _padding;
+            std::vector<std::string> _pending;
+            std::unordered_map<std::string, Region> _regions;
+            std::vector<STexture*> _pages;
+            bool _is_built{false};
         };
 
         /**
@@ -765,6 +968,19 @@ namespace EasyEngine {
              */
             FrameAnimation(const std::string& name, const std::vector<Sprite *> &sprite_list,
                            uint64_t duration_per_frame = 50);
+            /**
+             * @brief 从纹理图集中创建动画
+             * @param name                  动画别名
+             * @param atlas                 指定已构建的纹理图集
+             * @param resource_names        按帧顺序排列的资源名称
+             * @param duration_per_frame    每帧的持续时间（单位：毫秒），默认 50 毫秒
+             *
+             * 每一帧均引用图集中的子区域，所创建的精灵由动画自身管理。
+             * @see TextureAtlas
+             * @since v1.1.0-alpha
+             */
+            FrameAnimation(const std::string& name, TextureAtlas* atlas, const std::vector<std::string>& resource_names,
+                           uint64_t duration_per_frame = 50);
             ~FrameAnimation();
             /**
              * @brief 设置新的别名
@@ -913,6 +1129,7 @@ namespace EasyEngine {
                 uint64_t duration;
             };
             std::vector<Frame> _animations;
+            std::vector<std::shared_ptr<Sprite>> _owned_sprites;
             std::string _name;
             size_t _cur_frame{0};
             bool _is_loop{false};
@@ -975,8 +1192,27 @@ namespace EasyEngine {
                     Graphics::Point point;
                 };
                 Shape shape{};
+                /// 遮罩 4（位置与大小记录在 `shape.rectangle` 中）
+                std::shared_ptr<const AlphaMask> mask;
             };
         public:
+            /**
+             * @struct Impact
+             * @brief 连续碰撞检测的结果
+             * @see sweep
+             * @see raycast
+             * @since v1.1.0-alpha
+             */
+            struct Impact {
+                /// 移动过程中是否发生碰撞
+                bool collided{false};
+                /// 首次接触的时刻（0 ~ 1，为位移的比例）；起始位置已重叠时为 0
+                float time{1.0f};
+                /// 接触处的法线（指向移动的一方）；起始位置已重叠时为零向量
+                Vector2 normal;
+                /// 首次接触时移动的碰撞器所在的位置（与 `moveBounds()` 的参数一致）
+                Vector2 position;
+            };
             /**
              * @brief 创建碰撞器
              */
@@ -996,6 +1232,14 @@ namespace EasyEngine {
              * @param point 圆点碰撞器
              */
             explicit Collider(const Graphics::Point& point);
+            /**
+             * @brief 创建像素级的遮罩碰撞器
+             * @param pos  遮罩左上角所在的坐标
+             * @param mask 指定遮罩（可与其它碰撞器共享）
+             * @see setSelf(const Vector2&, const std::shared_ptr<const AlphaMask>&)
+             * @since v1.1.0-alpha
+             */
+            Collider(const Vector2& pos, const std::shared_ptr<const AlphaMask>& mask);
             /**
              * @brief 创建碰撞器（相对位置下）
              * @param x       所在位置 x 轴
@@ -1005,15 +1249,56 @@ namespace EasyEngine {
              * @param shape_mode 碰撞器形状（1 = 矩形，2 = 椭圆，3 = 圆点）
              */
             Collider(float x, float y, float width, float height, uint8_t shape_mode);
+            /**
+             * @brief 复制碰撞器
+             * @note 仅复制形状及状态，不会加入原碰撞器所在的碰撞世界
+             */
+            Collider(const Collider& collider);
+            Collider& operator=(const Collider& collider);
+            /**
+             * @brief 销毁碰撞器，并自动从所在的碰撞世界中移除
+             */
+            ~Collider();
             /**
              * @brief 检查此碰撞器是否与其它碰撞器存在碰撞？
              * @param collider  指定碰撞器（除自己以外）
              * @return `< 0` 表示未碰撞，`>= 0` 表示接触或已碰撞
              * @see compareRect
              * @see compareEllipse
+             * @see compareMask
              * @see bounds
              */
             int8_t check(const EasyEngine::Components::Collider &collider) const;
+            /**
+             * @brief 连续碰撞检测：计算此碰撞器移动过程中与其它碰撞器首次接触的时刻
+             * @param displacement        此碰撞器从当前位置出发的位移
+             * @param collider            指定碰撞器（除自己以外）
+             * @param target_displacement 指定碰撞器同时发生的位移（默认静止）
+             * @return 返回碰撞结果，任意一方未启用时视为未碰撞
+             *
+             * 与 `check()` 只检测某一时刻不同，此函数检测整段位移，快速移动的物体不会穿过较薄的碰撞器。
+             * 支持矩形、椭圆与圆点之间的任意组合（圆点与圆点除外），遮罩碰撞器按其包围矩形计算。
+             * @code
+             * auto impact = bullet.sweep(velocity * dt, wall);
+             * if (impact.collided) bullet.moveBounds(impact.position);
+             * @endcode
+             * @see Algorithm::sweepRect
+             * @see Algorithm::sweepEllipseRect
+             * @see Algorithm::sweepEllipse
+             * @see CollisionWorld::sweepEntities
+             * @since v1.1.0-alpha
+             */
+            Impact sweep(const Vector2& displacement, const Collider& collider,
+                         const Vector2& target_displacement = {0, 0}) const;
+            /**
+             * @brief 计算线段与此碰撞器首次相交的时刻
+             * @param origin 线段起点
+             * @param delta  线段的位移（终点 = 起点 + 位移）
+             * @return 返回相交结果，其中 `position` 为相交点；圆点碰撞器及未启用的碰撞器不会相交
+             * @note 遮罩碰撞器按其包围矩形计算
+             * @since v1.1.0-alpha
+             */
+            Impact raycast(const Vector2& origin, const Vector2& delta) const;
             /**
              * @brief 获取碰撞器的位置、大小
              * @see setBoundsGeometry
@@ -1095,6 +1380,29 @@ namespace EasyEngine {
              * @param point 指定点
              */
             void setSelf(const Graphics::Point& point);
+            /**
+             * @brief 设置像素级的遮罩作为碰撞器本体
+             * @param pos  遮罩左上角所在的坐标
+             * @param mask 指定遮罩（可与其它碰撞器共享）
+             *
+             * 遮罩碰撞器的大小始终与遮罩一致（1 个像素对应 1 个单位），`resizeBounds()` 对其无效。
+             * 与其它碰撞器检测时先比较包围盒，相交后再逐行按位比较不透明像素。
+             * @code
+             * auto mask = ResourceSystem::global()->alphaMask("player");
+             * player_collider.setSelf(player_pos, mask);
+             * enemy_collider.setSelf(enemy_pos, mask);
+             * @endcode
+             * @see ResourceSystem::alphaMask
+             * @see Sprite::alphaMask
+             * @since v1.1.0-alpha
+             */
+            void setSelf(const Vector2& pos, const std::shared_ptr<const AlphaMask>& mask);
+            /**
+             * @brief 获取遮罩碰撞器使用的遮罩
+             * @return 并非遮罩碰撞器时返回 `nullptr`
+             * @since v1.1.0-alpha
+             */
+            const AlphaMask* mask() const;
             /**
              * @brief 查看是否可用当前碰撞器？
              * 
@@ -1103,9 +1411,26 @@ namespace EasyEngine {
             /**
              * @brief 获取碰撞器的形状类型
              * @return const std::type_info& 碰撞器的形状类型
+             * @note 遮罩碰撞器返回 `typeid(AlphaMask)`
              * @note 对于未定义的形状，返回 `std::type_info(typeid(void))`
              */
             const std::type_info& shapeType() const;
+            /**
+             * @brief 获取碰撞器形状的轴对齐包围盒
+             *
+             * 与 `bounds()` 不同，椭圆以中心点定位，此处换算为左上角；遮罩为其包围矩形；
+             * 圆点按照 `check()` 的容差视为边长为 2 的正方形。
+             * @see CollisionWorld
+             * @since v1.1.0-alpha
+             */
+            GeometryF boundingBox() const;
+            /**
+             * @brief 获取碰撞器所在的碰撞世界
+             * @return 未加入任何碰撞世界时返回 `nullptr`
+             * @see CollisionWorld::append
+             * @since v1.1.0-alpha
+             */
+            CollisionWorld* world() const;
 
             /**
              * @brief 获取碰撞器的形状
@@ -1128,9 +1453,19 @@ namespace EasyEngine {
                 throw std::runtime_error("[FATAL] The specified shape is not match the current shape!");
             }
         private:
+            friend class CollisionWorld;
+            /// 通知所在的碰撞世界此碰撞器已变化
+            void notifyWorld();
+            /// 以偏移后的位置进行连续碰撞检测
+            Impact sweepFrom(const Vector2& offset, const Vector2& displacement, const Collider& collider,
+                             const Vector2& target_offset, const Vector2& target_displacement) const;
+            /// 检测遮罩碰撞器与其它碰撞器（任意一方为遮罩）
+            int8_t checkMask(const Collider& collider) const;
             Container _con;
             bool _enabled;
             GeometryF _geometry;
+            CollisionWorld* _world{nullptr};
+            uint32_t _proxy{0};
         };
 
         /**
@@ -1216,6 +1551,28 @@ namespace EasyEngine {
              * @brief 获取对象位于窗口的坐标
              */
             Vector2 position() const;
+            /**
+             * @brief 获取实体本体绘制时的大小
+             * @note 未存放本体时返回 0
+             * @since v1.1.0-alpha
+             */
+            Size size() const;
+            /**
+             * @brief 获取上一次调用 `setPosition()` 之前所在的坐标
+             *
+             * 与 `position()` 一起构成本次的位移，供连续碰撞检测使用。
+             * @note `CollisionWorld::sweepEntities()` 检测结束后会清除位移
+             * @see resetMotion
+             * @see CollisionWorld::sweepEntities
+             * @since v1.1.0-alpha
+             */
+            Vector2 previousPosition() const;
+            /**
+             * @brief 清除本次的位移（使上一位置等于当前位置）
+             * @note 在传送或重生后调用，避免被视为高速穿过了沿途的碰撞器
+             * @since v1.1.0-alpha
+             */
+            void resetMotion();
             /**
              * @brief 获取对象的中心点
              */
@@ -1246,7 +1603,7 @@ namespace EasyEngine {
             void update() const;
 
         private:
-            Vector2 _pos, _center_pos;
+            Vector2 _pos, _center_pos, _prev_pos;
             std::unique_ptr<Collider> _collider;
             std::string _obj_name;
             std::shared_ptr<Element> _container;
@@ -34,6 +34,8 @@ EasyEngine::Vector2 EasyEngine::Cursor::globalPosition() const {
 }
 
 EasyEngine::Vector2 EasyEngine::Cursor::position() const {
+    // 录制或回放时使用每帧开始时的光标位置
+    if (Replay::global()->mode() != Replay::Idle) return Replay::global()->cursorPosition();
     Vector2 temp_pos;
     SDL_GetMouseState(&temp_pos.x, &temp_pos.y);
     return temp_pos;
@@ -158,7 +160,8 @@ void EasyEngine::Cursor::unload() {
 }
 
 
-EasyEngine::Engine::Engine(const std::string& title, uint32_t width, uint32_t height) {
+EasyEngine::Engine::Engine(const std::string& title, uint32_t width, uint32_t height, bool headless)
+    : _is_headless(headless) {
     fmt::println("┏━╸┏━┓┏━┓╻ ╻┏━╸┏┓╻┏━╸╻┏┓╻┏━╸\n"
                  "┣╸ ┣━┫┗━┓┗┳┛┣╸ ┃┗┫┃╺┓┃┃┗┫┣╸\n"
                  "┗━╸╹ ╹┗━┛ ╹ ┗━╸╹ ╹┗━┛╹╹ ╹┗━╸\n\n"
@@ -168,7 +171,14 @@ EasyEngine::Engine::Engine(const std::string& title, uint32_t width, uint32_t he
                  "- https://gitee.com/CatIsNotFound/EasyEngine\n",
                  EASYENGINE_NAME, EASYENGINE_MAJOR_VERSION, EASYENGINE_MINOR_VERSION, EASYENGINE_MACRO_VERSION,
                  EASYENGINE_VERSION, SDL_MAJOR_VERSION, SDL_MINOR_VERSION, SDL_MICRO_VERSION);
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD | SDL_INIT_CAMERA)) {
+    SDL_InitFlags init_flags = SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK | SDL_INIT_GAMEPAD | SDL_INIT_CAMERA;
+    if (_is_headless) {
+        // 无窗口模式：使用 dummy 驱动，且无需初始化输入设备及摄像头
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        init_flags = SDL_INIT_VIDEO | SDL_INIT_AUDIO;
+    }
+    if (!SDL_Init(init_flags)) {
         SDL_Log("[ERROR] Initializing Engine failed!\n");
         throw std::runtime_error("[FATAL] Initialized Engine failed!\n");
     }
@@ -339,7 +349,7 @@ bool EasyEngine::Engine::setWindowIcon(const std::string &resource_name, SWindow
         return false;
     }
     SSurface* _window_icon = _sdl_window_list.at(window_id)->icon;
-    _window_icon = IMG_Load(ResourceSystem::global()->resourcePath(resource_name).c_str());
+    _window_icon = ResourceSystem::global()->decodeImage(ResourceSystem::global()->resourcePath(resource_name));
     if (!_window_icon) {
         SDL_Log("[ERROR] Can't set window icon for wID %u!\nException: %s", window_id, SDL_GetError());
         return false;
@@ -384,7 +394,7 @@ bool EasyEngine::Engine::init(const char *title, uint32_t width, uint32_t height
         return false;
     }
     SDL_WindowID id = SDL_GetWindowID(_sdl_window);
-    SRenderer* _sdl_renderer = SDL_CreateRenderer(_sdl_window, nullptr);
+    SRenderer* _sdl_renderer = SDL_CreateRenderer(_sdl_window, _is_headless ? SDL_SOFTWARE_RENDERER : nullptr);
     if (!_sdl_renderer) {
         SDL_Log("[ERROR] wID %u created failed! Code: %s\n", id, SDL_GetError());
         SDL_DestroyWindow(_sdl_window);
@@ -394,6 +404,7 @@ bool EasyEngine::Engine::init(const char *title, uint32_t width, uint32_t height
     _sdl_window_list[id] = std::make_shared<Window>(Window(_sdl_window, _sdl_renderer));
     _sdl_window_list[id]->geometry.setGeometry(0, 0, width, height);
     _renderer_list[id] = std::make_unique<Painter>(_sdl_window_list[id].get());
+    _renderer_list[id]->setRenderScale(_pacing_stats.render_scale);
     if (wID) *wID = id;
     _window_count++;
     return true;
@@ -404,6 +415,8 @@ bool EasyEngine::Engine::unload(SDL_WindowID window_id) {
         SDL_Log("[ERROR] wID %u is not found!\n", window_id);
         return false;
     }
+    // 渲染线程可能仍在使用此窗口的渲染器
+    waitForRender();
     if (_renderer_list.at(window_id)) {
         _renderer_list.erase(window_id);
     }
@@ -418,11 +431,7 @@ bool EasyEngine::Engine::unload(SDL_WindowID window_id) {
 int EasyEngine::Engine::run() {
     // 高精度计时器初始化
     const uint64_t performance_freq = SDL_GetPerformanceFrequency();
-    
-    // 事件循环专用计时器 - 固定1000Hz事件处理
-    const uint64_t event_interval = performance_freq / 1000; // 1ms事件间隔
-    uint64_t last_event_time = SDL_GetPerformanceCounter();
-    
+
     // 渲染循环计时器
     uint64_t last_render_time = SDL_GetPerformanceCounter();
     uint64_t frames_in_a_second = 0;
@@ -431,21 +440,74 @@ int EasyEngine::Engine::run() {
     // 丢帧检测变量
     uint64_t consecutive_slow_frames = 0;
     uint64_t dropped_frames = 0;
+    // 固定步长更新的累计时间
+    uint64_t last_update_time = SDL_GetPerformanceCounter();
+    uint64_t update_accumulator = 0;
     // 渲染循环状态
     bool render_needed = true;
+    // 每帧耗时记录
+    const uint64_t exec_start = SDL_GetPerformanceCounter();
+    uint64_t last_frame_start = 0;
+    auto replay = Replay::global();
+    _frames_rendered = 0;
+    _frame_timings.clear();
     while (_is_running) {
+        if (_render_thread_enabled != _render_thread.joinable()) {
+            _render_thread_enabled ? startRenderThread() : stopRenderThread();
+        }
+        // 每次循环都处理完所有待处理的事件
+        _is_running = EventSystem::global()->handler();
+        if (EventSystem::global()->_render_device_reset) {
+            EventSystem::global()->_render_device_reset = false;
+            for (auto& _renderer : _renderer_list) {
+                ResourceSystem::global()->restoreSharedTextures(_renderer.second.get());
+            }
+        }
         const uint64_t now = SDL_GetPerformanceCounter();
+        // 决定是否渲染画面
+        if (_is_allowed_stop_render && _is_stopped) {
+            // 不渲染时仅需等待事件或计时器
+            if (!replay->isPlaying()) waitForNextDeadline(EventSystem::global()->idleTimeoutNS());
+            last_update_time = SDL_GetPerformanceCounter();
+            continue;
+        }
 
-        // 事件处理循环，每隔 1ms 处理一次
-        if (now - last_event_time >= event_interval) {
-            _is_running = EventSystem::global()->handler(); // 高频事件处理
-            last_event_time = now;
+        // 固定步长的逻辑更新，在渲染之前追上实际时间
+        if (_update_function && _is_running) {
+            const uint64_t step = performance_freq / std::max(_tick_rate, 1u);
+            const float dt = 1.0f / static_cast<float>(std::max(_tick_rate, 1u));
+            update_accumulator += now - last_update_time;
+            last_update_time = now;
+            uint32_t steps = 0;
+            if (replay->isPlaying()) {
+                // 回放时按录制时的步数更新，与实际耗时无关
+                steps = replay->_updateSteps();
+                update_accumulator = 0;
+            } else {
+                while (update_accumulator >= step && steps < _max_catch_up_steps) {
+                    update_accumulator -= step;
+                    steps += 1;
+                }
+                // 积压过多时丢弃剩余时间，避免越追越慢
+                if (update_accumulator >= step) update_accumulator %= step;
+                if (replay->isRecording()) replay->_setUpdateSteps(steps);
+            }
+            for (uint32_t i = 0; i < steps; ++i) {
+                EASYENGINE_PROFILE_ZONE("Update");
+                _update_function(dt);
+                _tick_count += 1;
+            }
+            _interpolation_alpha = static_cast<float>(update_accumulator) / static_cast<float>(step);
+        } else {
+            last_update_time = now;
         }
-        // 决定是否渲染画面
-        if (_is_allowed_stop_render && _is_stopped) continue;
         // 渲染循环，根据 FPS 动态调整渲染频率
         bool should_render = false;
-        if (_fps > 0) {
+        if (replay->isPlaying()) {
+            // 回放时以最快速度运行，仅在录制时渲染过的帧中渲染
+            should_render = replay->_rendered();
+            last_render_time = now;
+        } else if (_fps > 0) {
             const uint64_t render_interval = performance_freq / _fps;
             if (now - last_render_time >= render_interval) {
                 should_render = true;
@@ -455,11 +517,13 @@ int EasyEngine::Engine::run() {
             // 无限制帧率 - 每帧都渲染
             should_render = true;
         }
+        if (replay->isRecording()) replay->_setRendered(should_render && _is_running);
 
         if (should_render && _is_running) {
             // 渲染前更新阈值
             if (_fps > 0) {
-                max_frame_duration = (performance_freq * 15) / (10 * _fps);
+                max_frame_duration = static_cast<uint64_t>(
+                        static_cast<double>(performance_freq) * _frame_drop_tolerance / _fps);
                 target_frame_duration = performance_freq / _fps;
             } else {
                 max_frame_duration = performance_freq / 40;
@@ -468,57 +532,456 @@ int EasyEngine::Engine::run() {
             uint64_t render_start = SDL_GetPerformanceCounter();
 
             {
+                EASYENGINE_PROFILE_ZONE("Render");
                 std::lock_guard<std::mutex> lock(_mutex);
 
                 // 检查丢帧
                 bool should_skip_frame = false;
-                if (consecutive_slow_frames >= max_consecutive_slow_frames) {
+                // 启用自适应帧节奏时，优先降低画质及分辨率，均已降至最低时才丢帧
+                if (consecutive_slow_frames >= max_consecutive_slow_frames &&
+                    (!_adaptive_pacing || isPacingExhausted())) {
                     should_skip_frame = true;
                     consecutive_slow_frames = 0;
                     dropped_frames += 1;
+                    _pacing_stats.dropped_frames += 1;
                 }
 
+                // 仅刷新已达到各自目标帧率间隔的窗口
+                _frame_painters.clear();
                 if (!should_skip_frame) {
-                    if (_window_count == 1) {
-                        _renderer_list.begin()->second->______();
-                    } else if (_window_count > 1) {
-                        for (auto &_renderer: _renderer_list) {
-                            _renderer.second->______();
+                    for (auto &_renderer: _renderer_list) {
+                        if (_renderer.second->isFrameDue(now, performance_freq)) {
+                            _frame_painters.push_back(_renderer.second.get());
                         }
                     }
                 }
+                // 未刷新任何窗口（均未到达各自的帧间隔或已丢帧）时，不算作渲染了一帧
+                if (replay->isRecording()) replay->_setRendered(!_frame_painters.empty());
+
+                if (!_frame_painters.empty() && _render_thread.joinable()) {
+                    // 先记录新的一帧，再等待渲染线程完成上一帧后交换命令缓冲
+                    recordFrames(_frame_painters);
+                    waitForRender();
+                    _submit_painters = _frame_painters;
+                    for (auto &_painter: _submit_painters) {
+                        _painter->swapFrame();
+                    }
+                    {
+                        std::lock_guard<std::mutex> render_lock(_render_mutex);
+                        _frame_pending = true;
+                    }
+                    _render_cv.notify_all();
+                    // 绘图事件记录的是下一帧的命令，与渲染线程并行执行
+                    EASYENGINE_PROFILE_ZONE("PaintEvent");
+                    for (auto &_painter: _frame_painters) {
+                        _painter->paintEvent();
+                    }
+                } else if (_frame_painters.size() == 1) {
+                    _frame_painters.front()->______();
+                } else if (_frame_painters.size() > 1) {
+                    // 并行记录各窗口的命令，提交则按顺序执行
+                    recordFrames(_frame_painters);
+                    for (auto &_painter: _frame_painters) {
+                        _painter->swapFrame();
+                        _painter->submitFrame();
+                    }
+                    EASYENGINE_PROFILE_ZONE("PaintEvent");
+                    for (auto &_painter: _frame_painters) {
+                        _painter->paintEvent();
+                    }
+                }
             }
 
-            // 丢帧检测
-            uint64_t render_end = SDL_GetPerformanceCounter();
-            uint64_t render_duration = render_end - render_start;
+            // 仅统计实际刷新了窗口的帧，帧数上限、帧计数及分析器均据此推进
+            if (!_frame_painters.empty()) {
+                // 丢帧检测
+                uint64_t render_end = SDL_GetPerformanceCounter();
+                uint64_t render_duration = render_end - render_start;
+                if (_adaptive_pacing) {
+                    const auto to_ms = [performance_freq](uint64_t ticks) {
+                        return static_cast<float>(static_cast<double>(ticks) * 1000.0 / static_cast<double>(performance_freq));
+                    };
+                    updatePacing(to_ms(render_duration), _fps > 0 ? 1000.0f / static_cast<float>(_fps) : 1000.0f / 60.0f,
+                                 to_ms(max_frame_duration));
+                }
 
-            if (render_duration > max_frame_duration) {
-                consecutive_slow_frames++;
-            } else {
-                consecutive_slow_frames = 0;
-            }
+                if (render_duration > max_frame_duration) {
+                    consecutive_slow_frames++;
+                } else {
+                    consecutive_slow_frames = 0;
+                }
 
-            // FPS统计
-            frames_in_a_second++;
-            if (now - latest_fps_check >= performance_freq) {
-                _real_fps = frames_in_a_second;
-                latest_fps_check = now;
-                frames_in_a_second = 0;
-                if (dropped_frames) SDL_Log("[WARNING] Frame skipped due to slow rendering! count: %d", dropped_frames);
-                dropped_frames = 0;
+                if (_frame_limit || !_frame_timing_file.empty()) {
+                    const auto to_ms = [performance_freq](uint64_t ticks) {
+                        return static_cast<float>(static_cast<double>(ticks) * 1000.0 / static_cast<double>(performance_freq));
+                    };
+                    _frame_timings.push_back({_frames_rendered, to_ms(render_start - exec_start), to_ms(render_duration),
+                                              last_frame_start ? to_ms(render_start - last_frame_start) : 0.0f});
+                    last_frame_start = render_start;
+                }
+                _frames_rendered += 1;
+                if (_frame_limit && _frames_rendered >= _frame_limit) _is_running = false;
+
+                // FPS统计
+                frames_in_a_second++;
+                if (now - latest_fps_check >= performance_freq) {
+                    _real_fps = frames_in_a_second;
+                    latest_fps_check = now;
+                    frames_in_a_second = 0;
+                    if (dropped_frames) SDL_Log("[WARNING] Frame skipped due to slow rendering! count: %d", dropped_frames);
+                    dropped_frames = 0;
+                }
+                Profiler::global()->endFrame();
             }
         }
 
-        // 防止CPU占用过高
-        if (!should_render) {
-            SDL_DelayNS(1000000ULL); // 1ms睡眠
+        // 计算距离下一次渲染、逻辑更新或计时器触发的时间，并在此之前休眠
+        if (_is_running && _fps > 0 && !replay->isPlaying()) {
+            const uint64_t current = SDL_GetPerformanceCounter();
+            const uint64_t render_interval = performance_freq / _fps;
+            uint64_t wait_ticks = render_interval - std::min(current - last_render_time, render_interval);
+            if (_update_function) {
+                const uint64_t step = performance_freq / std::max(_tick_rate, 1u);
+                const uint64_t pending = update_accumulator + (current - last_update_time);
+                wait_ticks = std::min(wait_ticks, step - std::min(pending, step));
+            }
+            const uint64_t wait_ns = static_cast<uint64_t>(
+                    static_cast<double>(wait_ticks) * 1e9 / static_cast<double>(performance_freq));
+            waitForNextDeadline(std::min(wait_ns, EventSystem::global()->idleTimeoutNS()));
         }
     }
+    stopRenderThread();
+    stopRecordWorkers();
+    if (!_frame_timing_file.empty()) dumpFrameTimings();
     return _is_running;
 }
 
+bool EasyEngine::Engine::dumpFrameTimings() const {
+    std::ofstream file(_frame_timing_file, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_Log("[ERROR] Can't open the file '%s' for dumping frame timings!", _frame_timing_file.c_str());
+        return false;
+    }
+    file << "frame,start_ms,render_ms,interval_ms\n";
+    for (auto& timing : _frame_timings) {
+        file << fmt::format("{},{:.4f},{:.4f},{:.4f}\n", timing.frame, timing.start_time,
+                            timing.render_time, timing.interval);
+    }
+    return file.good();
+}
+
+bool EasyEngine::Engine::isHeadless() const {
+    return _is_headless;
+}
+
+void EasyEngine::Engine::setFrameLimit(uint64_t frames) {
+    _frame_limit = frames;
+}
+
+uint64_t EasyEngine::Engine::frameLimit() const {
+    return _frame_limit;
+}
+
+void EasyEngine::Engine::setFrameTimingFile(const std::string &path) {
+    _frame_timing_file = path;
+}
+
+const std::vector<EasyEngine::Engine::FrameTiming> &EasyEngine::Engine::frameTimings() const {
+    return _frame_timings;
+}
+
+void EasyEngine::Engine::setFrameCapture(const std::string &directory, uint32_t interval) {
+    for (auto& _renderer : _renderer_list) {
+        if (directory.empty()) _renderer.second->stopRecording();
+        else _renderer.second->startRecording(directory, FrameCapture::PNG, interval);
+    }
+}
+
+void EasyEngine::Engine::recordFrames(const std::vector<Painter *> &painters) {
+    // 在主线程中读取窗口位置及大小，记录线程只使用此快照
+    for (auto& _painter : painters) _painter->updateWindowGeometry();
+    if (!_parallel_recording || painters.size() < 2) {
+        for (auto& _painter : painters) _painter->recordFrame();
+        return;
+    }
+    // 主线程也参与记录，因此只需 (窗口数 - 1) 个工作线程
+    const size_t max_workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    const size_t workers = std::min(painters.size() - 1, max_workers);
+    while (_record_workers.size() < workers) {
+        _record_workers.emplace_back(&Engine::recordWorkerLoop, this);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_record_mutex);
+        _record_jobs = painters;
+        _record_next = 0;
+        _record_remaining = painters.size();
+        _record_generation += 1;
+    }
+    _record_cv.notify_all();
+    runRecordJobs();
+    std::unique_lock<std::mutex> lock(_record_mutex);
+    _record_done_cv.wait(lock, [this] { return _record_remaining == 0 && _record_active == 0; });
+}
+
+void EasyEngine::Engine::runRecordJobs() {
+    size_t index;
+    while ((index = _record_next.fetch_add(1)) < _record_jobs.size()) {
+        _record_jobs[index]->recordFrame();
+        std::lock_guard<std::mutex> lock(_record_mutex);
+        if (--_record_remaining == 0) _record_done_cv.notify_all();
+    }
+}
+
+void EasyEngine::Engine::recordWorkerLoop() {
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(_record_mutex);
+    while (true) {
+        _record_cv.wait(lock, [this, &generation] {
+            return _stop_record_workers || _record_generation != generation;
+        });
+        if (_stop_record_workers) return;
+        generation = _record_generation;
+        _record_active += 1;
+        lock.unlock();
+        if (Profiler::global()->enabled()) Profiler::global()->setThreadName("Record");
+        runRecordJobs();
+        lock.lock();
+        if (--_record_active == 0) _record_done_cv.notify_all();
+    }
+}
+
+void EasyEngine::Engine::stopRecordWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(_record_mutex);
+        _stop_record_workers = true;
+    }
+    _record_cv.notify_all();
+    for (auto& _worker : _record_workers) {
+        if (_worker.joinable()) _worker.join();
+    }
+    _record_workers.clear();
+    _stop_record_workers = false;
+}
+
+bool EasyEngine::Engine::setWindowFPS(SWindowID window_id, uint32_t fps) {
+    if (!_renderer_list.contains(window_id)) {
+        SDL_Log("[ERROR] wID %u is not found!\n", window_id);
+        return false;
+    }
+    _renderer_list.at(window_id)->_target_fps = fps;
+    return true;
+}
+
+uint32_t EasyEngine::Engine::windowFPS(SWindowID window_id) const {
+    if (!_renderer_list.contains(window_id)) return 0;
+    return _renderer_list.at(window_id)->_target_fps;
+}
+
+void EasyEngine::Engine::updatePacing(float frame_time, float target_time, float threshold) {
+    // 每次调整后至少积累的样本数，避免被单帧抖动或刚调整完的过渡帧影响
+    const size_t min_samples = std::max<size_t>(_pacing_window / 4, 8);
+    constexpr float SCALE_STEP = 0.1f;
+    if (_pacing_samples.size() != _pacing_window) {
+        _pacing_samples.assign(_pacing_window, 0.0f);
+        _pacing_cursor = _pacing_count = 0;
+    }
+    _pacing_samples[_pacing_cursor] = frame_time;
+    _pacing_cursor = (_pacing_cursor + 1) % _pacing_window;
+    _pacing_count = std::min<size_t>(_pacing_count + 1, _pacing_window);
+    _pacing_stats.threshold_time = threshold;
+    if (_pacing_count < min_samples) return;
+
+    _pacing_sorted.assign(_pacing_samples.begin(), _pacing_samples.begin() + static_cast<int64_t>(_pacing_count));
+    auto nth = _pacing_sorted.begin() + static_cast<int64_t>(
+            std::min(_pacing_count - 1, static_cast<size_t>(_pacing_percentile * static_cast<float>(_pacing_count))));
+    std::nth_element(_pacing_sorted.begin(), nth, _pacing_sorted.end());
+    _pacing_stats.percentile_time = *nth;
+
+    bool changed = false;
+    auto& tier = _pacing_stats.quality_tier;
+    auto& scale = _pacing_stats.render_scale;
+    if (_pacing_stats.percentile_time > threshold) {
+        // 降级：先降低画质等级，再降低渲染分辨率
+        if (tier + 1 < activeQualityTierCount()) {
+            tier += 1;
+            changed = true;
+        } else if (scale > _min_render_scale) {
+            applyRenderScale(std::max(_min_render_scale, scale - SCALE_STEP));
+            changed = true;
+        }
+        if (changed) _pacing_stats.downgrades += 1;
+    } else if (_pacing_stats.percentile_time < target_time * 0.75f) {
+        // 升级：先恢复渲染分辨率，再恢复画质等级
+        if (scale < _max_render_scale) {
+            applyRenderScale(std::min(_max_render_scale, scale + SCALE_STEP));
+            changed = true;
+        } else if (tier > 0) {
+            tier -= 1;
+            changed = true;
+        }
+        if (changed) _pacing_stats.upgrades += 1;
+    }
+    if (!changed) return;
+    _pacing_cursor = _pacing_count = 0;
+    if (_pacing_function) _pacing_function(_pacing_stats);
+}
+
+bool EasyEngine::Engine::isPacingExhausted() const {
+    return _pacing_stats.quality_tier + 1 >= activeQualityTierCount() && _pacing_stats.render_scale <= _min_render_scale;
+}
+
+uint32_t EasyEngine::Engine::activeQualityTierCount() const {
+    // 画质等级只有交由帧节奏调整事件处理才有意义，否则降级只会推迟降低分辨率
+    return _pacing_function ? _quality_tier_count : 1;
+}
+
+void EasyEngine::Engine::applyRenderScale(float scale) {
+    _pacing_stats.render_scale = scale;
+    for (auto& _renderer : _renderer_list) {
+        _renderer.second->setRenderScale(scale);
+    }
+}
+
+void EasyEngine::Engine::setAdaptivePacingEnabled(bool enabled) {
+    if (_adaptive_pacing == enabled) return;
+    _adaptive_pacing = enabled;
+    _pacing_cursor = _pacing_count = 0;
+    if (!enabled && (_pacing_stats.quality_tier || _pacing_stats.render_scale != _max_render_scale)) {
+        // 禁用时恢复为最高画质
+        _pacing_stats.quality_tier = 0;
+        applyRenderScale(_max_render_scale);
+        if (_pacing_function) _pacing_function(_pacing_stats);
+    }
+}
+
+bool EasyEngine::Engine::adaptivePacingEnabled() const {
+    return _adaptive_pacing;
+}
+
+void EasyEngine::Engine::setPacingPercentile(float percentile, uint32_t window) {
+    _pacing_percentile = std::clamp(percentile, 0.5f, 0.99f);
+    _pacing_window = std::max(window, 16u);
+}
+
+float EasyEngine::Engine::pacingPercentile() const {
+    return _pacing_percentile;
+}
+
+void EasyEngine::Engine::setRenderScaleRange(float min_scale, float max_scale) {
+    _max_render_scale = std::clamp(max_scale, 0.25f, 1.0f);
+    _min_render_scale = std::clamp(min_scale, 0.25f, _max_render_scale);
+    applyRenderScale(std::clamp(_pacing_stats.render_scale, _min_render_scale, _max_render_scale));
+}
+
+void EasyEngine::Engine::setQualityTierCount(uint32_t count) {
+    _quality_tier_count = std::max(count, 1u);
+    if (_pacing_stats.quality_tier >= _quality_tier_count) {
+        _pacing_stats.quality_tier = _quality_tier_count - 1;
+        if (_pacing_function) _pacing_function(_pacing_stats);
+    }
+}
+
+uint32_t EasyEngine::Engine::qualityTierCount() const {
+    return _quality_tier_count;
+}
+
+uint32_t EasyEngine::Engine::qualityTier() const {
+    return _pacing_stats.quality_tier;
+}
+
+void EasyEngine::Engine::installPacingEvent(const std::function<void(const PacingStats &)> &function) {
+    _pacing_function = function;
+}
+
+const EasyEngine::Engine::PacingStats &EasyEngine::Engine::pacingStats() const {
+    return _pacing_stats;
+}
+
+void EasyEngine::Engine::setParallelRecordingEnabled(bool enabled) {
+    _parallel_recording = enabled;
+}
+
+bool EasyEngine::Engine::parallelRecordingEnabled() const {
+    return _parallel_recording;
+}
+
+void EasyEngine::Engine::startRenderThread() {
+    if (_render_thread.joinable()) return;
+    _stop_render_thread = false;
+    _frame_pending = false;
+    Painter::_render_threaded = true;
+    _render_thread = std::thread(&Engine::renderThreadLoop, this);
+}
+
+void EasyEngine::Engine::stopRenderThread() {
+    if (!_render_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(_render_mutex);
+        _stop_render_thread = true;
+    }
+    _render_cv.notify_all();
+    _render_thread.join();
+    Painter::_render_threaded = false;
+    // 渲染线程已退出，剩余的延迟释放在主线程中执行
+    for (auto& _renderer : _renderer_list) {
+        _renderer.second->flushReleases();
+    }
+}
+
+void EasyEngine::Engine::renderThreadLoop() {
+    if (Profiler::global()->enabled()) Profiler::global()->setThreadName("Render");
+    std::unique_lock<std::mutex> lock(_render_mutex);
+    while (true) {
+        _render_cv.wait(lock, [this] { return _stop_render_thread || _frame_pending; });
+        // 退出前仍需执行完已提交的帧
+        if (!_frame_pending) return;
+        lock.unlock();
+        for (auto& _painter : _submit_painters) {
+            _painter->submitFrame();
+        }
+        lock.lock();
+        _frame_pending = false;
+        _render_cv.notify_all();
+    }
+}
+
+void EasyEngine::Engine::setRenderThreadEnabled(bool enabled) {
+    _render_thread_enabled = enabled;
+}
+
+bool EasyEngine::Engine::renderThreadEnabled() const {
+    return _render_thread_enabled;
+}
+
+void EasyEngine::Engine::waitForRender() {
+    if (!_render_thread.joinable()) return;
+    std::unique_lock<std::mutex> lock(_render_mutex);
+    _render_cv.wait(lock, [this] { return !_frame_pending; });
+}
+
+void EasyEngine::Engine::waitForNextDeadline(uint64_t timeout_ns) {
+    if (!timeout_ns) return;
+    if (timeout_ns == UINT64_MAX) {
+        // 没有任何截止时间，直到有新事件到达
+        SDL_WaitEventTimeout(nullptr, -1);
+        return;
+    }
+    const uint64_t deadline = SDL_GetTicksNS() + timeout_ns;
+    // 较长的等待交给系统事件等待，期间有新事件到达时立即返回；最后 1ms 使用精确延时
+    const uint64_t coarse_ns = 1000000ULL;
+    if (timeout_ns > 2 * coarse_ns) {
+        auto timeout_ms = static_cast<int32_t>(std::min<uint64_t>((timeout_ns - coarse_ns) / coarse_ns, INT32_MAX));
+        if (SDL_WaitEventTimeout(nullptr, timeout_ms)) return;
+    }
+    const uint64_t now = SDL_GetTicksNS();
+    if (now < deadline) SDL_DelayPrecise(deadline - now);
+}
+
 void EasyEngine::Engine::cleanUp() {
+    stopRenderThread();
+    stopRecordWorkers();
+    FrameCapture::global()->wait();
+    Replay::global()->stopRecording();
     if (_clean_up_function) _clean_up_function();
     EventSystem::global()->cleanUp();
     Cursor::global()->unload();
@@ -591,7 +1054,8 @@ uint32_t EasyEngine::Engine::fps() const {
 void EasyEngine::Engine::setFrameDropTolerance(float ratio) {
     // 确保比例在合理范围内（1.2-3.0倍）
     ratio = std::max(1.2f, std::min(3.0f, ratio));
-    
+    _frame_drop_tolerance = ratio;
+
     const uint64_t performance_freq = SDL_GetPerformanceFrequency();
     if (_fps > 0) {
         max_frame_duration = (performance_freq * static_cast<uint64_t>(ratio * 10)) / (10 * _fps);
@@ -601,12 +1065,7 @@ void EasyEngine::Engine::setFrameDropTolerance(float ratio) {
 }
 
 float EasyEngine::Engine::frameDropTolerance() const {
-    const uint64_t performance_freq = SDL_GetPerformanceFrequency();
-    if (_fps > 0) {
-        return static_cast<float>(max_frame_duration * _fps) / static_cast<float>(performance_freq);
-    } else {
-        return static_cast<float>(performance_freq) / (40.0f * static_cast<float>(max_frame_duration));
-    }
+    return _frame_drop_tolerance;
 }
 
 void EasyEngine::Engine::setFrameDropThreshold(uint32_t count) {
@@ -629,6 +1088,38 @@ void EasyEngine::Engine::installCleanUpEvent(const std::function<void()> &functi
     _clean_up_function = function;
 }
 
+void EasyEngine::Engine::installUpdateEvent(const std::function<void(float)> &function) {
+    _update_function = function;
+}
+
+void EasyEngine::Engine::setTickRate(uint32_t tick_rate) {
+    if (!tick_rate) {
+        SDL_Log("[ERROR] The tick rate must be greater than 0!");
+        return;
+    }
+    _tick_rate = tick_rate;
+}
+
+uint32_t EasyEngine::Engine::tickRate() const {
+    return _tick_rate;
+}
+
+void EasyEngine::Engine::setMaxCatchUpSteps(uint32_t steps) {
+    _max_catch_up_steps = std::max(steps, 1u);
+}
+
+uint32_t EasyEngine::Engine::maxCatchUpSteps() const {
+    return _max_catch_up_steps;
+}
+
+float EasyEngine::Engine::interpolationAlpha() const {
+    return _interpolation_alpha;
+}
+
+uint64_t EasyEngine::Engine::tickCount() const {
+    return _tick_count;
+}
+
 EasyEngine::Geometry EasyEngine::Engine::screenGeometry() {
     SDL_Rect rect;
     auto _primary_screen = SDL_GetPrimaryDisplay();
@@ -638,7 +1129,13 @@ EasyEngine::Geometry EasyEngine::Engine::screenGeometry() {
 
 EasyEngine::Painter::Painter(EasyEngine::Window* window) : _window(window), paint_function(nullptr), _thickness(1) {}
 
-EasyEngine::Painter::~Painter() = default;
+std::atomic<bool> EasyEngine::Painter::_render_threaded{false};
+
+EasyEngine::Painter::~Painter() {
+    flushReleases();
+    if (_scale_target) SDL_DestroyTexture(_scale_target);
+    if (_capture_target) SDL_DestroyTexture(_capture_target);
+}
 
 const EasyEngine::Window *EasyEngine::Painter::window() const {
     return _window;
@@ -657,54 +1154,430 @@ void EasyEngine::Painter::paintEvent() {
 }
 
 void EasyEngine::Painter::______() {
-    if (_scene_manager && _scene_manager->currentScene()) {
-        _scene_manager->currentScene()->drawLayers();
-    }
-    if (!_running_transition_list.empty()) {
-        for (auto &_running_transition: _running_transition_list) {
-            if (_running_transition) _running_transition->______();
+    updateWindowGeometry();
+    recordFrame();
+    swapFrame();
+    submitFrame();
+    EASYENGINE_PROFILE_ZONE("PaintEvent");
+    paintEvent();
+}
+
+void EasyEngine::Painter::recordFrame() {
+    const uint64_t record_start = SDL_GetTicksNS();
+    {
+        EASYENGINE_PROFILE_ZONE("Scene");
+        if (_scene_manager && _scene_manager->currentScene()) {
+            _scene_manager->currentScene()->drawLayers();
         }
-    }
-    if (!_running_curve_list.empty()) {
-        for (auto& _running_curve : _running_curve_list) {
-            if (_running_curve) _running_curve->______();
+        if (!_running_transition_list.empty()) {
+            for (auto &_running_transition: _running_transition_list) {
+                if (_running_transition) _running_transition->______();
+            }
+        }
+        if (!_running_curve_list.empty()) {
+            for (auto& _running_curve : _running_curve_list) {
+                if (_running_curve) _running_curve->______();
+            }
         }
     }
+    // 统计信息绘制在所有命令之后，保证位于最上层
+    auto profiler = Profiler::global();
+    if (profiler->enabled() && profiler->overlayEnabled()) profiler->drawOverlay(this);
+    _frame_stats.record_time = static_cast<float>(SDL_GetTicksNS() - record_start) / 1e6f;
+}
+
+void EasyEngine::Painter::updateWindowGeometry() {
     SDL_GetWindowPosition(_window->window, &_window->geometry.x, &_window->geometry.y);
     SDL_GetWindowSize(_window->window, &_window->geometry.width, &_window->geometry.height);
+}
+
+void EasyEngine::Painter::swapFrame() {
+    command_list.swap(_submit_list);
+    _text_buffer.swap(_submit_text);
+    command_list.clear();
+    _text_buffer.clear();
+    // 渲染分辨率比例可能在主线程中随时调整，与命令一同交给提交的帧
+    _submit_scale = _render_scale;
+    std::lock_guard<std::mutex> lock(_release_mutex);
+    // 此前请求释放的资源可能仍被本帧引用，待本帧执行完毕后再释放
+    for (auto& release : _release_list) _submit_release_list.emplace_back(std::move(release));
+    _release_list.clear();
+}
+
+void EasyEngine::Painter::submitFrame() {
+    std::lock_guard<std::recursive_mutex> lock(_renderer_mutex);
+    const uint64_t submit_start = SDL_GetTicksNS();
+    // 降低渲染分辨率时，先绘制到较小的离屏纹理中，最后再拉伸至整个窗口
+    float scale = _submit_scale;
+    int output_w = 0, output_h = 0;
+    SDL_GetRenderOutputSize(_window->renderer, &output_w, &output_h);
+    // 需要捕获画面时，先绘制到与窗口同尺寸的离屏纹理中，读取像素后再绘制到窗口
+    const bool capture = isCaptureDue();
+    STexture* capture_target = capture ? captureTarget(output_w, output_h) : nullptr;
+    if (scale < 1.0f) {
+        const int target_w = std::max(1, static_cast<int>(std::ceil(static_cast<float>(output_w) * scale)));
+        const int target_h = std::max(1, static_cast<int>(std::ceil(static_cast<float>(output_h) * scale)));
+        if (!_scale_target || _scale_target->w != target_w || _scale_target->h != target_h) {
+            if (_scale_target) SDL_DestroyTexture(_scale_target);
+            _scale_target = SDL_CreateTexture(_window->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                              SDL_TEXTUREACCESS_TARGET, target_w, target_h);
+            if (_scale_target) SDL_SetTextureScaleMode(_scale_target, SDL_SCALEMODE_LINEAR);
+        }
+        if (!_scale_target || !SDL_SetRenderTarget(_window->renderer, _scale_target)) {
+            SDL_Log("[ERROR] Can't render at a lower resolution!\nException: %s", SDL_GetError());
+            scale = 1.0f;
+        }
+    }
+    if (scale >= 1.0f && capture_target && !SDL_SetRenderTarget(_window->renderer, capture_target)) {
+        SDL_Log("[ERROR] Can't render to the texture for capturing frames!\nException: %s", SDL_GetError());
+        capture_target = nullptr;
+    }
+    _applied_scale = scale;
+    SDL_SetRenderScale(_window->renderer, scale, scale);
     SDL_SetRenderViewport(_window->renderer, nullptr);
     SDL_SetRenderClipRect(_window->renderer, nullptr);
     SDL_SetRenderDrawBlendMode(_window->renderer, SDL_BLENDMODE_BLEND);
-    for (auto& cmd : command_list) {
-        cmd->exec(_window->renderer, thickness());
+    _draw_calls_saved = 0;
+    {
+        EASYENGINE_PROFILE_ZONE("Commands");
+        for (size_t i = 0; i < _submit_list.size();) {
+            if (_sprite_batch_enabled && std::holds_alternative<SpriteCMD>(_submit_list[i])) {
+                i = execSpriteBatch(i);
+            } else {
+                execCommand(_submit_list[i++]);
+            }
+        }
+    }
+    if (scale < 1.0f) {
+        SDL_SetRenderTarget(_window->renderer, capture_target);
+        SDL_SetRenderScale(_window->renderer, 1.0f, 1.0f);
+        SDL_SetRenderViewport(_window->renderer, nullptr);
+        SDL_SetRenderClipRect(_window->renderer, nullptr);
+        SDL_RenderTexture(_window->renderer, _scale_target, nullptr, nullptr);
+    }
+    if (capture_target) _captured_frame = _frame_stats.frame_count;
+    if (capture) {
+        // 未能创建离屏纹理时直接读取后台缓冲区，刷新画面后其内容不再可靠，须在此之前读取
+        captureFrame();
+        if (capture_target) {
+            SDL_SetRenderTarget(_window->renderer, nullptr);
+            SDL_SetRenderScale(_window->renderer, 1.0f, 1.0f);
+            SDL_SetRenderViewport(_window->renderer, nullptr);
+            SDL_SetRenderClipRect(_window->renderer, nullptr);
+            SDL_RenderTexture(_window->renderer, capture_target, nullptr, nullptr);
+        }
+    }
+    {
+        EASYENGINE_PROFILE_ZONE("Present");
+        SDL_RenderPresent(_window->renderer);
+    }
+    const uint64_t present_end = SDL_GetTicksNS();
+    _frame_stats.submit_time = static_cast<float>(present_end - submit_start) / 1e6f;
+    if (_last_present_ns) _frame_stats.frame_time = static_cast<float>(present_end - _last_present_ns) / 1e6f;
+    _last_present_ns = present_end;
+    _frame_stats.frame_count += 1;
+    _frames_in_second += 1;
+    if (present_end - _fps_check_ns >= 1'000'000'000) {
+        _frame_stats.fps = _fps_check_ns ? _frames_in_second : 0;
+        _frames_in_second = 0;
+        _fps_check_ns = present_end;
+    }
+    std::vector<std::function<void()>> releases;
+    {
+        std::lock_guard<std::mutex> release_lock(_release_mutex);
+        releases.swap(_submit_release_list);
+    }
+    for (auto& release : releases) release();
+}
+
+void EasyEngine::Painter::flushReleases() {
+    std::vector<std::function<void()>> releases;
+    {
+        std::lock_guard<std::mutex> lock(_release_mutex);
+        releases.swap(_submit_release_list);
+        for (auto& release : _release_list) releases.emplace_back(std::move(release));
+        _release_list.clear();
+    }
+    for (auto& release : releases) release();
+}
+
+bool EasyEngine::Painter::isCaptureDue() {
+    if (_frame_retained) return true;
+    if (!_capture_directory.empty() && _frame_stats.frame_count % _capture_interval == 0) return true;
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    return !_screenshot_requests.empty();
+}
+
+STexture *EasyEngine::Painter::captureTarget(int width, int height) {
+    if (width <= 0 || height <= 0) return nullptr;
+    if (!_capture_target || _capture_target->w != width || _capture_target->h != height) {
+        if (_capture_target) SDL_DestroyTexture(_capture_target);
+        _capture_target = SDL_CreateTexture(_window->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                            SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!_capture_target) {
+            SDL_Log("[ERROR] Can't create the texture for capturing frames!\nException: %s", SDL_GetError());
+            return nullptr;
+        }
+        // 原样覆盖到窗口上，与直接绘制到窗口的结果保持一致
+        SDL_SetTextureBlendMode(_capture_target, SDL_BLENDMODE_NONE);
+    }
+    return _capture_target;
+}
+
+void EasyEngine::Painter::captureFrame() {
+    struct Output {
+        std::string path;
+        FrameCapture::Format format;
+        std::function<void(bool)> callback;
+    };
+    std::vector<Output> outputs;
+    {
+        std::lock_guard<std::mutex> lock(_capture_mutex);
+        for (auto& [path, callback] : _screenshot_requests) {
+            outputs.push_back({std::move(path), FrameCapture::PNG, std::move(callback)});
+        }
+        _screenshot_requests.clear();
+    }
+    if (!_capture_directory.empty() && _frame_stats.frame_count % _capture_interval == 0) {
+        outputs.push_back({fmt::format("{}/frame_{}_{:06}.{}", _capture_directory, SDL_GetWindowID(_window->window),
+                                       _frame_stats.frame_count, _capture_format == FrameCapture::PNG ? "png" : "rgba"),
+                           _capture_format, {}});
+    }
+    if (outputs.empty()) return;
+    EASYENGINE_PROFILE_ZONE("Capture");
+    auto surface = SDL_RenderReadPixels(_window->renderer, nullptr);
+    if (!surface) {
+        SDL_Log("[ERROR] Can't read the pixels of the current frame!\nException: %s", SDL_GetError());
+        for (auto& output : outputs) if (output.callback) output.callback(false);
+        return;
+    }
+    // 编码交由后台线程完成，同一帧有多个输出时，仅为额外的输出复制画面
+    auto capture = FrameCapture::global();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        auto frame = i + 1 < outputs.size() ? SDL_DuplicateSurface(surface) : surface;
+        capture->submit(frame, outputs[i].path, outputs[i].format, outputs[i].callback);
+    }
+}
+
+bool EasyEngine::Painter::isFrameDue(uint64_t now, uint64_t freq) {
+    if (!_target_fps) return true;
+    const uint64_t interval = freq / _target_fps;
+    if (_last_frame_tick && now - _last_frame_tick < interval) return false;
+    // 按间隔推进以避免累积误差，落后过多时直接对齐到当前时间
+    _last_frame_tick = (_last_frame_tick && now - _last_frame_tick < 2 * interval) ? _last_frame_tick + interval : now;
+    return true;
+}
+
+const EasyEngine::Painter::FrameStats &EasyEngine::Painter::frameStats() const {
+    return _frame_stats;
+}
+
+void EasyEngine::Painter::setRenderScale(float scale) {
+    _render_scale = std::clamp(scale, 0.25f, 1.0f);
+}
+
+float EasyEngine::Painter::renderScale() const {
+    return _render_scale;
+}
+
+void EasyEngine::Painter::requestScreenshot(const std::string &path, const std::function<void(bool)> &callback) {
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+    _screenshot_requests.emplace_back(path, callback);
+}
+
+void EasyEngine::Painter::startRecording(const std::string &directory, FrameCapture::Format format,
+                                         uint32_t interval) {
+    if (directory.empty()) {
+        SDL_Log("[ERROR] The specified directory for recording is empty!");
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) SDL_Log("[ERROR] Can't create the directory '%s'!", directory.c_str());
+    auto lock = lockRenderer();
+    _capture_directory = directory;
+    _capture_format = format;
+    _capture_interval = std::max(interval, 1u);
+}
+
+void EasyEngine::Painter::stopRecording() {
+    auto lock = lockRenderer();
+    _capture_directory.clear();
+}
+
+bool EasyEngine::Painter::isRecording() const {
+    auto lock = lockRenderer();
+    return !_capture_directory.empty();
+}
+
+void EasyEngine::Painter::setFrameRetained(bool retained) {
+    _frame_retained = retained;
+}
+
+bool EasyEngine::Painter::frameRetained() const {
+    return _frame_retained;
+}
+
+SSurface *EasyEngine::Painter::readFrame() {
+    auto lock = lockRenderer();
+    // 离屏纹理仅在捕获的帧中更新，只有最近一帧被捕获时其内容才是最新的；
+    // 刷新画面后后台缓冲区的内容是未定义的，不能代替离屏纹理读取
+    if (!_capture_target || _captured_frame + 1 != _frame_stats.frame_count) {
+        _frame_retained = true;
+        SDL_Log("[ERROR] The latest frame is not retained! Frames will be retained from the next frame.");
+        return nullptr;
+    }
+    auto target = SDL_GetRenderTarget(_window->renderer);
+    SDL_SetRenderTarget(_window->renderer, _capture_target);
+    auto surface = SDL_RenderReadPixels(_window->renderer, nullptr);
+    SDL_SetRenderTarget(_window->renderer, target);
+    return surface;
+}
+
+std::unique_lock<std::recursive_mutex> EasyEngine::Painter::lockRenderer() const {
+    return std::unique_lock<std::recursive_mutex>(_renderer_mutex);
+}
+
+STexture *EasyEngine::Painter::_createTexture(SSurface *surface) {
+    std::lock_guard<std::recursive_mutex> lock(_renderer_mutex);
+    return SDL_CreateTextureFromSurface(_window->renderer, surface);
+}
+
+void EasyEngine::Painter::_deferRelease(Painter *painter, std::function<void()> release) {
+    if (!release) return;
+    if (!painter || !_render_threaded.load()) {
+        release();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(painter->_release_mutex);
+    painter->_release_list.emplace_back(std::move(release));
+}
+
+void EasyEngine::Painter::execCommand(const Command &command) {
+    auto renderer = _window->renderer;
+    switch (command.index()) {
+        case 0: std::get<PointCMD>(command).exec(renderer, _thickness); break;
+        case 1: std::get<LineCMD>(command).exec(renderer, _thickness); break;
+        case 2: std::get<RectCMD>(command).exec(renderer, _thickness); break;
+        case 3: std::get<EllipseCMD>(command).exec(renderer, _thickness); break;
+        case 4: std::get<FillCMD>(command).exec(renderer, _thickness); break;
+        case 5: std::get<SpriteCMD>(command).exec(renderer, _thickness); break;
+        case 6: {
+            auto& cmd = std::get<PixelTextCMD>(command);
+            cmd.exec(renderer, _submit_text.c_str() + cmd.text_offset);
+            break;
+        }
+        case 7: {
+            auto& cmd = std::get<ViewportCMD>(command);
+            cmd.exec(renderer, _thickness);
+            // 视图缩放叠加在本帧实际使用的渲染分辨率比例之上
+            if (!cmd.is_clipped_mode && _applied_scale != 1.0f) {
+                SDL_SetRenderScale(renderer, cmd.scaled.width * _applied_scale, cmd.scaled.height * _applied_scale);
+            }
+            break;
+        }
+        case 8: std::get<TextCMD>(command).exec(renderer, _thickness); break;
+        default: break;
+    }
+}
+
+size_t EasyEngine::Painter::execSpriteBatch(size_t first) {
+    auto texture = std::get<SpriteCMD>(_submit_list[first])._sprite;
+    size_t last = first + 1;
+    while (last < _submit_list.size()) {
+        auto cmd = std::get_if<SpriteCMD>(&_submit_list[last]);
+        if (!cmd || cmd->_sprite != texture) break;
+        ++last;
+    }
+    // 单个精灵或无效纹理无需合批，直接按原方式绘制
+    if (last - first == 1 || !texture) {
+        for (size_t i = first; i < last; ++i) execCommand(_submit_list[i]);
+        return last;
+    }
+    float tex_w = 0, tex_h = 0;
+    SDL_GetTextureSize(texture, &tex_w, &tex_h);
+    const size_t count = last - first;
+    _batch_vertices.resize(count * 4);
+    _batch_indices.resize(count * 6);
+    for (size_t i = 0; i < count; ++i) {
+        std::get<SpriteCMD>(_submit_list[first + i]).vertices(&_batch_vertices[i * 4], tex_w, tex_h);
+        const int v = static_cast<int>(i * 4);
+        int* idx = &_batch_indices[i * 6];
+        idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v; idx[4] = v + 2; idx[5] = v + 3;
+    }
+    // 颜色及透明度已写入顶点，需重置纹理本身的调制值
+    SDL_SetTextureColorMod(texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(texture, 255);
+    SDL_RenderGeometry(_window->renderer, texture, _batch_vertices.data(), static_cast<int>(_batch_vertices.size()),
+                       _batch_indices.data(), static_cast<int>(_batch_indices.size()));
+    _draw_calls_saved += static_cast<uint32_t>(count - 1);
+    return last;
+}
+
+void EasyEngine::Painter::sortSpriteRange(size_t first, size_t last) {
+    // 每个精灵向后查找同纹理精灵的最大距离，用于限制排序开销
+    constexpr size_t SORT_WINDOW = 32;
+    if (last - first < 3) return;
+    _sort_bounds.resize(last - first);
+    SDL_Vertex quad[4];
+    for (size_t i = first; i < last; ++i) {
+        std::get<SpriteCMD>(command_list[i]).vertices(quad, 0, 0);
+        float min_x = quad[0].position.x, max_x = min_x, min_y = quad[0].position.y, max_y = min_y;
+        for (auto& v : quad) {
+            min_x = std::min(min_x, v.position.x); max_x = std::max(max_x, v.position.x);
+            min_y = std::min(min_y, v.position.y); max_y = std::max(max_y, v.position.y);
+        }
+        _sort_bounds[i - first] = {min_x, min_y, max_x - min_x, max_y - min_y};
+    }
+    auto is_overlapped = [this, first](size_t a, size_t b) {
+        auto& r1 = _sort_bounds[a - first];
+        auto& r2 = _sort_bounds[b - first];
+        return r1.x < r2.x + r2.w && r2.x < r1.x + r1.w && r1.y < r2.y + r2.h && r2.y < r1.y + r1.h;
+    };
+    for (size_t i = first; i + 2 < last; ++i) {
+        auto texture = std::get<SpriteCMD>(command_list[i])._sprite;
+        size_t limit = std::min(last, i + 1 + SORT_WINDOW);
+        for (size_t j = i + 1; j < limit; ++j) {
+            if (std::get<SpriteCMD>(command_list[j])._sprite != texture) continue;
+            if (j == i + 1) break;
+            // 仅当与被跨越的所有精灵均不重叠时，才允许前移，以保证绘制结果不变
+            bool movable = true;
+            for (size_t k = i + 1; k < j; ++k) {
+                if (is_overlapped(j, k)) { movable = false; break; }
+            }
+            if (!movable) continue;
+            std::rotate(command_list.begin() + (int64_t)(i + 1), command_list.begin() + (int64_t)j,
+                        command_list.begin() + (int64_t)(j + 1));
+            std::rotate(_sort_bounds.begin() + (int64_t)(i + 1 - first), _sort_bounds.begin() + (int64_t)(j - first),
+                        _sort_bounds.begin() + (int64_t)(j + 1 - first));
+            break;
+        }
     }
-    SDL_RenderPresent(_window->renderer);
-    command_list.clear();
-    paintEvent();
 }
 
 void EasyEngine::Painter::fillBackColor(const SDL_Color &color) {
-    command_list.emplace_back(std::make_unique<FillCMD>(color));
+    command_list.emplace_back(std::in_place_type<FillCMD>, color);
 }
 
 void EasyEngine::Painter::drawPoint(const EasyEngine::Graphics::Point &point) {
-    command_list.emplace_back(std::make_unique<PointCMD>(point));
+    command_list.emplace_back(std::in_place_type<PointCMD>, point);
 }
 
 void EasyEngine::Painter::drawLine(const EasyEngine::Graphics::Line &line) {
-    command_list.emplace_back(std::make_unique<LineCMD>(line));
+    command_list.emplace_back(std::in_place_type<LineCMD>, line);
 }
 
 void EasyEngine::Painter::drawRectangle(const EasyEngine::Graphics::Rectangle &rect) {
-    command_list.emplace_back(std::make_unique<RectCMD>(rect));
+    command_list.emplace_back(std::in_place_type<RectCMD>, rect);
 }
 
 void EasyEngine::Painter::drawEllipse(const EasyEngine::Graphics::Ellipse &ellipse) {
-    command_list.emplace_back(std::make_unique<EllipseCMD>(ellipse));
+    command_list.emplace_back(std::in_place_type<EllipseCMD>, ellipse);
 }
 
 void EasyEngine::Painter::drawSprite(const Components::Sprite &sprite, const Vector2 &pos) {
-    auto spriteCMD = new SpriteCMD(sprite, pos);
+    auto spriteCMD = &std::get<SpriteCMD>(command_list.emplace_back(std::in_place_type<SpriteCMD>, sprite, pos));
     spriteCMD->_pos = pos + sprite.properties()->position;
     spriteCMD->_is_clip = sprite.properties()->clip_mode;
     spriteCMD->_clip_pos = sprite.properties()->clip_pos;
@@ -717,12 +1590,12 @@ void EasyEngine::Painter::drawSprite(const Components::Sprite &sprite, const Vec
                              (sprite.properties()->flip_mode == Components::Sprite::FlipMode::VFlip ? SDL_FLIP_VERTICAL
                                                                                                 : SDL_FLIP_HORIZONTAL));
     spriteCMD->_color_alpha = sprite.properties()->color_alpha;
-    command_list.emplace_back(std::unique_ptr<SpriteCMD>(spriteCMD));
 }
 
 void EasyEngine::Painter::drawSprite(const Components::Sprite &sprite,
                                      const Components::Sprite::Properties &properties) {
-    auto spiritCmd = new SpriteCMD(sprite, properties.position);
+    auto spiritCmd = &std::get<SpriteCMD>(command_list.emplace_back(std::in_place_type<SpriteCMD>,
+                                                                    sprite, properties.position));
     spiritCmd->_is_clip = properties.clip_mode;
     spiritCmd->_clip_pos = properties.clip_pos;
     spiritCmd->_clip_size = properties.clip_size;
@@ -734,12 +1607,12 @@ void EasyEngine::Painter::drawSprite(const Components::Sprite &sprite,
                              (properties.flip_mode == Components::Sprite::FlipMode::VFlip ? SDL_FLIP_VERTICAL
                                                                                     : SDL_FLIP_HORIZONTAL));
     spiritCmd->_color_alpha = properties.color_alpha;
-    command_list.emplace_back(std::unique_ptr<SpriteCMD>(spiritCmd));
 }
 
 void EasyEngine::Painter::drawSprite(const EasyEngine::Components::Sprite &sprite,
                                      const EasyEngine::Components::Sprite::Properties *properties) {
-    auto spiritCmd = new SpriteCMD(sprite, properties->position);
+    auto spiritCmd = &std::get<SpriteCMD>(command_list.emplace_back(std::in_place_type<SpriteCMD>,
+                                                                    sprite, properties->position));
     spiritCmd->_is_clip = properties->clip_mode;
     spiritCmd->_clip_pos = properties->clip_pos;
     spiritCmd->_clip_size = properties->clip_size;
@@ -750,19 +1623,53 @@ void EasyEngine::Painter::drawSprite(const EasyEngine::Components::Sprite &sprit
     spiritCmd->_flip_mode = (properties->flip_mode == Components::Sprite::FlipMode::None ? SDL_FLIP_NONE :
             (properties->flip_mode == Components::Sprite::FlipMode::VFlip ? SDL_FLIP_VERTICAL : SDL_FLIP_HORIZONTAL));
     spiritCmd->_color_alpha = properties->color_alpha;
-    command_list.emplace_back(std::unique_ptr<SpriteCMD>(spiritCmd));
 }
 
 void EasyEngine::Painter::drawPixelText(const std::string &text, const EasyEngine::Vector2 &pos,
                                         const EasyEngine::Size &size, const SColor &color) {
-    auto pixelTextCmd = new PixelTextCMD({pos, size}, color, text);
-    pixelTextCmd->pos.x /= size.width;
-    pixelTextCmd->pos.y /= size.height;
-    command_list.emplace_back(std::unique_ptr<PixelTextCMD>(pixelTextCmd));
+    auto offset = _text_buffer.size();
+    _text_buffer.append(text);
+    _text_buffer.push_back('\0');
+    auto& pixelTextCmd = std::get<PixelTextCMD>(command_list.emplace_back(
+            std::in_place_type<PixelTextCMD>, GeometryF{pos, size}, color, offset));
+    pixelTextCmd.pos.x /= size.width;
+    pixelTextCmd.pos.y /= size.height;
 }
 
 void EasyEngine::Painter::clear() {
     command_list.clear();
+    _text_buffer.clear();
+}
+
+void EasyEngine::Painter::setSpriteBatchEnabled(bool enabled) {
+    _sprite_batch_enabled = enabled;
+}
+
+bool EasyEngine::Painter::spriteBatchEnabled() const {
+    return _sprite_batch_enabled;
+}
+
+uint32_t EasyEngine::Painter::drawCallsSaved() const {
+    return _draw_calls_saved;
+}
+
+void EasyEngine::Painter::_beginSortRange() {
+    _sort_range_start = command_list.size();
+    _is_sorting = true;
+}
+
+void EasyEngine::Painter::_endSortRange() {
+    if (!_is_sorting) return;
+    _is_sorting = false;
+    if (!_sprite_batch_enabled) return;
+    const size_t end = command_list.size();
+    for (size_t i = _sort_range_start; i < end;) {
+        if (!std::holds_alternative<SpriteCMD>(command_list[i])) { ++i; continue; }
+        size_t seg_end = i;
+        while (seg_end < end && std::holds_alternative<SpriteCMD>(command_list[seg_end])) ++seg_end;
+        sortSpriteRange(i, seg_end);
+        i = seg_end;
+    }
 }
 
 void EasyEngine::Painter::installPaintEvent(std::function<void(Painter&)> function) {
@@ -774,13 +1681,11 @@ void EasyEngine::Painter::setSceneManager(EasyEngine::SceneManager *sceneManager
 }
 
 void EasyEngine::Painter::setViewport(const Geometry &geometry, const Size &size) {
-    auto cmd = new ViewportCMD(geometry, false, size);
-    command_list.emplace_back(std::unique_ptr<ViewportCMD>(cmd));
+    command_list.emplace_back(std::in_place_type<ViewportCMD>, geometry, false, size);
 }
 
 void EasyEngine::Painter::setClipView(const Geometry &geometry) {
-    auto cmd = new ViewportCMD(geometry, true);
-    command_list.emplace_back(std::unique_ptr<ViewportCMD>(cmd));
+    command_list.emplace_back(std::in_place_type<ViewportCMD>, geometry, true);
 }
 
 void EasyEngine::Painter::drawText(TTF_Text *text, const EasyEngine::Vector2 &position) {
@@ -788,8 +1693,7 @@ void EasyEngine::Painter::drawText(TTF_Text *text, const EasyEngine::Vector2 &po
         SDL_Log("[ERROR] The specified text is not valid!");
         return;
     }
-    auto cmd = new TextCMD(position, text);
-    command_list.emplace_back(std::unique_ptr<TextCMD>(cmd));
+    command_list.emplace_back(std::in_place_type<TextCMD>, position, text);
 }
 
 bool EasyEngine::Painter::_addTransition(EasyEngine::Transition::AbstractTransition *transition) {
@@ -841,7 +1745,7 @@ bool EasyEngine::Painter::_stopEasingCurve(const std::shared_ptr<EasingCurve::Ab
     return _ret > 0;
 }
 
-void EasyEngine::Painter::PointCMD::exec(SRenderer *renderer, uint32_t thickness) {
+void EasyEngine::Painter::PointCMD::exec(SRenderer *renderer, uint32_t thickness) const {
     if (thickness > 1) {
         filledCircleRGBA(renderer, pt.pos.x, pt.pos.y, thickness - 1, pt.color.r, pt.color.g, pt.color.b, pt.color.a);
     } else {
@@ -850,7 +1754,7 @@ void EasyEngine::Painter::PointCMD::exec(SRenderer *renderer, uint32_t thickness
     }
 }
 
-void EasyEngine::Painter::LineCMD::exec(SRenderer *renderer, uint32_t thickness) {
+void EasyEngine::Painter::LineCMD::exec(SRenderer *renderer, uint32_t thickness) const {
     if (line.width > 1) {
         thickLineRGBA(renderer, line.start.x, line.start.y, line.end.x, line.end.y, line.width,
                  line.color.r, line.color.g, line.color.b, line.color.a);
@@ -861,7 +1765,7 @@ void EasyEngine::Painter::LineCMD::exec(SRenderer *renderer, uint32_t thickness)
     }
 }
 
-void EasyEngine::Painter::RectCMD::exec(SRenderer *renderer, uint32_t thickness) {
+void EasyEngine::Painter::RectCMD::exec(SRenderer *renderer, uint32_t thickness) const {
     SDL_FRect r = {rect.pos.x, rect.pos.y, rect.size.width, rect.size.height},
               rb = {rect.pos.x - thickness + 1, rect.pos.y - thickness + 1,
                     rect.size.width + (float)((thickness - 1) * 2),
@@ -895,7 +1799,7 @@ void EasyEngine::Painter::RectCMD::exec(SRenderer *renderer, uint32_t thickness)
     }
 }
 
-void EasyEngine::Painter::EllipseCMD::exec(SRenderer *renderer, uint32_t thickness) {
+void EasyEngine::Painter::EllipseCMD::exec(SRenderer *renderer, uint32_t thickness) const {
     auto tmp_thickness = static_cast<int16_t>(thickness);
     auto t_area_w = static_cast<int16_t>(ellipse.area.width),
          t_area_h = static_cast<int16_t>(ellipse.area.height);
@@ -925,12 +1829,12 @@ void EasyEngine::Painter::EllipseCMD::exec(SRenderer *renderer, uint32_t thickne
     }
 }
 
-void EasyEngine::Painter::FillCMD::exec(SRenderer *renderer, uint32_t) {
+void EasyEngine::Painter::FillCMD::exec(SRenderer *renderer, uint32_t) const {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
     SDL_RenderClear(renderer);
 }
 
-void EasyEngine::Painter::SpriteCMD::exec(SRenderer *renderer, uint32_t) {
+void EasyEngine::Painter::SpriteCMD::exec(SRenderer *renderer, uint32_t) const {
     SDL_SetTextureColorMod(_sprite, _color_alpha.r, _color_alpha.g, _color_alpha.b);
     SDL_SetTextureAlphaMod(_sprite, _color_alpha.a);
     Vector2 _global_center_pos(_pos.x + _scaled_center.x, _pos.y + _scaled_center.y);
@@ -940,25 +1844,65 @@ void EasyEngine::Painter::SpriteCMD::exec(SRenderer *renderer, uint32_t) {
     SDL_FPoint center = {_rotate_center.x * _scaled, _rotate_center.y * _scaled};
     SDL_FRect _dst = {newPos.x, newPos.y, newScaled.x, newScaled.y};
 
+    SDL_FRect _src;
+    SDL_RenderTextureRotated(renderer, _sprite, (sourceRect(&_src) ? &_src : nullptr), &_dst,
+                             _rotate, &center, _flip_mode);
+}
+
+bool EasyEngine::Painter::SpriteCMD::sourceRect(SDL_FRect *rect) const {
     if (_is_clip) {
-        SDL_FRect _tmp = {_clip_pos.x, _clip_pos.y, _clip_size.width, _clip_size.height};
-        SDL_RenderTextureRotated(renderer, _sprite, &_tmp, &_dst,
-                                 _rotate, &center, _flip_mode);
-    } else {
-        SDL_RenderTextureRotated(renderer, _sprite, nullptr, &_dst,
-                                 _rotate, &center, _flip_mode);
+        *rect = {_src_pos.x + _clip_pos.x, _src_pos.y + _clip_pos.y, _clip_size.width, _clip_size.height};
+        return true;
+    }
+    if (_has_src) {
+        *rect = {_src_pos.x, _src_pos.y, _src_size.width, _src_size.height};
+        return true;
     }
+    return false;
 }
 
-void EasyEngine::Painter::PixelTextCMD::exec(SRenderer *renderer, uint32_t) {
+void EasyEngine::Painter::SpriteCMD::vertices(SDL_Vertex *vertices, float tex_w, float tex_h) const {
+    Vector2 _global_center_pos(_pos.x + _scaled_center.x, _pos.y + _scaled_center.y);
+    Vector2 newPos((_pos.x - _global_center_pos.x) * _scaled + _global_center_pos.x,
+                   (_pos.y - _global_center_pos.y) * _scaled + _global_center_pos.y);
+    const float w = _size.width * _scaled, h = _size.height * _scaled;
+    const float cx = _rotate_center.x * _scaled, cy = _rotate_center.y * _scaled;
+    // 与 SDL_RenderTextureRotated 一致：以 center 为中心顺时针旋转
+    const double rad = _rotate * SDL_PI_D / 180.0;
+    const auto c = static_cast<float>(std::cos(rad)), s = static_cast<float>(std::sin(rad));
+    const float local[4][2] = {{0, 0}, {w, 0}, {w, h}, {0, h}};
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    SDL_FRect src;
+    if (tex_w > 0 && tex_h > 0 && sourceRect(&src)) {
+        u0 = src.x / tex_w;
+        v0 = src.y / tex_h;
+        u1 = (src.x + src.w) / tex_w;
+        v1 = (src.y + src.h) / tex_h;
+    }
+    if (_flip_mode & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+    if (_flip_mode & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+    const float uv[4][2] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+    const SDL_FColor color = {_color_alpha.r / 255.0f, _color_alpha.g / 255.0f,
+                              _color_alpha.b / 255.0f, _color_alpha.a / 255.0f};
+    for (int i = 0; i < 4; ++i) {
+        const float dx = local[i][0] - cx, dy = local[i][1] - cy;
+        vertices[i].position = {newPos.x + cx + dx * c - dy * s, newPos.y + cy + dx * s + dy * c};
+        vertices[i].color = color;
+        vertices[i].tex_coord = {uv[i][0], uv[i][1]};
+    }
+}
+
+void EasyEngine::Painter::PixelTextCMD::exec(SRenderer *renderer, const char* text) const {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, SDL_ALPHA_OPAQUE);
-    
-    SDL_SetRenderScale(renderer, size.width, size.height);
-    SDL_RenderDebugText(renderer, pos.x, pos.y, text.c_str());
-    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+    // 在当前缩放（视图缩放、渲染分辨率比例）的基础上缩放文本，绘制后恢复
+    float scale_x = 1.0f, scale_y = 1.0f;
+    SDL_GetRenderScale(renderer, &scale_x, &scale_y);
+    SDL_SetRenderScale(renderer, scale_x * size.width, scale_y * size.height);
+    SDL_RenderDebugText(renderer, pos.x, pos.y, text);
+    SDL_SetRenderScale(renderer, scale_x, scale_y);
 }
 
-void EasyEngine::Painter::ViewportCMD::exec(SRenderer* renderer, uint32_t) {
+void EasyEngine::Painter::ViewportCMD::exec(SRenderer* renderer, uint32_t) const {
     SDL_Rect rect = {geometry.x, geometry.y, geometry.width, geometry.height};
     bool is_invalid = (rect.w <= 0 || rect.h <= 0);
     if (is_clipped_mode) {
@@ -969,7 +1913,7 @@ void EasyEngine::Painter::ViewportCMD::exec(SRenderer* renderer, uint32_t) {
     }
 }
 
-void EasyEngine::Painter::TextCMD::exec(SRenderer *renderer, uint32_t thickness) {
+void EasyEngine::Painter::TextCMD::exec(SRenderer *renderer, uint32_t thickness) const {
     TTF_DrawRendererText(text, position.x, position.y);
 }
 
@@ -991,98 +1935,123 @@ bool EasyEngine::EventSystem::handlerEnabled() const { return _handler_trigger;
 bool EasyEngine::EventSystem::handler() {
     static SEvent ev;
     static bool ret = true;
-    if (SDL_PollEvent(&ev)) {
-        if (ev.window.type == SDL_EVENT_QUIT) {
-            return false;
-        }
-        if (ev.window.type == SDL_EVENT_WINDOW_FOCUS_LOST) {
-            Engine::_is_stopped = true;
-
-        } else if (ev.window.type == SDL_EVENT_WINDOW_FOCUS_GAINED) {
-            Engine::_is_stopped = false;
-        }
+    auto replay = Replay::global();
+    if (!replay->_beginFrame()) return false;
+    {
+        EASYENGINE_PROFILE_ZONE("Events");
+        while (replay->isPlaying() ? replay->_pollEvent(&ev) : SDL_PollEvent(&ev)) {
+            if (replay->isRecording()) replay->_recordEvent(ev);
+            if (ev.window.type == SDL_EVENT_QUIT) {
+                return false;
+            }
+            if (ev.window.type == SDL_EVENT_WINDOW_FOCUS_LOST) {
+                Engine::_is_stopped = true;
+
+            } else if (ev.window.type == SDL_EVENT_WINDOW_FOCUS_GAINED) {
+                Engine::_is_stopped = false;
+            } else if (ev.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+                // 渲染设备重置后，所有纹理均已失效，由主循环按绘制器逐个恢复
+                _render_device_reset = true;
+            }
 
-        if (_handler_trigger) {
-            Vector2 cursor_pos = Cursor::global()->position();
-            const uint64_t CLICK_DELAY = 500;
-            for (auto &_control: _control_list) {
-                auto _container = _control.second;
-                if (!_container->enabled()) continue;
-                if (_container->active() &&
-                    (ev.key.key == SDLK_SPACE || ev.key.key == SDLK_RETURN || ev.key.key == SDLK_KP_ENTER)) {
-                    static bool _is_key_down = false;
-                    if (ev.key.down) {
-                        if (!_is_key_down) {
-                            _container->__updateEvent(Components::Control::Event::KeyDown);
-                            _container->__updateStatus(Components::Control::Status::Pressed);
-                            _is_key_down = true;
-                        }
-                    } else {
-                        _is_key_down = false;
-                        _container->__updateEvent(Components::Control::Event::KeyUp);
-                        _container->__updateEvent(Components::Control::Event::KeyPressed);
-                        _container->__updateStatus(Components::Control::Status::Active);
-                    }
-                    continue;
-                }
-                bool is_cursor_on_control = Algorithm::comparePosRect(cursor_pos, _container->hotArea()) > -1;
-                static bool is_hovered_one = false;
-                static uint64_t last_click_time = 0, current_click_time = 0, click_count = 0;
-                static Vector2 old_cursor_pos = cursor_pos;
-                if (is_cursor_on_control) {
-                    if (!is_hovered_one) {
-                        is_hovered_one = true;
-                        _container->__updateEvent(Components::Control::Event::MouseHover);
-                        _container->__updateStatus(Components::Control::Status::Hovered);
-                    } else if (ev.button.type == SDL_EVENT_MOUSE_BUTTON_DOWN && is_hovered_one) {
-                        _container->__updateEvent(Components::Control::Event::MouseDown);
-                        _container->__updateStatus(Components::Control::Status::Pressed);
-                        old_cursor_pos = cursor_pos;
-                    } else if (_container->__currentStatus() == Components::Control::Status::Pressed) {
-                        current_click_time = SDL_GetTicks();
-                        if (!last_click_time) {
-                            last_click_time = current_click_time;
-                            click_count += 1;
-                        } else if (current_click_time - last_click_time < CLICK_DELAY) {
-                            click_count += 1;
+            if (_handler_trigger) {
+                Vector2 cursor_pos = Cursor::global()->position();
+                const uint64_t CLICK_DELAY = 500;
+                for (auto &_control: _control_list) {
+                    auto _container = _control.second;
+                    if (!_container->enabled()) continue;
+                    if (_container->active() &&
+                        (ev.key.key == SDLK_SPACE || ev.key.key == SDLK_RETURN || ev.key.key == SDLK_KP_ENTER)) {
+                        static bool _is_key_down = false;
+                        if (ev.key.down) {
+                            if (!_is_key_down) {
+                                _container->__updateEvent(Components::Control::Event::KeyDown);
+                                _container->__updateStatus(Components::Control::Status::Pressed);
+                                _is_key_down = true;
+                            }
                         } else {
-                            last_click_time = current_click_time;
-                            click_count = 1;
+                            _is_key_down = false;
+                            _container->__updateEvent(Components::Control::Event::KeyUp);
+                            _container->__updateEvent(Components::Control::Event::KeyPressed);
+                            _container->__updateStatus(Components::Control::Status::Active);
                         }
-                        if (click_count == 1) {
-                            _container->__updateEvent(Components::Control::Event::Clicked);
-                        } else if (click_count == 2) {
-                            _container->__updateEvent(Components::Control::Event::DblClicked);
-                        } else {
-                            _container->__updateEvent(Components::Control::Event::MouseUp);
+                        continue;
+                    }
+                    bool is_cursor_on_control = Algorithm::comparePosRect(cursor_pos, _container->hotArea()) > -1;
+                    static bool is_hovered_one = false;
+                    static uint64_t last_click_time = 0, current_click_time = 0, click_count = 0;
+                    static Vector2 old_cursor_pos = cursor_pos;
+                    if (is_cursor_on_control) {
+                        if (!is_hovered_one) {
+                            is_hovered_one = true;
+                            _container->__updateEvent(Components::Control::Event::MouseHover);
+                            _container->__updateStatus(Components::Control::Status::Hovered);
+                        } else if (ev.button.type == SDL_EVENT_MOUSE_BUTTON_DOWN && is_hovered_one) {
+                            _container->__updateEvent(Components::Control::Event::MouseDown);
+                            _container->__updateStatus(Components::Control::Status::Pressed);
+                            old_cursor_pos = cursor_pos;
+                        } else if (_container->__currentStatus() == Components::Control::Status::Pressed) {
+                            current_click_time = Algorithm::getTimeMillisec();
+                            if (!last_click_time) {
+                                last_click_time = current_click_time;
+                                click_count += 1;
+                            } else if (current_click_time - last_click_time < CLICK_DELAY) {
+                                click_count += 1;
+                            } else {
+                                last_click_time = current_click_time;
+                                click_count = 1;
+                            }
+                            if (click_count == 1) {
+                                _container->__updateEvent(Components::Control::Event::Clicked);
+                            } else if (click_count == 2) {
+                                _container->__updateEvent(Components::Control::Event::DblClicked);
+                            } else {
+                                _container->__updateEvent(Components::Control::Event::MouseUp);
+                            }
+                            _container->__updateStatus(Components::Control::Status::Hovered);
                         }
-                        _container->__updateStatus(Components::Control::Status::Hovered);
+                    } else if (_container->__currentStatus() == Components::Control::Status::Hovered) {
+                        is_hovered_one = false;
+                        _container->__updateEvent(Components::Control::Event::MouseLeave);
+                        _container->__updateStatus(_container->active() ?
+                                                   Components::Control::Status::Active
+                                                                        : Components::Control::Status::Default);
+                    } else if (_container->__currentStatus() == Components::Control::Status::Pressed) {
+                        is_hovered_one = false;
+                        _container->__updateEvent(Components::Control::Event::MouseLeave);
+                        _container->__updateStatus(_container->active() ?
+                                                   Components::Control::Status::Active
+                                                                        : Components::Control::Status::Default);
                     }
-                } else if (_container->__currentStatus() == Components::Control::Status::Hovered) {
-                    is_hovered_one = false;
-                    _container->__updateEvent(Components::Control::Event::MouseLeave);
-                    _container->__updateStatus(_container->active() ?
-                                               Components::Control::Status::Active
-                                                                    : Components::Control::Status::Default);
-                } else if (_container->__currentStatus() == Components::Control::Status::Pressed) {
-                    is_hovered_one = false;
-                    _container->__updateEvent(Components::Control::Event::MouseLeave);
-                    _container->__updateStatus(_container->active() ?
-                                               Components::Control::Status::Active
-                                                                    : Components::Control::Status::Default);
                 }
-            }
-            if (_my_event_handler) {
-                ret = _my_event_handler(ev);
+                if (_my_event_handler) {
+                    ret = _my_event_handler(ev);
+                }
             }
         }
     }
-
-    for (auto& _timer : _timer_list) {
-        _timer.second->______();
+    {
+        std::lock_guard<std::mutex> lock(_task_mutex);
+        _running_tasks.swap(_task_queue);
     }
-    for (auto& _trigger : _trigger_list) {
-        _trigger.second->______();
+    if (!_running_tasks.empty()) {
+        EASYENGINE_PROFILE_ZONE("Tasks");
+        for (auto& _task : _running_tasks) {
+            _task();
+        }
+        _running_tasks.clear();
+    }
+    {
+        EASYENGINE_PROFILE_ZONE("Timers");
+        for (auto& _timer : _timer_list) {
+            _timer.second->______();
+        }
+    }
+    {
+        EASYENGINE_PROFILE_ZONE("Triggers");
+        for (auto& _trigger : _trigger_list) {
+            _trigger.second->______();
+        }
     }
 //    for (auto& _scene_mgr : _scene_mgr_list) {
 //         _scene_mgr.second->______();
@@ -1090,6 +2059,38 @@ bool EasyEngine::EventSystem::handler() {
     return ret;
 }
 
+void EasyEngine::EventSystem::postTask(std::function<void()> task) {
+    if (!task) return;
+    {
+        std::lock_guard<std::mutex> lock(_task_mutex);
+        _task_queue.push_back(std::move(task));
+    }
+    // 唤醒可能正在等待事件的主循环
+    static const uint32_t wake_event = SDL_RegisterEvents(1);
+    if (wake_event) {
+        SEvent ev{};
+        ev.type = wake_event;
+        SDL_PushEvent(&ev);
+    }
+}
+
+uint64_t EasyEngine::EventSystem::idleTimeoutNS() {
+    {
+        std::lock_guard<std::mutex> lock(_task_mutex);
+        if (!_task_queue.empty()) return 0;
+    }
+    uint64_t timeout_ms = UINT64_MAX;
+    for (auto& _timer : _timer_list) {
+        timeout_ms = std::min(timeout_ms, _timer.second->remaining());
+    }
+    // 触发器需要持续检查条件，无法预知何时触发，保持 1ms 的检查间隔
+    for (auto& _trigger : _trigger_list) {
+        if (_trigger.second->enabled()) timeout_ms = std::min<uint64_t>(timeout_ms, 1);
+    }
+    if (timeout_ms == UINT64_MAX) return UINT64_MAX;
+    return timeout_ms * 1000000ULL;
+}
+
 void EasyEngine::EventSystem::cleanUp() {
     clearTimer();
     clearTrigger();
@@ -1348,7 +2349,7 @@ int16_t EasyEngine::AudioSystem::loadBGM(const Components::BGM &bgm) {
                 unloadBGM(ret);
             }
             ch.status = Audio::Loading;
-            ch.audio = MIX_LoadAudio(_bgm_mixer, bgm.path().data(), false);
+            ch.audio = MIX_LoadAudio_IO(_bgm_mixer, ResourceSystem::global()->openIO(bgm.path()), false, true);
             if (!ch.audio) {
                 SDL_Log("[ERROR] Failed to load BGM: %s\n        Code: %s", bgm.path().data(), SDL_GetError());
                 ch.status = Audio::Failed;
@@ -1385,7 +2386,7 @@ int16_t EasyEngine::AudioSystem::loadSFX(const Components::SFX &sfx) {
                 unloadSFX(ret);
             }
             ch.status = Audio::Loading;
-            ch.audio = MIX_LoadAudio(_bgm_mixer, sfx.path().data(), true);
+            ch.audio = MIX_LoadAudio_IO(_bgm_mixer, ResourceSystem::global()->openIO(sfx.path()), true, true);
             if (!ch.audio) {
                 SDL_Log("[ERROR] Failed to load SFX: %s\n        Code: %s", sfx.path().data(), SDL_GetError());
                 ch.status = Audio::Failed;
@@ -1632,6 +2633,7 @@ void EasyEngine::TextSystem::addText(const std::string &text_name, const std::st
                 "p.s: Try to use `load()` function at first!");
         throw std::runtime_error("[FATAL] Current Text system is not initialized!\n");
     }
+    auto lock = lockRenderer();
     TTF_Text* new_text = TTF_CreateText(_text_engine, _font_info.at(font_name)->TTF_font(), text.c_str(), text.size());
     _text_list.emplace(text_name, new_text);
 }
@@ -1641,7 +2643,8 @@ void EasyEngine::TextSystem::removeText(const std::string &text_name) {
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
-    TTF_DestroyText(_text_list.at(text_name));
+    auto text = _text_list.at(text_name);
+    Painter::_deferRelease(_painter, [text] { TTF_DestroyText(text); });
     _text_list.erase(text_name);
 }
 
@@ -1650,6 +2653,7 @@ void EasyEngine::TextSystem::appendText(const std::string &text_name, const std:
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_AppendTextString(_text_list.at(text_name), append_text.c_str(), append_text.size());
 }
 
@@ -1658,6 +2662,7 @@ void EasyEngine::TextSystem::appendText(const std::string &text_name, const char
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     char chs[2] = {'\0'};
     chs[0] = ch;
     TTF_AppendTextString(_text_list.at(text_name), chs, 2);
@@ -1668,6 +2673,7 @@ void EasyEngine::TextSystem::modifyText(const std::string &text_name, const std:
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_SetTextString(_text_list.at(text_name), text.c_str(), text.size());
 }
 
@@ -1676,6 +2682,7 @@ void EasyEngine::TextSystem::clearText(const std::string &text_name) {
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_SetTextString(_text_list.at(text_name), "", 0);
 }
 
@@ -1697,6 +2704,7 @@ void EasyEngine::TextSystem::setTextFont(const std::string &text_name, const std
                 font_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_SetTextFont(_text_list.at(text_name), _font_info.at(font_name)->TTF_font());
 }
 
@@ -1705,6 +2713,7 @@ void EasyEngine::TextSystem::setTextColor(const std::string &text_name, const SC
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_SetTextColor(_text_list.at(text_name),
                      text_color.r, text_color.g, text_color.b, text_color.a);
 }
@@ -1714,6 +2723,7 @@ void EasyEngine::TextSystem::setTextWrapWidth(const std::string &text_name, int
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     TTF_SetTextWrapWidth(_text_list.at(text_name), width);
 }
 
@@ -1723,17 +2733,26 @@ void EasyEngine::TextSystem::setTextDirection(const std::string &text_name,
         SDL_Log("[ERROR] The specified text name '%s' is not exist!", text_name.c_str());
         return;
     }
+    auto lock = lockRenderer();
     auto real_direction = static_cast<TTF_Direction>(direction);
     TTF_SetTextDirection(_text_list.at(text_name), real_direction);
 }
 
+std::unique_lock<std::recursive_mutex> EasyEngine::TextSystem::lockRenderer() const {
+    if (!_painter) return {};
+    return _painter->lockRenderer();
+}
+
 void EasyEngine::TextSystem::renderText(const std::string &text_name, const Vector2 &position) {
     if (!_text_list.contains(text_name)) {
         SDL_Log("[FATAL] The specified text name '%s' is not exist!", text_name.c_str());
         throw std::runtime_error(fmt::format("[FATAL] The specified text name '{}' is not exist!",
                                              text_name.c_str()));
     }
-    TTF_UpdateText(_text_list.at(text_name));
+    {
+        auto lock = lockRenderer();
+        TTF_UpdateText(_text_list.at(text_name));
+    }
     _painter->drawText(_text_list.at(text_name), position);
 }
 
@@ -1743,6 +2762,7 @@ EasyEngine::Size EasyEngine::TextSystem::textAreaSize(const std::string &text_na
         return {0, 0};
     }
     int w, h;
+    auto lock = lockRenderer();
     TTF_GetTextSize(_text_list.at(text_name), &w, &h);
     return {static_cast<float>(w), static_cast<float>(h)};
 }
@@ -18,6 +18,10 @@
 #include "Components.h"
 #include "Resources.h"
 #include "Scene.h"
+#include "Collision.h"
+#include "Profiler.h"
+#include "Capture.h"
+#include "Replay.h"
 
 /// 主版本号（重大功能更新）
 #define EASYENGINE_MAJOR_VERSION 1
@@ -269,14 +273,58 @@ namespace EasyEngine {
      */
     class Engine {
     public:
+        /**
+         * @struct PacingStats
+         * @brief 自适应帧节奏的统计信息
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        struct PacingStats {
+            /// 最近若干帧渲染耗时的百分位数（毫秒）
+            float percentile_time{0.0f};
+            /// 触发降级的渲染耗时阈值（毫秒），由 `frameDropTolerance()` 决定
+            float threshold_time{0.0f};
+            /// 当前渲染分辨率比例
+            float render_scale{1.0f};
+            /// 当前画质等级（0 为最高画质）
+            uint32_t quality_tier{0};
+            /// 累计降级次数
+            uint64_t downgrades{0};
+            /// 累计升级次数
+            uint64_t upgrades{0};
+            /// 累计丢弃的帧数
+            uint64_t dropped_frames{0};
+        };
+        /**
+         * @struct FrameTiming
+         * @brief 单帧的耗时记录
+         * @see frameTimings
+         * @since v1.1.0-alpha
+         */
+        struct FrameTiming {
+            /// 帧序号（从 0 开始）
+            uint64_t frame{0};
+            /// 自 `exec()` 开始至本帧开始的时间（毫秒）
+            float start_time{0.0f};
+            /// 本帧的渲染耗时（毫秒）
+            float render_time{0.0f};
+            /// 与上一帧开始之间的间隔（毫秒）
+            float interval{0.0f};
+        };
         /**
          * @brief 定义窗口并初始化引擎资源
          * @param title 窗口标题
          * @param width 窗口宽度（像素）
          * @param height 窗口高度（像素）
+         * @param headless 是否以无窗口模式运行（默认为 false）
          * @return 是否已初始化引擎
+         *
+         * 无窗口模式下使用 SDL 的 dummy 视频及音频驱动，并以软件渲染器离屏绘制，
+         * 不会显示任何窗口，适用于自动化性能测试及持续集成环境。
+         * @see isHeadless
+         * @see setFrameLimit
          */
-        explicit Engine(const std::string& title, uint32_t width = 800, uint32_t height = 600);
+        explicit Engine(const std::string& title, uint32_t width = 800, uint32_t height = 600, bool headless = false);
         ~Engine();
         /**
          * @brief 启动主事件循环
@@ -521,6 +569,133 @@ namespace EasyEngine {
          * @see frameDropTolerance
          */
         uint32_t frameDropThreshold() const;
+        /**
+         * @brief 设置是否启用自适应帧节奏
+         * @param enabled 启用/禁用（默认禁用）
+         *
+         * 启用后，引擎持续统计最近若干帧渲染耗时的百分位数：
+         * @note 1. 当其超过 `frameDropTolerance()` 对应的阈值时，先逐级降低画质等级（仅在安装了 `installPacingEvent()` 时），再逐步降低渲染分辨率；
+         * @note 2. 当其低于目标帧时长的 75% 时，按相反的顺序逐步恢复；
+         * @note 3. 仅当画质等级与渲染分辨率均已降至最低时，才会像原来一样丢弃帧。
+         *
+         * 画质等级的具体含义由使用者决定，可通过 `installPacingEvent()` 在等级变化时关闭特效等。
+         * @see installPacingEvent
+         * @see pacingStats
+         * @see setRenderScaleRange
+         * @see setQualityTierCount
+         * @since v1.1.0-alpha
+         */
+        void setAdaptivePacingEnabled(bool enabled);
+        /**
+         * @brief 获取当前是否启用自适应帧节奏
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        bool adaptivePacingEnabled() const;
+        /**
+         * @brief 设置用于判断的渲染耗时百分位数
+         * @param percentile 百分位数（0.5 ~ 0.99，默认为 0.95）
+         * @param window     统计最近多少帧（默认为 120）
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        void setPacingPercentile(float percentile, uint32_t window = 120);
+        /**
+         * @brief 获取用于判断的渲染耗时百分位数
+         * @see setPacingPercentile
+         * @since v1.1.0-alpha
+         */
+        float pacingPercentile() const;
+        /**
+         * @brief 设置渲染分辨率比例的调整范围
+         * @param min_scale 最低比例（默认为 0.5）
+         * @param max_scale 最高比例（默认为 1.0）
+         * @see Painter::setRenderScale
+         * @since v1.1.0-alpha
+         */
+        void setRenderScaleRange(float min_scale, float max_scale = 1.0f);
+        /**
+         * @brief 设置画质等级的数量
+         * @param count 等级数量（默认为 3，即 0 ~ 2 级），为 1 时仅调整渲染分辨率
+         * @note 引擎本身不会根据画质等级关闭任何效果，未安装 `installPacingEvent()` 时将跳过画质等级，直接调整渲染分辨率
+         * @see qualityTier
+         * @since v1.1.0-alpha
+         */
+        void setQualityTierCount(uint32_t count);
+        /**
+         * @brief 获取画质等级的数量
+         * @see setQualityTierCount
+         * @since v1.1.0-alpha
+         */
+        uint32_t qualityTierCount() const;
+        /**
+         * @brief 获取当前画质等级
+         * @return 返回当前等级，0 为最高画质
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        uint32_t qualityTier() const;
+        /**
+         * @brief 安装帧节奏调整事件
+         * @param function 每当画质等级或渲染分辨率发生调整时调用
+         * @note 原有的事件将被替换
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        void installPacingEvent(const std::function<void(const PacingStats&)>& function);
+        /**
+         * @brief 获取自适应帧节奏的统计信息
+         * @see setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        const PacingStats& pacingStats() const;
+        /**
+         * @brief 获取当前是否以无窗口模式运行
+         * @see Engine
+         * @since v1.1.0-alpha
+         */
+        bool isHeadless() const;
+        /**
+         * @brief 设置最多渲染的帧数
+         * @param frames 帧数（为 0 时不限制）
+         *
+         * 渲染指定帧数后 `exec()` 将自动返回，通常与无窗口模式及 `setFPS(0)` 一同用于性能测试。
+         * @see frameTimings
+         * @since v1.1.0-alpha
+         */
+        void setFrameLimit(uint64_t frames);
+        /**
+         * @brief 获取最多渲染的帧数
+         * @see setFrameLimit
+         * @since v1.1.0-alpha
+         */
+        uint64_t frameLimit() const;
+        /**
+         * @brief 设置每帧耗时的导出文件
+         * @param path 文件路径（CSV 格式），为空时不导出
+         *
+         * `exec()` 结束时，将每帧的序号、开始时间、渲染耗时及间隔写入指定文件。
+         * @see frameTimings
+         * @since v1.1.0-alpha
+         */
+        void setFrameTimingFile(const std::string& path);
+        /**
+         * @brief 获取每帧的耗时记录
+         * @note 仅当设置了 `setFrameLimit()` 或 `setFrameTimingFile()` 时才会记录
+         * @see setFrameTimingFile
+         * @since v1.1.0-alpha
+         */
+        const std::vector<FrameTiming>& frameTimings() const;
+        /**
+         * @brief 设置将渲染后的画面保存为 PNG 图片
+         * @param directory 保存目录，为空时不保存
+         * @param interval  每隔多少帧保存一次（默认每帧保存）
+         *
+         * 图片命名为 `frame_<窗口 ID>_<帧序号>.png`，保存的是刷新画面前的完整画面，可用于与基准图片对比。
+         * @see setFrameLimit
+         * @since v1.1.0-alpha
+         */
+        void setFrameCapture(const std::string& directory, uint32_t interval = 1);
 
         /**
          * @brief 设置是否允许在后台渲染画面
@@ -547,6 +722,133 @@ namespace EasyEngine {
          * @brief 获取当前显示器屏幕
          */
         Geometry screenGeometry();
+        /**
+         * @brief 安装固定步长的逻辑更新事件
+         * @param function 更新函数，参数为固定的步长（秒）
+         *
+         * 更新函数与渲染解耦，按 `tickRate()` 的频率以固定步长执行：
+         * 每次循环累计经过的时间，并在渲染之前执行足够次数的更新以追上实际时间。
+         * 因此无论渲染帧率高低，逻辑（如物理、移动）的速度都保持一致，且结果可复现。
+         * 渲染时可通过 `interpolationAlpha()` 在上一次与当前状态之间插值，使画面更平滑。
+         * @note 原有的更新函数将被替换
+         * @see setTickRate
+         * @see setMaxCatchUpSteps
+         * @see interpolationAlpha
+         * @since v1.1.0-alpha
+         */
+        void installUpdateEvent(const std::function<void(float)>& function);
+        /**
+         * @brief 设置逻辑更新频率
+         * @param tick_rate 每秒更新次数（默认为 60）
+         * @see installUpdateEvent
+         * @since v1.1.0-alpha
+         */
+        void setTickRate(uint32_t tick_rate);
+        /**
+         * @brief 获取逻辑更新频率
+         * @see setTickRate
+         * @since v1.1.0-alpha
+         */
+        uint32_t tickRate() const;
+        /**
+         * @brief 设置单次循环中最多追赶的更新次数
+         * @param steps 最多更新次数（默认为 5）
+         *
+         * 当渲染或更新过慢导致积压过多时，超出的时间将被丢弃，以免陷入越追越慢的循环。
+         * 此时逻辑速度会暂时慢于实际时间。
+         * @see installUpdateEvent
+         * @since v1.1.0-alpha
+         */
+        void setMaxCatchUpSteps(uint32_t steps);
+        /**
+         * @brief 获取单次循环中最多追赶的更新次数
+         * @see setMaxCatchUpSteps
+         * @since v1.1.0-alpha
+         */
+        uint32_t maxCatchUpSteps() const;
+        /**
+         * @brief 获取渲染插值系数
+         * @return 返回 0.0 ~ 1.0，表示当前时间在上一次与下一次逻辑更新之间的位置
+         *
+         * 在绘制事件中使用：`pos = prev_pos + (cur_pos - prev_pos) * alpha`
+         * @see installUpdateEvent
+         * @since v1.1.0-alpha
+         */
+        float interpolationAlpha() const;
+        /**
+         * @brief 获取自启动以来执行的逻辑更新总次数
+         * @since v1.1.0-alpha
+         */
+        uint64_t tickCount() const;
+        /**
+         * @brief 设置是否启用独立的渲染线程
+         * @param enabled 启用/禁用（默认禁用）
+         *
+         * 启用后，主线程负责记录绘制命令（场景图层、过渡动画、绘图事件），渲染线程负责执行上一帧的命令并刷新画面。
+         * 绘制命令采用双缓冲：主线程在交换命令缓冲前等待渲染线程完成上一帧（栅栏），
+         * 因此第 N+1 帧的场景遍历与第 N 帧的画面提交可在多核设备上并行执行。
+         * @note 精灵、纹理图集及文本所使用的纹理会延迟到渲染线程不再使用后才释放；
+         * 在主线程中直接调用 SDL 渲染函数时，请先使用 `Painter::lockRenderer()` 加锁。
+         * `TextSystem` 修改文本时会自动加锁。
+         * @warning 启用后 `SDL_RenderPresent()` 将在渲染线程中调用。部分 SDL 渲染后端（如 macOS、iOS 上的 Metal 与 OpenGL，
+         * 以及多数移动平台）只支持在主线程中使用渲染器及刷新画面，此时请勿启用。
+         * @see renderThreadEnabled
+         * @see waitForRender
+         * @since v1.1.0-alpha
+         */
+        void setRenderThreadEnabled(bool enabled);
+        /**
+         * @brief 获取当前是否启用独立的渲染线程
+         * @see setRenderThreadEnabled
+         * @since v1.1.0-alpha
+         */
+        bool renderThreadEnabled() const;
+        /**
+         * @brief 等待渲染线程执行完已提交的帧
+         * @note 未启用渲染线程时立即返回
+         * @see setRenderThreadEnabled
+         * @since v1.1.0-alpha
+         */
+        void waitForRender();
+        /**
+         * @brief 设置指定窗口的目标帧率
+         * @param window_id 指定窗口
+         * @param fps       目标帧率（为 0 时跟随全局帧率）
+         * @return 返回 true 表示成功，若找不到窗口 ID 则返回 false
+         *
+         * 每个窗口仅在距上次刷新达到其目标间隔时才会记录并提交新的一帧，
+         * 因此多个窗口可以不同的频率刷新。
+         * @note 窗口的实际帧率不会超过 `setFPS()` 指定的全局帧率
+         * @see windowFPS
+         * @see Painter::frameStats
+         * @since v1.1.0-alpha
+         */
+        bool setWindowFPS(SWindowID window_id, uint32_t fps);
+        /**
+         * @brief 获取指定窗口的目标帧率
+         * @param window_id 指定窗口
+         * @return 返回目标帧率，若找不到窗口或跟随全局帧率则返回 0
+         * @see setWindowFPS
+         * @since v1.1.0-alpha
+         */
+        uint32_t windowFPS(SWindowID window_id) const;
+        /**
+         * @brief 设置是否并行记录多个窗口的绘制命令
+         * @param enabled 启用/禁用（默认禁用）
+         *
+         * 启用后，存在多个窗口时，各窗口的场景遍历及命令记录将分配到多个工作线程中并行执行，
+         * 而命令的执行与画面的刷新仍按顺序提交。
+         * @note 各窗口的场景、图层及绘图事件之间不应共享可变状态
+         * @see parallelRecordingEnabled
+         * @since v1.1.0-alpha
+         */
+        void setParallelRecordingEnabled(bool enabled);
+        /**
+         * @brief 获取当前是否并行记录多个窗口的绘制命令
+         * @see setParallelRecordingEnabled
+         * @since v1.1.0-alpha
+         */
+        bool parallelRecordingEnabled() const;
 
 
     private:
@@ -557,6 +859,29 @@ namespace EasyEngine {
         bool init(const char *title, uint32_t width, uint32_t height, uint32_t *wID);
         bool unload(SWindowID window_id);
         int run();
+        void waitForNextDeadline(uint64_t timeout_ns);
+        void startRenderThread();
+        void stopRenderThread();
+        void renderThreadLoop();
+        /**
+         * @brief 记录指定窗口的绘制命令，启用并行记录时分配到工作线程中执行
+         */
+        void recordFrames(const std::vector<Painter*>& painters);
+        /**
+         * @brief 记录一帧的渲染耗时，并根据百分位数调整画质等级及渲染分辨率
+         * @param frame_time  渲染耗时（毫秒）
+         * @param target_time 目标帧时长（毫秒）
+         * @param threshold   触发降级的阈值（毫秒）
+         */
+        void updatePacing(float frame_time, float target_time, float threshold);
+        bool isPacingExhausted() const;
+        /// 实际参与调整的画质等级数量（未安装帧节奏调整事件时为 1）
+        uint32_t activeQualityTierCount() const;
+        void applyRenderScale(float scale);
+        bool dumpFrameTimings() const;
+        void runRecordJobs();
+        void recordWorkerLoop();
+        void stopRecordWorkers();
         void cleanUp();
         std::map<SWindowID, std::shared_ptr<Window>> _sdl_window_list;
         static SWindowID _main_window_id;
@@ -572,6 +897,48 @@ namespace EasyEngine {
         uint64_t max_frame_duration{0};
         uint64_t max_consecutive_slow_frames{3};
         uint64_t target_frame_duration{0};
+        float _frame_drop_tolerance{1.5f};
+        bool _adaptive_pacing{false};
+        float _pacing_percentile{0.95f};
+        uint32_t _pacing_window{120};
+        std::vector<float> _pacing_samples;
+        std::vector<float> _pacing_sorted;
+        size_t _pacing_cursor{0};
+        size_t _pacing_count{0};
+        float _min_render_scale{0.5f};
+        float _max_render_scale{1.0f};
+        uint32_t _quality_tier_count{3};
+        PacingStats _pacing_stats;
+        std::function<void(const PacingStats&)> _pacing_function;
+        bool _is_headless{false};
+        uint64_t _frame_limit{0};
+        uint64_t _frames_rendered{0};
+        std::string _frame_timing_file;
+        std::vector<FrameTiming> _frame_timings;
+        std::function<void(float)> _update_function;
+        uint32_t _tick_rate{60};
+        uint32_t _max_catch_up_steps{5};
+        float _interpolation_alpha{0.0f};
+        uint64_t _tick_count{0};
+        bool _render_thread_enabled{false};
+        std::thread _render_thread;
+        std::mutex _render_mutex;
+        std::condition_variable _render_cv;
+        bool _frame_pending{false};
+        bool _stop_render_thread{false};
+        std::vector<Painter*> _submit_painters;
+        std::vector<Painter*> _frame_painters;
+        bool _parallel_recording{false};
+        std::vector<std::thread> _record_workers;
+        std::mutex _record_mutex;
+        std::condition_variable _record_cv;
+        std::condition_variable _record_done_cv;
+        std::vector<Painter*> _record_jobs;
+        std::atomic<size_t> _record_next{0};
+        size_t _record_remaining{0};
+        uint32_t _record_active{0};
+        uint64_t _record_generation{0};
+        bool _stop_record_workers{false};
         Vector2 _cursor_old_pos{};
         friend class Painter;
         friend class EventSystem;
@@ -585,6 +952,24 @@ namespace EasyEngine {
      */
     class Painter {
     public:
+        /**
+         * @struct FrameStats
+         * @brief 窗口的帧统计信息
+         * @see frameStats
+         * @since v1.1.0-alpha
+         */
+        struct FrameStats {
+            /// 最近两次刷新画面之间的间隔（毫秒）
+            float frame_time{0.0f};
+            /// 最近一帧记录绘制命令的耗时（毫秒）
+            float record_time{0.0f};
+            /// 最近一帧执行绘制命令并刷新画面的耗时（毫秒）
+            float submit_time{0.0f};
+            /// 上一秒内刷新的帧数
+            uint32_t fps{0};
+            /// 已刷新的总帧数
+            uint64_t frame_count{0};
+        };
         /**
          * @brief 指定窗口以获取渲染器
          * @param window 指定的窗口
@@ -704,6 +1089,149 @@ namespace EasyEngine {
          * @param position  指定绘制的位置
          */
         void drawText(TTF_Text* text, const Vector2& position);
+        /**
+         * @brief 设置是否启用精灵合批绘制
+         * @param enabled 启用/禁用（默认启用）
+         *
+         * 启用后，连续绘制且使用同一纹理的精灵将在 CPU 端计算旋转、缩放、翻转、裁剪及颜色，
+         * 并合并为一次 `SDL_RenderGeometry()` 调用提交，从而减少绘制调用次数。
+         * @see spriteBatchEnabled
+         * @since v1.1.0-alpha
+         */
+        void setSpriteBatchEnabled(bool enabled);
+        /**
+         * @brief 获取当前是否启用精灵合批绘制
+         * @see setSpriteBatchEnabled
+         * @since v1.1.0-alpha
+         */
+        bool spriteBatchEnabled() const;
+        /**
+         * @brief 获取上一帧通过精灵合批所节省的绘制调用次数
+         * @see setSpriteBatchEnabled
+         * @since v1.1.0-alpha
+         */
+        uint32_t drawCallsSaved() const;
+        /**
+         * @brief 获取此窗口的帧统计信息
+         * @note 启用渲染线程时，统计信息由渲染线程更新，读取到的可能是上一帧的数据
+         * @see Engine::setWindowFPS
+         * @since v1.1.0-alpha
+         */
+        const FrameStats& frameStats() const;
+        /**
+         * @brief 设置渲染分辨率比例
+         * @param scale 比例（0.25 ~ 1.0，默认为 1.0）
+         *
+         * 小于 1.0 时，所有绘制命令先以较低的分辨率绘制到离屏纹理中，再拉伸至整个窗口，
+         * 以降低像素填充的开销。绘制命令仍使用窗口坐标，无需调整。
+         * @see Engine::setAdaptivePacingEnabled
+         * @since v1.1.0-alpha
+         */
+        void setRenderScale(float scale);
+        /**
+         * @brief 获取渲染分辨率比例
+         * @see setRenderScale
+         * @since v1.1.0-alpha
+         */
+        float renderScale() const;
+        /**
+         * @brief 请求截取下一帧画面并保存为 PNG 图片
+         * @param path     保存路径
+         * @param callback 保存完成后的回调函数（在后台线程中调用），参数表示是否保存成功
+         *
+         * 下一帧先绘制到离屏纹理中，读取像素后交由 `FrameCapture` 在后台线程中编码，不会阻塞帧循环。
+         * @see FrameCapture
+         * @since v1.1.0-alpha
+         */
+        void requestScreenshot(const std::string& path, const std::function<void(bool)>& callback = {});
+        /**
+         * @brief 开始录制画面
+         * @param directory 保存目录
+         * @param format    保存格式（默认为 PNG）
+         * @param interval  每隔多少帧保存一次（默认每帧保存）
+         *
+         * 每帧画面保存为 `frame_<窗口 ID>_<帧序号>.png`（或 `.rgba`）。
+         * 后台编码跟不上时将丢弃部分画面，而不会拖慢帧循环。
+         * @see stopRecording
+         * @see FrameCapture::setMaxPendingFrames
+         * @since v1.1.0-alpha
+         */
+        void startRecording(const std::string& directory, FrameCapture::Format format = FrameCapture::PNG,
+                            uint32_t interval = 1);
+        /**
+         * @brief 停止录制画面
+         * @see startRecording
+         * @since v1.1.0-alpha
+         */
+        void stopRecording();
+        /**
+         * @brief 是否正在录制画面
+         * @see startRecording
+         * @since v1.1.0-alpha
+         */
+        bool isRecording() const;
+        /**
+         * @brief 设置是否保留每一帧的画面
+         * @param retained 是否保留
+         *
+         * 启用后每帧先绘制到离屏纹理中，再绘制到窗口，以便 `readFrame()` 随时读取最近一帧。
+         * 每帧需多绘制一次整个窗口，仅在需要时启用。
+         * @see readFrame
+         * @since v1.1.0-alpha
+         */
+        void setFrameRetained(bool retained);
+        /**
+         * @brief 是否保留每一帧的画面
+         * @see setFrameRetained
+         * @since v1.1.0-alpha
+         */
+        bool frameRetained() const;
+        /**
+         * @brief 读取最近一帧的画面
+         * @return 返回新创建的表面，需调用 `SDL_DestroySurface()` 释放；最近一帧未被保留时返回 `nullptr`
+         * @note 仅从保留的离屏纹理中读取（最近一帧正在截取、录制或已调用 `setFrameRetained()`），
+         *       刷新画面后后台缓冲区的内容是未定义的，因此不会读取。
+         *       未保留时将自动启用 `setFrameRetained()`，从下一帧起即可读取。
+         * @see Algorithm::captureWindow
+         * @since v1.1.0-alpha
+         */
+        SSurface* readFrame();
+        /**
+         * @brief 锁定渲染器
+         * @return 返回渲染器锁，持有期间渲染线程不会使用此渲染器
+         * @note 启用渲染线程后，在主线程中直接调用 SDL 渲染函数（创建纹理、读取像素等）前需先加锁
+         * @see Engine::setRenderThreadEnabled
+         * @since v1.1.0-alpha
+         */
+        std::unique_lock<std::recursive_mutex> lockRenderer() const;
+        /**
+         * @brief 在锁定渲染器的情况下，从表面创建纹理
+         * @param surface 指定表面
+         * @see lockRenderer
+         */
+        STexture* _createTexture(SSurface* surface);
+        /**
+         * @brief 延迟释放渲染资源
+         * @param painter 资源所属的绘制器
+         * @param release 释放函数
+         *
+         * 启用渲染线程时，释放函数将在此前记录的绘制命令全部执行完毕后由渲染线程调用；否则立即调用。
+         * @see Engine::setRenderThreadEnabled
+         */
+        static void _deferRelease(Painter* painter, std::function<void()> release);
+        /**
+         * @brief 开始记录可排序的绘制命令区间
+         * @note 通常由 `Layer` 在可排序模式下调用
+         * @see Layer::setSortable
+         */
+        void _beginSortRange();
+        /**
+         * @brief 结束记录可排序的绘制命令区间，并按纹理重新排序其中的精灵绘制命令
+         *
+         * 仅当两个精灵的绘制区域互不重叠时才会调整其先后顺序，否则保持原有顺序。
+         * @see Layer::setSortable
+         */
+        void _endSortRange();
         bool _addTransition(Transition::AbstractTransition* transition);
         bool _removeTransition(Transition::AbstractTransition* transition);
         bool _startTransition(Transition::AbstractTransition* transition);
@@ -718,40 +1246,82 @@ namespace EasyEngine {
          * 告诉图形绘制器如何绘图，即存储绘图步骤
          */
         void paintEvent();
+        /**
+         * @brief 记录一帧（场景图层、过渡动画及统计信息）的绘制命令
+         * @note 可能在记录线程中调用，不得调用仅限主线程的 SDL 函数
+         */
+        void recordFrame();
+        /**
+         * @brief 读取窗口当前的位置及大小
+         * @note SDL 的窗口查询仅限主线程，须在记录本帧之前于主线程中调用
+         */
+        void updateWindowGeometry();
+        /**
+         * @brief 将已记录的命令交换到提交缓冲中，并清空记录缓冲
+         * @note 启用渲染线程时，须在渲染线程空闲时调用
+         */
+        void swapFrame();
+        /**
+         * @brief 执行提交缓冲中的命令并刷新画面
+         */
+        void submitFrame();
+        /**
+         * @brief 立即执行所有延迟释放的函数
+         */
+        void flushReleases();
+        /**
+         * @brief 根据目标帧率判断此窗口是否需要刷新
+         * @param now  当前高精度计数器的值
+         * @param freq 高精度计数器的频率
+         */
+        bool isFrameDue(uint64_t now, uint64_t freq);
+        /**
+         * @brief 本帧是否需要捕获画面
+         */
+        bool isCaptureDue();
+        /**
+         * @brief 获取与窗口同尺寸的离屏纹理，用于捕获画面
+         * @param width  宽度
+         * @param height 高度
+         */
+        STexture* captureTarget(int width, int height);
+        /**
+         * @brief 读取当前渲染目标的画面，并提交给 `FrameCapture` 编码
+         */
+        void captureFrame();
         Window* _window;
-        struct Command {
-            explicit Command() {};
-            virtual ~Command() = default;
-            virtual void exec(SRenderer *renderer, uint32_t thickness) = 0;
-        };
-        struct PointCMD : Command {
+        /*
+         * 所有绘制命令均为可平凡复制的记录，统一存放在 `command_list` 中，
+         * 每帧结束后仅重置（保留容量）而不释放，避免每次绘制都产生堆分配。
+         */
+        struct PointCMD {
             Graphics::Point pt;
             explicit PointCMD(const Graphics::Point& point) : pt(point) {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        struct LineCMD : Command {
+        struct LineCMD {
             Graphics::Line line;
             explicit LineCMD(const Graphics::Line& line) : line(line) {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        struct RectCMD : Command {
+        struct RectCMD {
             Graphics::Rectangle rect;
             explicit RectCMD(const Graphics::Rectangle& rect) : rect(rect) {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        struct EllipseCMD : Command {
+        struct EllipseCMD {
             Graphics::Ellipse ellipse;
             explicit EllipseCMD(const Graphics::Ellipse& ellipse) : ellipse(ellipse)
                 {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        struct FillCMD : Command {
+        struct FillCMD {
             SColor color;
             explicit FillCMD(const SColor& color) : color(color)
                 {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        struct SpriteCMD : Command {
+        struct SpriteCMD {
             STexture* _sprite;
             Vector2 _pos, _clip_pos;
             Size _size, _clip_size;
@@ -762,34 +1332,56 @@ namespace EasyEngine {
             float _scaled{1.0f};
             SColor _color_alpha{255, 255, 255, 255};
             SDL_FlipMode _flip_mode{SDL_FLIP_NONE};
+            /// 纹理图集中的子区域（仅当 `_has_src` 为 `true` 时有效）
+            Vector2 _src_pos;
+            Size _src_size;
+            bool _has_src{false};
             explicit SpriteCMD(const Components::Sprite& sprite, const Vector2& pos = Vector2(0, 0))
                 : _sprite(sprite.sprite()), _size(sprite.size()), _pos(pos),
                   _rotate_center(0, 0), _scaled_center(0, 0),
-                  _clip_pos(0, 0), _clip_size(0, 0)
+                  _clip_pos(0, 0), _clip_size(0, 0),
+                  _src_pos(sprite.atlasRegion().pos), _src_size(sprite.atlasRegion().size),
+                  _has_src(sprite.atlas() != nullptr)
                 {}
             SpriteCMD(const Components::Sprite& sprite, const Vector2& pos,
                       const Components::Sprite::Properties& properties)
                       : _sprite(sprite.sprite()), _size(sprite.size().width, sprite.size().height),
                         _pos(pos + properties.position), _rotate(properties.rotate), _rotate_center(properties.rotate_center),
                         _scaled(properties.scaled), _scaled_center(properties.scaled_center),
-                        _clip_size(properties.clip_size), _is_clip(properties.clip_mode) {
+                        _clip_size(properties.clip_size), _is_clip(properties.clip_mode),
+                        _src_pos(sprite.atlasRegion().pos), _src_size(sprite.atlasRegion().size),
+                        _has_src(sprite.atlas() != nullptr) {
                 if (_is_clip)
                     _flip_mode = (properties.flip_mode == Components::Sprite::FlipMode::HFlip) ? SDL_FLIP_HORIZONTAL :
                         ((properties.flip_mode == Components::Sprite::FlipMode::VFlip) ? SDL_FLIP_VERTICAL : SDL_FLIP_NONE);
             }
-            void exec(SRenderer *renderer, uint32_t) override;
+            void exec(SRenderer *renderer, uint32_t) const;
+            /**
+             * @brief 获取纹理的源区域（综合图集子区域与裁剪区域）
+             * @param rect 输出的源区域
+             * @return 若需使用整张纹理，则返回 `false`
+             */
+            bool sourceRect(SDL_FRect* rect) const;
+            /**
+             * @brief 计算精灵四个顶点（左上、右上、右下、左下）
+             * @param vertices 输出的顶点数组（至少 4 个）
+             * @param tex_w    纹理宽度
+             * @param tex_h    纹理高度
+             */
+            void vertices(SDL_Vertex* vertices, float tex_w, float tex_h) const;
         };
-        struct PixelTextCMD : Command {
+        struct PixelTextCMD {
             Vector2 pos;
             Size size;
             SColor color;
-            std::string text;
-            explicit PixelTextCMD() : pos(0, 0), size(0, 0), color(StdColor::White), text() {}
-            PixelTextCMD(const GeometryF& geometry, const SColor& color, const std::string& text)
-                : pos(geometry.pos), size(geometry.size), color(color), text(text) {}
-            void exec(SRenderer *renderer, uint32_t) override;
+            /// 文本在 `_text_buffer` 中的起始位置（以 '\0' 结尾）
+            size_t text_offset;
+            explicit PixelTextCMD() : pos(0, 0), size(0, 0), color(StdColor::White), text_offset(0) {}
+            PixelTextCMD(const GeometryF& geometry, const SColor& color, size_t text_offset)
+                : pos(geometry.pos), size(geometry.size), color(color), text_offset(text_offset) {}
+            void exec(SRenderer *renderer, const char* text) const;
         };
-        struct ViewportCMD : Command {
+        struct ViewportCMD {
             Geometry geometry;
             bool is_clipped_mode;
             Size scaled;
@@ -797,16 +1389,70 @@ namespace EasyEngine {
             ViewportCMD(const Geometry& geometry, bool is_clipped_mode, const Size& scaled = {1.f, 1.f})
                 : geometry(geometry.x, geometry.y, geometry.width, geometry.height),
                 is_clipped_mode(is_clipped_mode), scaled(scaled.width, scaled.height) {}
-            void exec(SRenderer *renderer, uint32_t) override;
+            void exec(SRenderer *renderer, uint32_t) const;
         };
-        struct TextCMD : Command {
+        struct TextCMD {
             Vector2 position;
             TTF_Text* text;
             explicit TextCMD() : position(0, 0), text(nullptr) {}
             TextCMD(const Vector2& position, TTF_Text* text) : position(position.x, position.y), text(text) {}
-            void exec(SRenderer *renderer, uint32_t thickness) override;
+            void exec(SRenderer *renderer, uint32_t thickness) const;
         };
-        std::vector<std::unique_ptr<Command>> command_list;
+        using Command = std::variant<PointCMD, LineCMD, RectCMD, EllipseCMD, FillCMD,
+                                     SpriteCMD, PixelTextCMD, ViewportCMD, TextCMD>;
+        static_assert(std::is_trivially_copyable_v<Command>, "Painter::Command must be trivially copyable!");
+        /**
+         * @brief 执行单条绘制命令
+         * @param command 指定绘制命令
+         */
+        void execCommand(const Command& command);
+        /**
+         * @brief 合批执行从指定位置开始、连续且使用同一纹理的精灵绘制命令
+         * @param first 起始命令下标（必须为 `SpriteCMD`）
+         * @return 返回该批次之后的下一条命令下标
+         */
+        size_t execSpriteBatch(size_t first);
+        /**
+         * @brief 对连续的精灵绘制命令区间 [first, last) 按纹理重新排序
+         */
+        void sortSpriteRange(size_t first, size_t last);
+        std::vector<Command> command_list;
+        std::string _text_buffer;
+        /// 提交缓冲，由 `submitFrame()` 执行（启用渲染线程时位于渲染线程）
+        std::vector<Command> _submit_list;
+        std::string _submit_text;
+        std::mutex _release_mutex;
+        std::vector<std::function<void()>> _release_list;
+        std::vector<std::function<void()>> _submit_release_list;
+        mutable std::recursive_mutex _renderer_mutex;
+        static std::atomic<bool> _render_threaded;
+        FrameStats _frame_stats;
+        float _render_scale{1.0f};
+        /// 交换命令缓冲时记录的渲染分辨率比例，供提交的帧使用
+        float _submit_scale{1.0f};
+        /// 本帧实际使用的渲染分辨率比例（创建离屏纹理失败时回退为 1）
+        float _applied_scale{1.0f};
+        STexture* _scale_target{nullptr};
+        std::string _capture_directory;
+        uint32_t _capture_interval{1};
+        FrameCapture::Format _capture_format{FrameCapture::PNG};
+        STexture* _capture_target{nullptr};
+        uint64_t _captured_frame{UINT64_MAX};
+        std::atomic<bool> _frame_retained{false};
+        std::mutex _capture_mutex;
+        std::vector<std::pair<std::string, std::function<void(bool)>>> _screenshot_requests;
+        uint32_t _target_fps{0};
+        uint64_t _last_frame_tick{0};
+        uint64_t _last_present_ns{0};
+        uint64_t _fps_check_ns{0};
+        uint32_t _frames_in_second{0};
+        std::vector<SDL_Vertex> _batch_vertices;
+        std::vector<int> _batch_indices;
+        bool _sprite_batch_enabled{true};
+        uint32_t _draw_calls_saved{0};
+        size_t _sort_range_start{0};
+        bool _is_sorting{false};
+        std::vector<SDL_FRect> _sort_bounds;
         std::function<void(Painter&)> paint_function;
         uint32_t _thickness;
         SceneManager* _scene_manager{nullptr};
@@ -815,6 +1461,7 @@ namespace EasyEngine {
         std::vector<std::shared_ptr<EasingCurve::AbstractEasingCurve>> _curve_list;
         std::vector<std::shared_ptr<EasingCurve::AbstractEasingCurve>> _running_curve_list;
         friend class Components::Sprite;
+        friend class Engine;
     };
 
     /**
@@ -960,11 +1607,30 @@ namespace EasyEngine {
          * @brief 清空场景管理器
          */
         void clearSceneManger();
+        /**
+         * @brief 投递一个任务，在主线程的下一次事件处理中执行
+         * @param task 指定任务
+         *
+         * 此函数是线程安全的，用于将后台线程（如资源加载）的完成回调交还给主线程。
+         * @see ResourceSystem::loadAsync
+         * @since v1.1.0-alpha
+         */
+        void postTask(std::function<void()> task);
+        /**
+         * @brief 获取距离下一次需要处理事件的时间
+         * @return 返回纳秒数。若有待执行的任务则返回 0；若没有任何计时器或触发器，则返回 `UINT64_MAX`
+         *
+         * 主循环据此决定可以休眠多久。
+         * @since v1.1.0-alpha
+         */
+        uint64_t idleTimeoutNS();
 
     private:
         static std::function<bool(SEvent&)> _my_event_handler;
         static std::unique_ptr<EventSystem> _instance;
         static bool _handler_trigger;
+        /// 渲染设备已重置，等待主循环恢复共享纹理
+        bool _render_device_reset{false};
         std::map<uint64_t, std::unique_ptr<Components::Timer>> _timer_list;
         std::map<uint64_t, std::unique_ptr<Components::Trigger>> _trigger_list;
         std::map<uint64_t, Components::Control*> _control_list;
@@ -973,6 +1639,9 @@ namespace EasyEngine {
         uint64_t _trigger_id{0};
         uint64_t _control_id{0};
         uint64_t _scene_id{0};
+        std::mutex _task_mutex;
+        std::vector<std::function<void()>> _task_queue;
+        std::vector<std::function<void()>> _running_tasks;
     };
 
     /**
@@ -1413,6 +2082,8 @@ namespace EasyEngine {
         TextSystem& operator=(const TextSystem&) = delete;
     private:
         TextSystem() = default;
+        /// 修改文本前加锁，避免渲染线程同时绘制同一文本
+        std::unique_lock<std::recursive_mutex> lockRenderer() const;
         static std::unique_ptr<TextSystem> _instance;
         std::map<std::string, std::shared_ptr<Components::Font>> _font_info;
         std::map<std::string, TTF_Text*> _text_list;
@@ -0,0 +1,214 @@
+
+#include "Profiler.h"
+#include "Core.h"
+
+namespace EasyEngine {
+    namespace {
+        thread_local uint32_t t_depth = 0;
+
+        void appendEscaped(std::string& out, std::string_view text) {
+            for (auto c : text) {
+                if (c == '"' || c == '\\') out.push_back('\\');
+                if (static_cast<unsigned char>(c) < 0x20) continue;
+                out.push_back(c);
+            }
+        }
+    }
+
+    std::unique_ptr<Profiler> Profiler::_instance(new Profiler());
+
+    Profiler::Zone::Zone(const char* name) : _name(name) {
+        if (!_instance->_enabled.load(std::memory_order_relaxed)) return;
+        _active = true;
+        ++t_depth;
+        _start = now();
+    }
+
+    Profiler::Zone::~Zone() {
+        if (!_active) return;
+        auto end = now();
+        --t_depth;
+        _instance->record(_name, _start, end, t_depth);
+    }
+
+    Profiler* Profiler::global() {
+        return _instance.get();
+    }
+
+    Profiler::~Profiler() = default;
+
+    void Profiler::setEnabled(bool enabled) {
+        _enabled.store(enabled, std::memory_order_relaxed);
+        if (enabled) _last_frame_end = _last_peak_reset = now();
+    }
+
+    bool Profiler::enabled() const {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::setOverlayEnabled(bool enabled) {
+        _overlay_enabled = enabled;
+    }
+
+    bool Profiler::overlayEnabled() const {
+        return _overlay_enabled;
+    }
+
+    void Profiler::setThreadName(const std::string& name) {
+        auto buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(_mutex);
+        buffer->name = name;
+    }
+
+    void Profiler::endFrame() {
+        if (!enabled()) return;
+        auto end = now();
+        for (auto& stats : _frame_stats) stats.last_ms = 0.0f;
+        {
+            // 渲染线程及录制线程中的区段同样计入本帧
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& buffer : _buffers) {
+                auto write = buffer->write_index.load(std::memory_order_acquire);
+                auto begin = std::max(buffer->frame_index, write > CAPACITY ? write - CAPACITY : 0);
+                buffer->frame_index = write;
+                for (auto i = begin; i < write; ++i) {
+                    auto& sample = buffer->samples[i % CAPACITY];
+                    std::string_view name(sample.name);
+                    auto it = std::find_if(_frame_stats.begin(), _frame_stats.end(),
+                                           [&name](const ZoneStats& stats) { return stats.name == name; });
+                    if (it == _frame_stats.end()) {
+                        _frame_stats.push_back({name});
+                        it = _frame_stats.end() - 1;
+                    }
+                    it->last_ms += static_cast<float>(sample.end_ns - sample.start_ns) / 1e6f;
+                }
+            }
+        }
+
+        bool reset_peak = end - _last_peak_reset >= 1'000'000'000;
+        for (auto& stats : _frame_stats) {
+            stats.average_ms = stats.average_ms == 0.0f ? stats.last_ms
+                                                        : stats.average_ms * 0.9f + stats.last_ms * 0.1f;
+            stats.peak_ms = std::max(stats.peak_ms, stats.last_ms);
+            if (reset_peak) {
+                stats.max_ms = stats.peak_ms;
+                stats.peak_ms = 0.0f;
+            }
+        }
+        if (reset_peak) _last_peak_reset = end;
+        _frame_time = static_cast<float>(end - _last_frame_end) / 1e6f;
+        _last_frame_end = end;
+    }
+
+    float Profiler::frameTime() const {
+        return _frame_time;
+    }
+
+    const std::vector<Profiler::ZoneStats>& Profiler::frameStats() const {
+        return _frame_stats;
+    }
+
+    void Profiler::drawOverlay(Painter* painter, const Vector2& pos, const SColor& color) const {
+        if (!painter) return;
+        constexpr float LINE_HEIGHT = 10.0f;
+        Vector2 line(pos);
+        painter->drawPixelText(fmt::format("Frame {:6.2f} ms ({:.0f} FPS)", _frame_time,
+                                           _frame_time > 0 ? 1000.0f / _frame_time : 0.0f),
+                               line, {1.0f, 1.0f}, color);
+        line.y += LINE_HEIGHT;
+        painter->drawPixelText(fmt::format("{:<12} {:>7} {:>7} {:>7}", "Zone", "last", "avg", "max"),
+                               line, {1.0f, 1.0f}, color);
+        for (auto& stats : _frame_stats) {
+            line.y += LINE_HEIGHT;
+            painter->drawPixelText(fmt::format("{:<12} {:7.2f} {:7.2f} {:7.2f}", stats.name.substr(0, 12),
+                                               stats.last_ms, stats.average_ms, stats.max_ms),
+                                   line, {1.0f, 1.0f}, color);
+        }
+    }
+
+    std::vector<std::pair<uint32_t, Profiler::Sample>> Profiler::samples() const {
+        std::vector<std::pair<uint32_t, Sample>> result;
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& buffer : _buffers) {
+            auto write = buffer->write_index.load(std::memory_order_acquire);
+            auto begin = write > CAPACITY ? write - CAPACITY : 0;
+            result.reserve(result.size() + (write - begin));
+            for (auto i = begin; i < write; ++i) {
+                result.emplace_back(buffer->id, buffer->samples[i % CAPACITY]);
+            }
+        }
+        return result;
+    }
+
+    void Profiler::clear() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& buffer : _buffers) {
+                buffer->frame_index = buffer->write_index.load(std::memory_order_acquire);
+            }
+        }
+        _frame_stats.clear();
+        _frame_time = 0.0f;
+    }
+
+    bool Profiler::exportChromeTrace(const std::string& path) const {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            SDL_Log("[ERROR] Can't open the file '%s' for exporting the trace!", path.c_str());
+            return false;
+        }
+        std::string out = "{\"traceEvents\":[";
+        bool first = true;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& buffer : _buffers) {
+                out += first ? "\n" : ",\n";
+                first = false;
+                out += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                                   buffer->id);
+                appendEscaped(out, buffer->name.empty() ? fmt::format("Thread {}", buffer->id) : buffer->name);
+                out += "\"}}";
+            }
+        }
+        for (auto& [tid, sample] : samples()) {
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "{\"name\":\"";
+            appendEscaped(out, sample.name);
+            out += fmt::format(R"(","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                               static_cast<double>(sample.start_ns) / 1e3,
+                               static_cast<double>(sample.end_ns - sample.start_ns) / 1e3, tid);
+        }
+        out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+        file << out;
+        if (!file.good()) {
+            SDL_Log("[ERROR] Failed to write the trace to '%s'!", path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t Profiler::now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void Profiler::record(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+        auto buffer = threadBuffer();
+        auto index = buffer->write_index.load(std::memory_order_relaxed);
+        buffer->samples[index % CAPACITY] = {name, start, end, depth};
+        buffer->write_index.store(index + 1, std::memory_order_release);
+    }
+
+    Profiler::ThreadBuffer* Profiler::threadBuffer() {
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        if (t_buffer) return t_buffer;
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->samples = std::make_unique<Sample[]>(CAPACITY);
+        std::lock_guard<std::mutex> lock(_mutex);
+        buffer->id = static_cast<uint32_t>(_buffers.size());
+        t_buffer = buffer.get();
+        _buffers.push_back(std::move(buffer));
+        return t_buffer;
+    }
+}
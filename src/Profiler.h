@@ -0,0 +1,200 @@
+#pragma once
+#ifndef EASYENGINE_PROFILER_H
+#define EASYENGINE_PROFILER_H
+
+/**
+ * @file Profiler.h
+ * @brief 性能分析器
+ *
+ * 基于区段（Zone）的帧性能分析器，用于定位帧耗时的峰值。
+ * 各线程将区段记录写入各自的环形缓冲区，写入过程无需加锁；
+ * 支持在画面上绘制统计信息，以及导出为 Chrome Trace（`chrome://tracing`、Perfetto）格式。
+ *
+ * @copyright Copyright © 2025 CatIsNotFound
+ * @author CatIsNotFound
+ */
+
+#include "Basic.h"
+
+namespace EasyEngine {
+    class Painter;
+
+    /**
+     * @class Profiler
+     * @brief 性能分析器
+     *
+     * 默认禁用，禁用时区段的开销仅为一次原子读取。
+     * @code
+     * Profiler::global()->setEnabled(true);
+     * Profiler::global()->setOverlayEnabled(true);
+     * {
+     *     EASYENGINE_PROFILE_ZONE("MyLogic");
+     *     // ...
+     * }
+     * Profiler::global()->exportChromeTrace("trace.json");
+     * @endcode
+     * @since v1.1.0-alpha
+     */
+    class Profiler {
+    public:
+        /// 每个线程环形缓冲区可保存的区段记录数
+        static constexpr size_t CAPACITY = 8192;
+        /**
+         * @struct Sample
+         * @brief 区段记录
+         */
+        struct Sample {
+            /// 区段名称（须为静态字符串）
+            const char* name;
+            /// 开始时间（纳秒）
+            uint64_t start_ns;
+            /// 结束时间（纳秒）
+            uint64_t end_ns;
+            /// 嵌套深度
+            uint32_t depth;
+        };
+        /**
+         * @struct ZoneStats
+         * @brief 区段在每帧中的耗时统计
+         */
+        struct ZoneStats {
+            /// 区段名称
+            std::string_view name;
+            /// 上一帧的耗时（毫秒）
+            float last_ms{0.0f};
+            /// 平滑后的平均耗时（毫秒）
+            float average_ms{0.0f};
+            /// 最近一秒内的最大耗时（毫秒）
+            float max_ms{0.0f};
+            /// 用于统计最大耗时的临时值
+            float peak_ms{0.0f};
+        };
+        /**
+         * @class Zone
+         * @brief 区段
+         *
+         * 构造时开始计时，析构时结束并记录，通常通过 `EASYENGINE_PROFILE_ZONE` 使用。
+         */
+        class Zone {
+        public:
+            explicit Zone(const char* name);
+            ~Zone();
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+        private:
+            const char* _name;
+            uint64_t _start{0};
+            bool _active{false};
+        };
+
+        /**
+         * @brief 获取全局性能分析器
+         */
+        static Profiler* global();
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+        ~Profiler();
+        /**
+         * @brief 启用/禁用性能分析
+         * @param enabled 是否启用
+         */
+        void setEnabled(bool enabled);
+        /**
+         * @brief 是否启用性能分析
+         */
+        bool enabled() const;
+        /**
+         * @brief 启用/禁用画面上的统计信息
+         * @param enabled 是否启用
+         * @note 需同时启用性能分析
+         * @see drawOverlay
+         */
+        void setOverlayEnabled(bool enabled);
+        /**
+         * @brief 是否启用画面上的统计信息
+         */
+        bool overlayEnabled() const;
+        /**
+         * @brief 为当前线程命名，用于导出的 Trace 中显示
+         * @param name 线程名称
+         */
+        void setThreadName(const std::string& name);
+        /**
+         * @brief 标记一帧的结束，并统计所有线程在此帧中各区段的耗时
+         * @note 由引擎主循环在每次渲染后自动调用
+         * @see frameStats
+         */
+        void endFrame();
+        /**
+         * @brief 获取最近一帧的总耗时（毫秒）
+         */
+        float frameTime() const;
+        /**
+         * @brief 获取各区段在每帧中的耗时统计
+         * @see endFrame
+         */
+        const std::vector<ZoneStats>& frameStats() const;
+        /**
+         * @brief 使用 `drawPixelText` 绘制统计信息
+         * @param painter 指定绘制器
+         * @param pos     绘制位置（默认为左上角）
+         * @param color   文字颜色
+         * @note 启用 `setOverlayEnabled()` 后，绘制器在每帧执行命令前自动调用
+         */
+        void drawOverlay(Painter* painter, const Vector2& pos = {8, 8},
+                         const SColor& color = StdColor::Yellow) const;
+        /**
+         * @brief 获取所有线程缓冲区中的区段记录
+         * @return 返回（线程序号，记录）的列表
+         * @note 写入线程可能正在覆盖最旧的记录，因此只保证最近的记录是完整的
+         */
+        std::vector<std::pair<uint32_t, Sample>> samples() const;
+        /**
+         * @brief 清空所有区段记录及统计
+         */
+        void clear();
+        /**
+         * @brief 导出为 Chrome Trace JSON 格式
+         * @param path 导出路径
+         * @return 返回是否导出成功
+         */
+        bool exportChromeTrace(const std::string& path) const;
+        /**
+         * @brief 获取当前时间（纳秒）
+         */
+        static uint64_t now();
+
+    private:
+        struct ThreadBuffer {
+            uint32_t id{0};
+            std::string name;
+            std::unique_ptr<Sample[]> samples;
+            std::atomic<uint64_t> write_index{0};
+            uint64_t frame_index{0};
+        };
+        explicit Profiler() = default;
+        static std::unique_ptr<Profiler> _instance;
+        void record(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+        ThreadBuffer* threadBuffer();
+        mutable std::mutex _mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+        std::atomic<bool> _enabled{false};
+        std::atomic<bool> _overlay_enabled{false};
+        std::vector<ZoneStats> _frame_stats;
+        uint64_t _last_frame_end{0};
+        uint64_t _last_peak_reset{0};
+        float _frame_time{0.0f};
+    };
+}
+
+/**
+ * @def EASYENGINE_PROFILE_ZONE
+ * @brief 在当前作用域内创建一个性能分析区段
+ * @param name 区段名称（须为静态字符串）
+ */
+#define EASYENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define EASYENGINE_PROFILE_CONCAT(a, b) EASYENGINE_PROFILE_CONCAT_IMPL(a, b)
+#define EASYENGINE_PROFILE_ZONE(name) \
+    EasyEngine::Profiler::Zone EASYENGINE_PROFILE_CONCAT(_easyengine_zone_, __LINE__)(name)
+
+#endif //EASYENGINE_PROFILER_H
@@ -0,0 +1,346 @@
+
+#include "Replay.h"
+
+namespace EasyEngine {
+    namespace {
+        constexpr char MAGIC[4] = {'E', 'E', 'R', 'P'};
+        constexpr uint8_t VERSION = 1;
+        constexpr uint8_t FLAG_RENDERED = 0x01;
+        constexpr uint8_t FLAG_CURSOR = 0x02;
+
+        void putVarint(std::string& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        bool getVarint(const std::vector<uint8_t>& data, size_t& pos, uint64_t& value) {
+            value = 0;
+            for (uint32_t shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+                const uint8_t byte = data[pos++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        /// 事件中需要额外保存的字符串数量
+        uint32_t stringCount(uint32_t type) {
+            switch (type) {
+                case SDL_EVENT_TEXT_INPUT:
+                case SDL_EVENT_TEXT_EDITING:
+                    return 1;
+                case SDL_EVENT_DROP_FILE:
+                case SDL_EVENT_DROP_TEXT:
+                case SDL_EVENT_DROP_BEGIN:
+                case SDL_EVENT_DROP_COMPLETE:
+                case SDL_EVENT_DROP_POSITION:
+                    return 2;
+                default:
+                    return 0;
+            }
+        }
+
+        std::array<const char**, 2> stringFields(SEvent& event) {
+            if (event.type == SDL_EVENT_TEXT_INPUT) return {&event.text.text, nullptr};
+            if (event.type == SDL_EVENT_TEXT_EDITING) return {&event.edit.text, nullptr};
+            return {&event.drop.source, &event.drop.data};
+        }
+
+        void putString(std::string& out, const char* text) {
+            if (!text) {
+                putVarint(out, 0);
+                return;
+            }
+            const size_t size = std::strlen(text) + 1;
+            putVarint(out, size);
+            out.append(text, size);
+        }
+
+        /**
+         * 解析一条事件记录，`event` 为空时仅校验并跳过。
+         * 字符串直接指向日志数据，在回放结束前一直有效。
+         */
+        bool readEvent(const std::vector<uint8_t>& data, size_t& pos, SEvent* event) {
+            uint64_t size = 0;
+            if (!getVarint(data, pos, size) || size < sizeof(uint32_t) || size > sizeof(SEvent) ||
+                pos + size > data.size()) {
+                return false;
+            }
+            SEvent temp;
+            SEvent& out = event ? *event : temp;
+            std::memset(&out, 0, sizeof(SEvent));
+            std::memcpy(&out, data.data() + pos, size);
+            pos += size;
+            const uint32_t count = stringCount(out.type);
+            auto fields = count ? stringFields(out) : std::array<const char**, 2>{nullptr, nullptr};
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t length = 0;
+                if (!getVarint(data, pos, length) || pos + length > data.size()) return false;
+                if (length && data[pos + length - 1] != '\0') return false;
+                if (fields[i]) *fields[i] = length ? reinterpret_cast<const char*>(data.data() + pos) : nullptr;
+                pos += length;
+            }
+            return true;
+        }
+    }
+
+    std::unique_ptr<Replay> Replay::_instance(new Replay());
+
+    Replay* Replay::global() {
+        return _instance.get();
+    }
+
+    Replay::~Replay() {
+        if (isRecording()) stopRecording();
+    }
+
+    bool Replay::startRecording(const std::string& path) {
+        if (_mode != Idle) {
+            SDL_Log("[ERROR] Can't start recording while the replay is %s!", isRecording() ? "recording" : "playing");
+            return false;
+        }
+        _file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!_file.is_open()) {
+            SDL_Log("[ERROR] Can't open the file '%s' for recording!", path.c_str());
+            return false;
+        }
+        _file.write(MAGIC, sizeof(MAGIC));
+        _file.put(static_cast<char>(VERSION));
+        _path = path;
+        _time_ms = _last_time_ms = virtualTimeMillisec();
+        _last_cursor.reset(NAN, NAN);
+        _frame = 0;
+        _has_frame = false;
+        _mode = Recording;
+        return true;
+    }
+
+    bool Replay::stopRecording() {
+        if (!isRecording()) return false;
+        if (_has_frame) flushFrame();
+        _has_frame = false;
+        _file.close();
+        _mode = Idle;
+        if (_file.fail()) {
+            SDL_Log("[ERROR] Failed to write the replay to '%s'!", _path.c_str());
+            return false;
+        }
+        SDL_Log("[INFO] Recorded %llu frames to '%s'.", static_cast<unsigned long long>(_frame), _path.c_str());
+        return true;
+    }
+
+    bool Replay::startPlayback(const std::string& path, bool quit_on_finish) {
+        if (_mode != Idle) {
+            SDL_Log("[ERROR] Can't start playback while the replay is %s!", isRecording() ? "recording" : "playing");
+            return false;
+        }
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            SDL_Log("[ERROR] Can't open the replay file '%s'!", path.c_str());
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() < sizeof(MAGIC) + 1 || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+            data[sizeof(MAGIC)] != VERSION) {
+            SDL_Log("[ERROR] The file '%s' is not a valid replay!", path.c_str());
+            return false;
+        }
+        // 预先校验所有帧，避免回放途中才发现日志损坏
+        std::vector<size_t> offsets;
+        size_t pos = sizeof(MAGIC) + 1;
+        while (pos < data.size()) {
+            offsets.push_back(pos);
+            const uint8_t flags = data[pos++];
+            uint64_t value = 0, count = 0;
+            bool ok = getVarint(data, pos, value);
+            if (ok && (flags & FLAG_CURSOR)) {
+                ok = pos + 2 * sizeof(float) <= data.size();
+                pos += 2 * sizeof(float);
+            }
+            ok = ok && getVarint(data, pos, value) && getVarint(data, pos, count);
+            for (uint64_t i = 0; ok && i < count; ++i) ok = readEvent(data, pos, nullptr);
+            if (!ok) {
+                SDL_Log("[ERROR] The replay '%s' is corrupted at frame %zu!", path.c_str(), offsets.size() - 1);
+                return false;
+            }
+        }
+        _data = std::move(data);
+        _frame_offsets = std::move(offsets);
+        _frame_count = _frame_offsets.size();
+        _time_ms = virtualTimeMillisec();
+        _cursor.reset(0, 0);
+        _frame = 0;
+        _events_remaining = 0;
+        _update_steps = 0;
+        _is_rendered = false;
+        _quit_on_finish = quit_on_finish;
+        _mode = Playing;
+        return true;
+    }
+
+    void Replay::stopPlayback() {
+        if (!isPlaying()) return;
+        // 记录虚拟时钟与实际时间的差值，使停止后的时间从回放进度处继续推进
+        _time_offset_ms = static_cast<int64_t>(_time_ms.load()) - static_cast<int64_t>(realTimeMillisec());
+        _mode = Idle;
+        _data.clear();
+        _frame_offsets.clear();
+        _events_remaining = 0;
+    }
+
+    Replay::Mode Replay::mode() const {
+        return _mode;
+    }
+
+    bool Replay::isRecording() const {
+        return _mode == Recording;
+    }
+
+    bool Replay::isPlaying() const {
+        return _mode == Playing;
+    }
+
+    uint64_t Replay::frame() const {
+        return _frame;
+    }
+
+    uint64_t Replay::frameCount() const {
+        return _frame_count;
+    }
+
+    uint64_t Replay::timeMillisec() const {
+        if (_mode == Idle) return virtualTimeMillisec();
+        return _time_ms;
+    }
+
+    Vector2 Replay::cursorPosition() const {
+        return _cursor;
+    }
+
+    bool Replay::_beginFrame() {
+        if (isRecording()) {
+            if (_has_frame) flushFrame();
+            // 先获取系统中的事件，使光标位置与本帧处理的事件一致
+            SDL_PumpEvents();
+            SDL_GetMouseState(&_cursor.x, &_cursor.y);
+            _time_ms = std::max(virtualTimeMillisec(), _last_time_ms);
+            _update_steps = 0;
+            _is_rendered = false;
+            _event_buffer.clear();
+            _event_count = 0;
+            _has_frame = true;
+            _frame += 1;
+            return true;
+        }
+        if (!isPlaying()) return true;
+        if (_frame >= _frame_count) {
+            SDL_Log("[INFO] Replay finished after %llu frames.", static_cast<unsigned long long>(_frame));
+            stopPlayback();
+            return !_quit_on_finish;
+        }
+        // 各帧已在加载时校验，此处无需再检查
+        size_t pos = _frame_offsets[_frame];
+        const uint8_t flags = _data[pos++];
+        uint64_t delta = 0, steps = 0, count = 0;
+        getVarint(_data, pos, delta);
+        if (flags & FLAG_CURSOR) {
+            std::memcpy(&_cursor.x, _data.data() + pos, sizeof(float));
+            std::memcpy(&_cursor.y, _data.data() + pos + sizeof(float), sizeof(float));
+            pos += 2 * sizeof(float);
+        }
+        getVarint(_data, pos, steps);
+        getVarint(_data, pos, count);
+        _time_ms = _time_ms + delta;
+        _update_steps = static_cast<uint32_t>(steps);
+        _is_rendered = flags & FLAG_RENDERED;
+        _events_offset = pos;
+        _events_remaining = static_cast<uint32_t>(count);
+        _frame += 1;
+        return true;
+    }
+
+    bool Replay::_pollEvent(SEvent* event) {
+        // 真实事件中仅保留退出事件，以便随时中止回放
+        SEvent real;
+        while (SDL_PollEvent(&real)) {
+            if (real.type == SDL_EVENT_QUIT) {
+                *event = real;
+                return true;
+            }
+        }
+        if (!isPlaying() || !_events_remaining) return false;
+        _events_remaining -= 1;
+        return readEvent(_data, _events_offset, event);
+    }
+
+    void Replay::_recordEvent(const SEvent& event) {
+        if (!isRecording()) return;
+        // 自定义事件等携带的指针无法序列化
+        if (event.type >= SDL_EVENT_USER || event.type == SDL_EVENT_CLIPBOARD_UPDATE ||
+            event.type == SDL_EVENT_TEXT_EDITING_CANDIDATES) {
+            return;
+        }
+        SEvent copy = event;
+        const uint32_t count = stringCount(copy.type);
+        auto fields = count ? stringFields(copy) : std::array<const char**, 2>{nullptr, nullptr};
+        std::array<const char*, 2> strings{nullptr, nullptr};
+        for (uint32_t i = 0; i < count; ++i) {
+            strings[i] = *fields[i];
+            *fields[i] = nullptr;
+        }
+        // 末尾的零字节无需保存
+        auto bytes = reinterpret_cast<const char*>(&copy);
+        size_t size = sizeof(SEvent);
+        while (size > sizeof(uint32_t) && bytes[size - 1] == 0) --size;
+        putVarint(_event_buffer, size);
+        _event_buffer.append(bytes, size);
+        for (uint32_t i = 0; i < count; ++i) putString(_event_buffer, strings[i]);
+        _event_count += 1;
+    }
+
+    void Replay::_setUpdateSteps(uint32_t steps) {
+        _update_steps = steps;
+    }
+
+    uint32_t Replay::_updateSteps() const {
+        return _update_steps;
+    }
+
+    void Replay::_setRendered(bool rendered) {
+        _is_rendered = rendered;
+    }
+
+    bool Replay::_rendered() const {
+        return _is_rendered;
+    }
+
+    uint64_t Replay::realTimeMillisec() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t Replay::virtualTimeMillisec() const {
+        return static_cast<uint64_t>(static_cast<int64_t>(realTimeMillisec()) + _time_offset_ms);
+    }
+
+    void Replay::flushFrame() {
+        const bool cursor_changed = _cursor.x != _last_cursor.x || _cursor.y != _last_cursor.y;
+        _frame_buffer.clear();
+        _frame_buffer.push_back(static_cast<char>((_is_rendered ? FLAG_RENDERED : 0) |
+                                                  (cursor_changed ? FLAG_CURSOR : 0)));
+        putVarint(_frame_buffer, _time_ms - _last_time_ms);
+        if (cursor_changed) {
+            _frame_buffer.append(reinterpret_cast<const char*>(&_cursor.x), sizeof(float));
+            _frame_buffer.append(reinterpret_cast<const char*>(&_cursor.y), sizeof(float));
+        }
+        putVarint(_frame_buffer, _update_steps);
+        putVarint(_frame_buffer, _event_count);
+        _file.write(_frame_buffer.data(), static_cast<std::streamsize>(_frame_buffer.size()));
+        _file.write(_event_buffer.data(), static_cast<std::streamsize>(_event_buffer.size()));
+        _last_time_ms = _time_ms;
+        _last_cursor = _cursor;
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+#ifndef EASYENGINE_REPLAY_H
+#define EASYENGINE_REPLAY_H
+
+/**
+ * @file Replay.h
+ * @brief 录像回放
+ *
+ * 以帧为单位录制输入事件、时间戳、光标位置及逻辑更新步数，保存为紧凑的二进制日志。
+ * 回放时使用虚拟时钟注入录制的数据，可在无窗口模式下以最快速度重现真实的游戏过程，
+ * 便于复现性能问题。
+ *
+ * @copyright Copyright © 2025 CatIsNotFound
+ * @author CatIsNotFound
+ */
+
+#include "Basic.h"
+
+namespace EasyEngine {
+    /**
+     * @class Replay
+     * @brief 录像回放器
+     *
+     * 启用录制或回放后，`Algorithm::getTimeMillisec()` 与计时器均改为使用按帧锁定的虚拟时钟，
+     * `Cursor::position()` 返回每帧开始时的光标位置，从而保证录制与回放时看到的数据完全一致。
+     * @code
+     * // 录制
+     * Replay::global()->startRecording("session.eerp");
+     * engine.exec();
+     * // 回放（在无窗口模式下以最快速度运行，回放结束后自动退出）
+     * Engine engine("Replay", 800, 600, true);
+     * Replay::global()->startPlayback("session.eerp");
+     * engine.exec();
+     * @endcode
+     * @note 自定义事件（`SDL_EVENT_USER` 及以上）、剪贴板及输入法候选词事件包含无法序列化的指针，不会被录制
+     * @since v1.1.0-alpha
+     */
+    class Replay {
+    public:
+        /**
+         * @enum Mode
+         * @brief 工作模式
+         */
+        enum Mode : uint8_t {
+            /// 未启用
+            Idle,
+            /// 录制中
+            Recording,
+            /// 回放中
+            Playing
+        };
+
+        /**
+         * @brief 获取全局录像回放器
+         */
+        static Replay* global();
+        Replay(const Replay&) = delete;
+        Replay& operator=(const Replay&) = delete;
+        ~Replay();
+        /**
+         * @brief 开始录制
+         * @param path 日志保存路径
+         * @return 返回是否成功开始录制
+         * @see stopRecording
+         */
+        bool startRecording(const std::string& path);
+        /**
+         * @brief 停止录制，并写入最后一帧
+         * @return 返回日志是否完整写入
+         * @note 引擎清理时会自动调用
+         */
+        bool stopRecording();
+        /**
+         * @brief 开始回放
+         * @param path           日志路径
+         * @param quit_on_finish 回放结束后是否退出主循环（默认退出）
+         * @return 返回是否成功加载日志
+         *
+         * 回放期间忽略除退出以外的真实输入事件，主循环不再等待帧间隔，
+         * 逻辑更新的步数及是否渲染均与录制时一致。
+         * @see stopPlayback
+         */
+        bool startPlayback(const std::string& path, bool quit_on_finish = true);
+        /**
+         * @brief 停止回放
+         */
+        void stopPlayback();
+        /**
+         * @brief 获取当前工作模式
+         */
+        Mode mode() const;
+        /**
+         * @brief 是否正在录制
+         */
+        bool isRecording() const;
+        /**
+         * @brief 是否正在回放
+         */
+        bool isPlaying() const;
+        /**
+         * @brief 获取已录制或已回放的帧数
+         */
+        uint64_t frame() const;
+        /**
+         * @brief 获取回放日志中的总帧数
+         * @note 仅在回放时有效
+         */
+        uint64_t frameCount() const;
+        /**
+         * @brief 获取虚拟时钟的当前时间（毫秒）
+         * @note 每帧开始时锁定，同一帧内保持不变
+         */
+        uint64_t timeMillisec() const;
+        /**
+         * @brief 获取当前帧的光标位置（相对于焦点窗口）
+         */
+        Vector2 cursorPosition() const;
+
+        /**
+         * @brief 开始新的一帧
+         * @return 回放结束且需要退出主循环时返回 false
+         * @note 由事件系统在每次处理事件前调用
+         */
+        bool _beginFrame();
+        /**
+         * @brief 获取下一个回放的事件
+         * @param event 用于接收事件
+         * @return 本帧事件已全部取出时返回 false
+         * @note 真实的退出事件会被优先返回，以便中止回放
+         */
+        bool _pollEvent(SEvent* event);
+        /**
+         * @brief 录制事件
+         * @param event 指定事件
+         */
+        void _recordEvent(const SEvent& event);
+        /**
+         * @brief 记录本帧执行的逻辑更新步数
+         */
+        void _setUpdateSteps(uint32_t steps);
+        /**
+         * @brief 获取本帧录制的逻辑更新步数
+         */
+        uint32_t _updateSteps() const;
+        /**
+         * @brief 记录本帧是否渲染
+         */
+        void _setRendered(bool rendered);
+        /**
+         * @brief 获取本帧录制时是否渲染
+         */
+        bool _rendered() const;
+
+    private:
+        explicit Replay() = default;
+        static std::unique_ptr<Replay> _instance;
+        static uint64_t realTimeMillisec();
+        /// 实际时间加上回放结束时记录的偏移量，停止回放后时间从回放进度处平稳推进
+        uint64_t virtualTimeMillisec() const;
+        void flushFrame();
+        std::atomic<Mode> _mode{Idle};
+        std::atomic<uint64_t> _time_ms{0};
+        uint64_t _last_time_ms{0};
+        /// 虚拟时钟相对实际时间的偏移量（毫秒）
+        std::atomic<int64_t> _time_offset_ms{0};
+        uint64_t _frame{0};
+        uint64_t _frame_count{0};
+        Vector2 _cursor;
+        Vector2 _last_cursor;
+        uint32_t _update_steps{0};
+        bool _is_rendered{false};
+        bool _quit_on_finish{true};
+        bool _has_frame{false};
+        /// 录制
+        std::string _path;
+        std::ofstream _file;
+        std::string _frame_buffer;
+        std::string _event_buffer;
+        uint32_t _event_count{0};
+        /// 回放
+        std::vector<uint8_t> _data;
+        std::vector<size_t> _frame_offsets;
+        size_t _events_offset{0};
+        uint32_t _events_remaining{0};
+    };
+}
+
+#endif //EASYENGINE_REPLAY_H
@@ -1,5 +1,17 @@
 
 #include "Resources.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace EasyEngine;
 
 std::string FileSystem::_main_path = std::filesystem::absolute(".").string();
@@ -230,7 +242,8 @@ std::vector<uint8_t> FileSystem::readBinaryFile(const std::string &path, bool ig
 }
 
 std::string FileSystem::getAbsolutePath(const std::string &path) {
-    if (path[1] == ':') return path;
+    if (path.empty()) return _main_path;
+    if (path.front() == '/' || (path.size() > 1 && path[1] == ':')) return path;
     if (path.front() == '.') return fmt::format("{}{}", _main_path, path.substr(path.find_first_of('/')));
     else return fmt::format("{}/{}", _main_path, path);
 //    return (path.front() != '/' ? fmt::format("{}{}", _main_path, path.substr(path.find_first_of('/')))
@@ -267,6 +280,17 @@ std::deque<std::string> FileSystem::getPathUntilNotExist(const std::string &path
     return paths;
 }
 
+ResourceSystem::~ResourceSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_job_mutex);
+        _stop_workers = true;
+    }
+    _job_cv.notify_all();
+    for (auto& worker : _workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
 ResourceSystem *ResourceSystem::global() {
     if (!_instance) {
         _instance = std::unique_ptr<ResourceSystem>(new ResourceSystem());
@@ -285,107 +309,327 @@ ResourceSystem::load(const std::string &name, const std::string &path, const Res
 }
 
 bool ResourceSystem::load(const std::string &name) {
+    Resource::Type type;
+    std::string url;
+    std::shared_ptr<PackFile> pack;
+    std::span<const uint8_t> pack_data;
+    std::shared_future<bool> pending;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        if (!isContain(name)) {
+            SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+            return false;
+        }
+        auto& resource = _resource.at(name);
+        if (resource.is_loaded) {
+            SDL_Log("[ERROR] Resource '%s' is already loaded!", name.c_str());
+            return false;
+        }
+        if (_pending.contains(name)) pending = _pending.at(name).future;
+        type = resource.type;
+        url = resource.url;
+        pack = resource.pack;
+        pack_data = resource.pack_data;
+    }
+    // 正在后台加载中，等待其完成即可
+    if (pending.valid()) return pending.get();
+    ResourceTypes meta_data;
+    if (!decode(name, type, url, pack_data, meta_data)) return false;
+    return store(name, type, url, meta_data);
+}
+
+uint64_t ResourceSystem::preload(const std::vector<std::string> &resource_names) {
+    std::vector<std::string> names = resource_names;
+    if (names.empty()) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        for (auto& res: _resource) names.push_back(res.first);
+    }
+    std::vector<std::shared_future<bool>> results;
+    results.reserve(names.size());
+    for (auto &name: names) {
+        if (isContain(name) && isLoaded(name)) {
+            SDL_Log("[ERROR] Resource '%s' is already loaded!", name.c_str());
+            results.push_back({});
+            continue;
+        }
+        results.push_back(loadAsync(name));
+    }
+    uint64_t err = 0;
+    for (auto& result : results) err += (!result.valid() || !result.get());
+    return err;
+}
+
+void ResourceSystem::asyncLoad(const std::vector<std::string> &resource_names,
+                               const std::function<void(uint64_t)>& callback) {
+    std::vector<std::string> names = resource_names;
+    if (names.empty()) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        for (auto& res : _resource) {
+            if (!res.second.is_loaded) names.push_back(res.first);
+        }
+    }
+    if (names.empty()) {
+        if (callback) EventSystem::global()->postTask([callback] { callback(0); });
+        return;
+    }
+    struct Batch {
+        std::atomic<uint64_t> remaining;
+        std::atomic<uint64_t> failed{0};
+        std::function<void(uint64_t)> callback;
+    };
+    auto batch = std::make_shared<Batch>(names.size(), 0, callback);
+    for (auto& name : names) {
+        loadAsync(name, [batch](bool ok) {
+            if (!ok) batch->failed += 1;
+            // 每个回调均已在主线程中执行，最后一个完成时汇总回调
+            if (--batch->remaining == 0 && batch->callback) batch->callback(batch->failed);
+        });
+    }
+}
+
+std::shared_future<bool> ResourceSystem::loadAsync(const std::string &name,
+                                                   const std::function<void(bool)> &callback) {
+    auto finish = [callback](bool ok) -> std::shared_future<bool> {
+        if (callback) EventSystem::global()->postTask([callback, ok] { callback(ok); });
+        std::promise<bool> result;
+        result.set_value(ok);
+        return result.get_future().share();
+    };
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (!isContain(name)) {
         SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
-        return false;
+        return finish(false);
+    }
+    if (_pending.contains(name)) {
+        auto& pending = _pending.at(name);
+        if (callback) pending.callbacks.push_back(callback);
+        return pending.future;
     }
     auto& resource = _resource.at(name);
-    if (resource.is_loaded) {
-        SDL_Log("[ERROR] Resource '%s' is already loaded!", name.c_str());
-        return false;
+    if (resource.is_loaded) return finish(true);
+    auto task = std::make_shared<std::packaged_task<bool()>>(
+            [this, name, type = resource.type, url = resource.url, pack = resource.pack,
+             pack_data = resource.pack_data]() -> bool {
+        ResourceTypes meta_data;
+        bool ok = decode(name, type, url, pack_data, meta_data) && store(name, type, url, meta_data);
+        ok ? _progress_loaded += 1 : _progress_failed += 1;
+        std::vector<std::function<void(bool)>> callbacks;
+        {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            callbacks = std::move(_pending.at(name).callbacks);
+            _pending.erase(name);
+        }
+        for (auto& cb : callbacks) {
+            EventSystem::global()->postTask([cb, ok] { cb(ok); });
+        }
+        return ok;
+    });
+    auto& pending = _pending[name];
+    pending.future = task->get_future().share();
+    if (callback) pending.callbacks.push_back(callback);
+    _progress_total += 1;
+    enqueue([task] { (*task)(); });
+    return pending.future;
+}
+
+bool ResourceSystem::isLoading(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _pending.contains(name);
+}
+
+ResourceSystem::Progress ResourceSystem::loadProgress() const {
+    return {_progress_total.load(), _progress_loaded.load(), _progress_failed.load()};
+}
+
+void ResourceSystem::resetLoadProgress() {
+    _progress_total = 0;
+    _progress_loaded = 0;
+    _progress_failed = 0;
+}
+
+void ResourceSystem::setWorkerCount(uint32_t count) {
+    std::lock_guard<std::mutex> lock(_job_mutex);
+    if (!_workers.empty()) {
+        SDL_Log("[ERROR] The resource workers are already running!");
+        return;
+    }
+    _worker_count = count;
+}
+
+uint32_t ResourceSystem::workerCount() const {
+    if (_worker_count) return _worker_count;
+    return std::max(1u, std::thread::hardware_concurrency() - 1);
+}
+
+void ResourceSystem::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(_job_mutex);
+        if (_workers.empty()) {
+            auto count = workerCount();
+            for (uint32_t i = 0; i < count; ++i) _workers.emplace_back(&ResourceSystem::workerLoop, this);
+        }
+        _jobs.push_back(std::move(job));
+    }
+    _job_cv.notify_one();
+}
+
+void ResourceSystem::workerLoop() {
+    bool named = false;
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_job_mutex);
+            _job_cv.wait(lock, [this] { return _stop_workers || !_jobs.empty(); });
+            if (_jobs.empty()) return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        if (!named && Profiler::global()->enabled()) {
+            Profiler::global()->setThreadName("ResourceWorker");
+            named = true;
+        }
+        EASYENGINE_PROFILE_ZONE("Load");
+        job();
     }
-    if (resource.type == Resource::Text) {
+}
+
+bool ResourceSystem::decode(const std::string &name, const Resource::Type &type, const std::string &url,
+                            std::span<const uint8_t> pack_data, ResourceTypes &meta_data) {
+    if (pack_data.data()) {
+        // 来自资源包的数据直接从内存映射中解码
+        if (type == Resource::Text) {
+            meta_data = std::string(reinterpret_cast<const char*>(pack_data.data()), pack_data.size());
+            return true;
+        } else if (type == Resource::Image || type == Resource::Font || type == Resource::Audio) {
+            auto io = SDL_IOFromConstMem(pack_data.data(), pack_data.size());
+            void* object = nullptr;
+            if (!io) {
+                // 创建失败，交由下方统一报错
+            } else if (type == Resource::Image) {
+                meta_data = IMG_Load_IO(io, true);
+                object = std::get<SSurface*>(meta_data);
+            } else if (type == Resource::Font) {
+                object = TTF_OpenFontIO(io, true, 12.0f);
+                meta_data = object;
+            } else {
+                object = MIX_LoadAudio_IO(AudioSystem::global()->mixer(), io, true, true);
+                meta_data = object;
+            }
+            if (!object) {
+                SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Decode '%s' failed!\n%s",
+                        name.c_str(), url.c_str(), SDL_GetError());
+                meta_data = {};
+                return false;
+            }
+            return true;
+        }
+        meta_data = std::vector<uint8_t>(pack_data.begin(), pack_data.end());
+        return true;
+    }
+    if (type == Resource::Text) {
         bool is_error;
-        resource.meta_data = FileSystem::readFile(resource.url, false, &is_error);
+        meta_data = FileSystem::readFile(url, false, &is_error);
         if (!is_error) {
             SDL_Log("[ERROR] Resource '%s' loaded failed!", name.c_str());
             return false;
         }
-    } else if (resource.type == Resource::Image) {
-        resource.meta_data = IMG_Load(resource.url.c_str());
-        if (!std::get<SSurface*>(resource.meta_data)) {
+    } else if (type == Resource::Image) {
+        meta_data = IMG_Load(url.c_str());
+        if (!std::get<SSurface*>(meta_data)) {
             SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Load image file '%s' failed!\n",
-                    name.c_str(), resource.url.c_str());
+                    name.c_str(), url.c_str());
             return false;
         }
-    } else if (resource.type == Resource::Font) {
-        TTF_Font* font = TTF_OpenFont(resource.url.c_str(), 12.0f);
+    } else if (type == Resource::Font) {
+        TTF_Font* font = TTF_OpenFont(url.c_str(), 12.0f);
         if (!font) {
             SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Load font file '%s' failed!\n",
-                    name.c_str(), resource.url.c_str());
+                    name.c_str(), url.c_str());
             return false;
         }
-        resource.meta_data = reinterpret_cast<void*>(font);
-    } else if (resource.type == Resource::Audio) {
-        MIX_Audio* audio = MIX_LoadAudio(AudioSystem::global()->mixer(), resource.url.c_str(), true);
+        meta_data = reinterpret_cast<void*>(font);
+    } else if (type == Resource::Audio) {
+        MIX_Audio* audio = MIX_LoadAudio(AudioSystem::global()->mixer(), url.c_str(), true);
         if (!audio) {
             SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Load audio file '%s' failed!\n",
-                    name.c_str(), resource.url.c_str());
+                    name.c_str(), url.c_str());
             return false;
         }
-        resource.meta_data = reinterpret_cast<void*>(audio);
+        meta_data = reinterpret_cast<void*>(audio);
     } else {
         bool ret;
-        resource.meta_data = FileSystem::readBinaryFile(resource.url, false, &ret);
+        meta_data = FileSystem::readBinaryFile(url, false, &ret);
         if (!ret) {
             SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Read binary file '%s' failed!\n",
-                    name.c_str(), resource.url.c_str());
+                    name.c_str(), url.c_str());
             return false;
         }
     }
-    resource.is_loaded = true;
     return true;
 }
 
-uint64_t ResourceSystem::preload(const std::vector<std::string> &resource_names) {
-    uint64_t err = 0;
-    if (resource_names.empty()) {
-        for (auto& name: _resource) err += (!load(name.first));
-    } else {
-        for (auto &name: resource_names) err += (!load(name));
+void ResourceSystem::release(const Resource::Type &type, ResourceTypes &meta_data) {
+    if (type == Resource::Image) {
+        if (std::get<SSurface*>(meta_data))
+            SDL_DestroySurface(std::get<SSurface*>(meta_data));
+    } else if (type == Resource::Font) {
+        auto font = reinterpret_cast<TTF_Font*>(std::get<void*>(meta_data));
+        if (font) TTF_CloseFont(font);
+    } else if (type == Resource::Audio) {
+        auto audio = reinterpret_cast<MIX_Audio*>(std::get<void*>(meta_data));
+        if (audio) MIX_DestroyAudio(audio);
     }
-    return err;
+    meta_data = {};
 }
 
-void ResourceSystem::asyncLoad(const std::vector<std::string> &resource_names,
-                               const std::function<void(uint64_t)>& callback) {
-    const std::vector<std::string>& copy_res_name = resource_names;
-    auto is_ok = std::async(std::launch::async, [this, copy_res_name, callback]() -> bool {
-        uint64_t ret = 0;
-        if (copy_res_name.empty()) {
-            for (auto& name : _resource) ret += (!load(name.first));
-        } else {
-            for (auto& name : copy_res_name) ret += (!load(name));
-        }
-        if (callback) callback(ret);
-        return ret == 0;
-    });
+bool ResourceSystem::store(const std::string &name, const Resource::Type &type, const std::string &url,
+                           ResourceTypes &meta_data) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // 解码期间资源可能已被移除或替换，此时丢弃解码结果
+    if (!isContain(name) || _resource.at(name).url != url) {
+        SDL_Log("[ERROR] Resource '%s' is removed or replaced while loading!", name.c_str());
+        release(type, meta_data);
+        return false;
+    }
+    auto& resource = _resource.at(name);
+    if (resource.is_loaded) {
+        release(type, meta_data);
+        return true;
+    }
+    resource.meta_data = std::move(meta_data);
+    resource.is_loaded = true;
+    resource.bytes = measure(resource);
+    resource.last_access = ++_access_clock;
+    _cache_stats[type].resident_bytes += resource.bytes;
+    enforceBudget(type, name);
+    return true;
 }
 
 bool ResourceSystem::unload(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (!isContain(name)) {
         SDL_Log("[ERROR] Can't find the resource '%s'!", name.c_str());
         return false;
     }
+    pruneSharedTextures();
     auto& resource = _resource.at(name);
     if (!resource.is_loaded) return true;
-    if (resource.type == Resource::Image) {
-        if (std::get<SSurface*>(resource.meta_data))
-            SDL_DestroySurface(std::get<SSurface*>(resource.meta_data));
-    } else if (resource.type == Resource::Font) {
-        auto font = reinterpret_cast<TTF_Font*>(std::get<void*>(resource.meta_data));
-        if (font) TTF_CloseFont(font);
-    } else if (resource.type == Resource::Audio) {
-        auto audio = reinterpret_cast<MIX_Audio*>(std::get<void*>(resource.meta_data));
-        if (audio) MIX_DestroyAudio(audio);
-    }
-    resource.meta_data = {};
+    _cache_stats[resource.type].resident_bytes -= resource.bytes;
+    resource.bytes = 0;
+    release(resource.type, resource.meta_data);
     resource.is_loaded = false;
     SDL_Log("[INFO] Unload Resource: '%s'", name.c_str());
     return true;
 }
 
+uint64_t ResourceSystem::unload(const std::vector<std::string> &resource_names) {
+    uint64_t err = 0;
+    for (auto& name : resource_names) err += (!unload(name));
+    return err;
+}
+
 void ResourceSystem::unloadAll() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     for (auto& res : _resource) {
         unload(res.first);
     }
@@ -393,6 +637,7 @@ void ResourceSystem::unloadAll() {
 
 bool
 ResourceSystem::append(const std::string &name, const std::string &path, const Resource::Type &type) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     std::string real_path = FileSystem::getAbsolutePath(path);
     if (FileSystem::isDir(real_path)) {
         SDL_Log("[ERROR] Path '%s' is the directory, not the file!", real_path.c_str());
@@ -411,17 +656,25 @@ ResourceSystem::append(const std::string &name, const std::string &path, const R
 }
 
 void ResourceSystem::remove(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (unload(name)) {
         _resource.erase(name);
+        removeSharedTexture(name);
+        removeAlphaMask(name);
+        uint32_t id;
+        if (internedId(name, id)) std::erase_if(_manifest, [id](const ManifestEntry& entry) { return entry.name == id; });
     }
 }
 
 bool
 ResourceSystem::replace(const std::string &name, const std::string &path, const Resource::Type &type) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (!isContain(name)) {
         SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str()); return false;
     }
     unload(name);
+    removeSharedTexture(name);
+    removeAlphaMask(name);
     std::string real_path = FileSystem::getAbsolutePath(path);
     if (FileSystem::isDir(real_path)) {
         SDL_Log("[ERROR] Path '%s' is the directory, not the file!", real_path.c_str());
@@ -439,34 +692,841 @@ ResourceSystem::replace(const std::string &name, const std::string &path, const
 }
 
 const ResourceSystem::ResourceTypes& ResourceSystem::metaData(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (!isContain(name)) {
         SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
         throw std::runtime_error(fmt::format("[FATAL] Resource '{}' is not found!", name));
     } else if (!_resource.at(name).is_loaded) {
+        _cache_stats[_resource.at(name).type].misses += 1;
         SDL_Log("[ERROR] Resource '%s' is not loaded!", name.c_str());
         throw std::runtime_error(fmt::format("[FATAL] Resource '{}' is not found!", name));
     }
-    return _resource.at(name).meta_data;
+    auto& resource = _resource.at(name);
+    _cache_stats[resource.type].hits += 1;
+    resource.last_access = ++_access_clock;
+    return resource.meta_data;
+}
+
+const ResourceSystem::ResourceTypes& ResourceSystem::metaData(const std::string &name) {
+    Resource::Type type;
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        if (!isContain(name)) {
+            SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+            throw std::runtime_error(fmt::format("[FATAL] Resource '{}' is not found!", name));
+        }
+        if (_resource.at(name).is_loaded) return std::as_const(*this).metaData(name);
+        type = _resource.at(name).type;
+        _cache_stats[type].misses += 1;
+    }
+    // 加载过程中不持有锁，以免与后台加载相互等待
+    load(name);
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name) || !_resource.at(name).is_loaded) {
+        SDL_Log("[ERROR] Resource '%s' is not loaded!", name.c_str());
+        throw std::runtime_error(fmt::format("[FATAL] Resource '{}' can't be loaded!", name));
+    }
+    auto& resource = _resource.at(name);
+    resource.last_access = ++_access_clock;
+    return resource.meta_data;
 }
 
 const std::string &ResourceSystem::resourcePath(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (isContain(name)) return _resource.at(name).url;
     SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
     return _null_str;
 }
 
 Resource::Type ResourceSystem::resourceType(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (isContain(name)) return _resource.at(name).type;
     SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
     return Resource::None;
 }
 
 bool ResourceSystem::isLoaded(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (isContain(name)) return _resource.at(name).is_loaded;
     SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
     return false;
 }
 
 bool ResourceSystem::isContain(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
     return _resource.contains(name);
 }
+
+std::shared_ptr<SharedTexture> ResourceSystem::sharedTexture(const std::string &name, SRenderer *renderer) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+        return nullptr;
+    }
+    auto& resource = _resource.at(name);
+    if (resource.type != Resource::Image) {
+        SDL_Log("[ERROR] Resource '%s' is not the image file!", name.c_str());
+        return nullptr;
+    }
+    if (!renderer) {
+        SDL_Log("[ERROR] The specified renderer is not valid!");
+        return nullptr;
+    }
+    auto key = std::make_pair(name, renderer);
+    if (_texture_cache.contains(key)) {
+        if (auto cached = _texture_cache.at(key).lock()) return cached;
+    }
+    pruneSharedTextures();
+    SSurface* surface = nullptr;
+    if (resource.is_loaded && std::get<SSurface*>(resource.meta_data)) {
+        // 复用已加载的表面，增加引用计数，由 SharedTexture 负责释放
+        surface = std::get<SSurface*>(resource.meta_data);
+        surface->refcount += 1;
+    } else {
+        surface = decodeImage(resource.url);
+    }
+    if (!surface) {
+        SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Load image file '%s' failed!\n",
+                name.c_str(), resource.url.c_str());
+        return nullptr;
+    }
+    auto texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        SDL_Log("[ERROR] Can't create texture for resource '%s'!\nException: %s", name.c_str(), SDL_GetError());
+        SDL_DestroySurface(surface);
+        return nullptr;
+    }
+    if (_gpu_only) {
+        // 纹理已持有像素数据，释放 CPU 端的表面，需要时再从资源重新解码。
+        // 若表面来自用户加载的资源，此处仅释放缓存持有的引用，资源本身保持加载
+        SDL_DestroySurface(surface);
+        surface = nullptr;
+    }
+    auto shared = std::make_shared<SharedTexture>(name, renderer, surface, texture);
+    _texture_cache[key] = shared;
+    return shared;
+}
+
+size_t ResourceSystem::sharedTextureCount() const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return std::ranges::count_if(_texture_cache, [](const auto& cache) { return !cache.second.expired(); });
+}
+
+void ResourceSystem::removeSharedTexture(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::erase_if(_texture_cache, [&name](const auto& cache) { return cache.first.first == name; });
+}
+
+void ResourceSystem::pruneSharedTextures() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // 最后一个持有者释放后，缓存中只剩下失效的弱引用
+    std::erase_if(_texture_cache, [](const auto& cache) { return cache.second.expired(); });
+}
+
+std::shared_ptr<const AlphaMask> ResourceSystem::alphaMask(const std::string &name, uint8_t threshold) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+        return nullptr;
+    }
+    auto& resource = _resource.at(name);
+    if (resource.type != Resource::Image) {
+        SDL_Log("[ERROR] Resource '%s' is not the image file!", name.c_str());
+        return nullptr;
+    }
+    auto key = std::make_pair(name, threshold);
+    if (_mask_cache.contains(key)) {
+        if (auto cached = _mask_cache.at(key).lock()) return cached;
+    }
+    SSurface* surface = nullptr;
+    bool is_owned = false;
+    if (resource.is_loaded && std::get<SSurface*>(resource.meta_data)) {
+        surface = std::get<SSurface*>(resource.meta_data);
+    } else {
+        for (auto& [texture_key, cache] : _texture_cache) {
+            if (texture_key.first != name) continue;
+            auto shared = cache.lock();
+            if (shared && shared->surface) {
+                surface = shared->surface;
+                break;
+            }
+        }
+    }
+    if (!surface) {
+        surface = decodeImage(resource.url);
+        is_owned = true;
+    }
+    if (!surface) {
+        SDL_Log("[ERROR] Resource '%s' loaded failed!\nException: Load image file '%s' failed!\n",
+                name.c_str(), resource.url.c_str());
+        return nullptr;
+    }
+    std::shared_ptr<const AlphaMask> mask = Algorithm::createAlphaMask(surface, threshold);
+    if (is_owned) SDL_DestroySurface(surface);
+    if (mask) _mask_cache[key] = mask;
+    return mask;
+}
+
+void ResourceSystem::removeAlphaMask(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::erase_if(_mask_cache, [&name](const auto& cache) { return cache.first.first == name; });
+}
+
+void ResourceSystem::setGPUOnlyMode(bool enabled) {
+    _gpu_only = enabled;
+}
+
+bool ResourceSystem::isGPUOnlyMode() const {
+    return _gpu_only;
+}
+
+uint64_t ResourceSystem::restoreSharedTextures(Painter *painter) {
+    if (!painter || !painter->window()) {
+        SDL_Log("[ERROR] The specified painter is not valid!");
+        return 0;
+    }
+    // 渲染线程可能正在执行仍引用旧纹理的帧；与创建精灵时的加锁顺序一致，先锁定渲染器
+    auto renderer_lock = painter->lockRenderer();
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    auto renderer = painter->window()->renderer;
+    uint64_t err = 0;
+    for (auto& [key, cache] : _texture_cache) {
+        if (key.second != renderer) continue;
+        auto shared = cache.lock();
+        if (!shared) continue;
+        SSurface* surface = shared->surface;
+        if (!surface) surface = decodeImage(resourcePath(key.first));
+        if (!surface) {
+            SDL_Log("[ERROR] Can't restore texture for resource '%s'!\nException: %s",
+                    key.first.c_str(), SDL_GetError());
+            err += 1;
+            continue;
+        }
+        auto texture = SDL_CreateTextureFromSurface(key.second, surface);
+        if (texture) {
+            if (shared->texture) {
+                Painter::_deferRelease(painter, [old = shared->texture] { SDL_DestroyTexture(old); });
+            }
+            shared->texture = texture;
+        } else {
+            SDL_Log("[ERROR] Can't restore texture for resource '%s'!\nException: %s",
+                    key.first.c_str(), SDL_GetError());
+            err += 1;
+        }
+        if (surface != shared->surface) SDL_DestroySurface(surface);
+    }
+    return err;
+}
+
+MemoryUsage ResourceSystem::memoryUsage() const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // 以对象地址去重，避免共享的表面或纹理被重复计算
+    std::map<const void*, uint64_t> cpu, gpu;
+    for (auto& [name, resource] : _resource) {
+        if (!resource.is_loaded || resource.type != Resource::Image) continue;
+        auto surface = std::get<SSurface*>(resource.meta_data);
+        if (surface) cpu[surface] = surfaceBytes(surface);
+    }
+    for (auto& [key, cache] : _texture_cache) {
+        auto shared = cache.lock();
+        if (!shared) continue;
+        if (shared->surface) cpu[shared->surface] = surfaceBytes(shared->surface);
+        if (shared->texture) gpu[shared->texture] = textureBytes(shared->texture);
+    }
+    Components::Sprite::_collectMemoryUsage(cpu, gpu);
+    MemoryUsage usage;
+    for (auto& bytes : cpu) usage.cpu_bytes += bytes.second;
+    for (auto& bytes : gpu) usage.gpu_bytes += bytes.second;
+    return usage;
+}
+
+uint64_t ResourceSystem::surfaceBytes(const SSurface *surface) {
+    if (!surface) return 0;
+    return static_cast<uint64_t>(surface->pitch) * surface->h;
+}
+
+uint64_t ResourceSystem::textureBytes(const STexture *texture) {
+    if (!texture) return 0;
+    return static_cast<uint64_t>(texture->w) * texture->h * SDL_BYTESPERPIXEL(texture->format);
+}
+
+SharedTexture::SharedTexture(const std::string &resource_name, SRenderer *renderer, SSurface *surface,
+                             STexture *texture)
+    : resource_name(resource_name), renderer(renderer), surface(surface), texture(texture) {}
+
+SharedTexture::SharedTexture(SharedTexture &&other) noexcept
+    : resource_name(std::move(other.resource_name)), renderer(other.renderer),
+      surface(std::exchange(other.surface, nullptr)), texture(std::exchange(other.texture, nullptr)) {}
+
+SharedTexture &SharedTexture::operator=(SharedTexture &&other) noexcept {
+    if (this == &other) return *this;
+    if (texture) SDL_DestroyTexture(texture);
+    if (surface) SDL_DestroySurface(surface);
+    resource_name = std::move(other.resource_name);
+    renderer = other.renderer;
+    surface = std::exchange(other.surface, nullptr);
+    texture = std::exchange(other.texture, nullptr);
+    return *this;
+}
+
+SharedTexture::~SharedTexture() {
+    if (texture) SDL_DestroyTexture(texture);
+    if (surface) SDL_DestroySurface(surface);
+}
+
+uint64_t ResourceSystem::mountPack(const std::string &path, const std::string &prefix) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::string real_path = FileSystem::getAbsolutePath(path);
+    if (_packs.contains(real_path)) {
+        SDL_Log("[ERROR] Pack '%s' is already mounted!", real_path.c_str());
+        return 0;
+    }
+    auto pack = std::make_shared<PackFile>();
+    if (!pack->open(real_path)) return 0;
+    uint64_t count = 0;
+    for (auto& entry : pack->entries()) {
+        std::string name = prefix + entry.name;
+        if (isContain(name)) {
+            SDL_Log("[ERROR] Resource '%s' is already exist! Skip the entry in pack '%s'.",
+                    name.c_str(), real_path.c_str());
+            continue;
+        }
+        auto data = pack->data(entry.name);
+        if (!data.data()) continue;
+        _resource.emplace(name, Resource{entry.type, real_path + "#" + entry.name, false, {}, pack, data});
+        count += 1;
+    }
+    _packs.emplace(real_path, pack);
+    return count;
+}
+
+void ResourceSystem::unmountPack(const std::string &path) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::string real_path = FileSystem::getAbsolutePath(path);
+    if (!_packs.contains(real_path)) {
+        SDL_Log("[ERROR] Pack '%s' is not mounted!", real_path.c_str());
+        return;
+    }
+    auto pack = _packs.at(real_path);
+    std::vector<std::string> names;
+    for (auto& res : _resource) {
+        if (res.second.pack == pack) names.push_back(res.first);
+    }
+    for (auto& name : names) remove(name);
+    _packs.erase(real_path);
+}
+
+std::span<const uint8_t> ResourceSystem::packData(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+        return {};
+    }
+    return _resource.at(name).pack_data;
+}
+
+SSurface *ResourceSystem::decodeImage(const std::string &url) const {
+    auto io = openIO(url);
+    if (!io) return nullptr;
+    return IMG_Load_IO(io, true);
+}
+
+SDL_IOStream *ResourceSystem::openIO(const std::string &url) const {
+    auto sep = url.rfind('#');
+    if (sep != std::string::npos) {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        auto pack_path = url.substr(0, sep);
+        if (_packs.contains(pack_path)) return _packs.at(pack_path)->openIO(url.substr(sep + 1));
+    }
+    return SDL_IOFromFile(url.c_str(), "rb");
+}
+
+PackFile::~PackFile() {
+    close();
+}
+
+bool PackFile::open(const std::string &path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SDL_Log("[ERROR] Can't open pack file '%s'!", path.c_str());
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+        SDL_Log("[ERROR] Pack file '%s' is not valid!", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        SDL_Log("[ERROR] Can't map pack file '%s'!", path.c_str());
+        return false;
+    }
+    // 映射视图会保持映射对象存活，句柄可立即关闭
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        SDL_Log("[ERROR] Can't map pack file '%s'!", path.c_str());
+        return false;
+    }
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<uint64_t>(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SDL_Log("[ERROR] Can't open pack file '%s'!", path.c_str());
+        return false;
+    }
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(Header))) {
+        SDL_Log("[ERROR] Pack file '%s' is not valid!", path.c_str());
+        ::close(fd);
+        return false;
+    }
+    // 映射建立后即可关闭文件描述符
+    auto view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        SDL_Log("[ERROR] Can't map pack file '%s'!", path.c_str());
+        return false;
+    }
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<uint64_t>(file_stat.st_size);
+#endif
+    _path = path;
+    if (!parse()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PackFile::close() {
+    if (_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap(const_cast<uint8_t*>(_data), static_cast<size_t>(_size));
+#endif
+    }
+    _data = nullptr;
+    _size = 0;
+    _path.clear();
+    _entries.clear();
+    _index.clear();
+}
+
+bool PackFile::isOpen() const {
+    return _data != nullptr;
+}
+
+const std::string &PackFile::path() const {
+    return _path;
+}
+
+const std::vector<PackFile::Entry> &PackFile::entries() const {
+    return _entries;
+}
+
+bool PackFile::contains(const std::string &name) const {
+    return _index.contains(name);
+}
+
+const PackFile::Entry *PackFile::entry(const std::string &name) const {
+    if (!_index.contains(name)) return nullptr;
+    return &_entries[_index.at(name)];
+}
+
+std::span<const uint8_t> PackFile::data(const std::string &name) const {
+    auto target = entry(name);
+    if (!target) {
+        SDL_Log("[ERROR] Entry '%s' is not found in pack '%s'!", name.c_str(), _path.c_str());
+        return {};
+    }
+    if (target->compression != Compression::None) {
+        SDL_Log("[ERROR] Entry '%s' in pack '%s' is compressed, which is not supported yet!",
+                name.c_str(), _path.c_str());
+        return {};
+    }
+    return {_data + target->offset, static_cast<size_t>(target->size)};
+}
+
+SDL_IOStream *PackFile::openIO(const std::string &name) const {
+    auto view = data(name);
+    if (!view.data()) return nullptr;
+    return SDL_IOFromConstMem(view.data(), view.size());
+}
+
+bool PackFile::parse() {
+    Header header;
+    std::memcpy(&header, _data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        SDL_Log("[ERROR] File '%s' is not a pack file!", _path.c_str());
+        return false;
+    }
+    if (header.version != VERSION) {
+        SDL_Log("[ERROR] Pack file '%s' has unsupported version %u!", _path.c_str(), header.version);
+        return false;
+    }
+    if (header.toc_offset > _size || header.toc_size > _size - header.toc_offset) {
+        SDL_Log("[ERROR] Pack file '%s' is damaged!", _path.c_str());
+        return false;
+    }
+    _entries.reserve(header.entry_count);
+    uint64_t cursor = header.toc_offset;
+    const uint64_t toc_end = header.toc_offset + header.toc_size;
+    for (uint32_t i = 0; i < header.entry_count; ++i) {
+        TocRecord record;
+        if (toc_end - cursor < sizeof(TocRecord)) {
+            SDL_Log("[ERROR] Pack file '%s' is damaged!", _path.c_str());
+            return false;
+        }
+        std::memcpy(&record, _data + cursor, sizeof(TocRecord));
+        cursor += sizeof(TocRecord);
+        // 未压缩的条目直接以原始大小返回数据视图，两种大小都必须位于文件范围内且一致
+        if (toc_end - cursor < record.name_length || record.offset > _size ||
+            record.stored_size > _size - record.offset || record.size > _size - record.offset ||
+            (record.compression == static_cast<uint8_t>(Compression::None) && record.size != record.stored_size)) {
+            SDL_Log("[ERROR] Pack file '%s' is damaged!", _path.c_str());
+            return false;
+        }
+        std::string name(reinterpret_cast<const char*>(_data + cursor), record.name_length);
+        cursor += record.name_length;
+        _index[name] = _entries.size();
+        _entries.push_back({std::move(name), static_cast<Resource::Type>(record.type),
+                            static_cast<Compression>(record.compression),
+                            record.offset, record.size, record.stored_size});
+    }
+    return true;
+}
+
+bool PackFile::build(const std::string &output, const std::vector<Source> &sources, uint32_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        SDL_Log("[ERROR] The alignment %u is not the power of 2!", alignment);
+        return false;
+    }
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_Log("[ERROR] Can't create pack file '%s'!", output.c_str());
+        return false;
+    }
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entry_count = static_cast<uint32_t>(sources.size());
+    header.alignment = alignment;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    std::vector<TocRecord> records;
+    records.reserve(sources.size());
+    std::vector<char> buffer;
+    uint64_t offset = sizeof(Header);
+    for (auto& source : sources) {
+        if (source.name.size() > UINT16_MAX) {
+            SDL_Log("[ERROR] The entry name '%s' is too long!", source.name.c_str());
+            return false;
+        }
+        std::ifstream input(source.path, std::ios::binary | std::ios::ate);
+        if (!input.is_open()) {
+            SDL_Log("[ERROR] Can't open source file '%s'!", source.path.c_str());
+            return false;
+        }
+        auto size = static_cast<uint64_t>(input.tellg());
+        input.seekg(0);
+        buffer.resize(size);
+        input.read(buffer.data(), static_cast<std::streamsize>(size));
+        // 填充至对齐位置
+        uint64_t aligned = (offset + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+        for (; offset < aligned; ++offset) file.put('\0');
+        file.write(buffer.data(), static_cast<std::streamsize>(size));
+        records.push_back({offset, size, size, static_cast<uint8_t>(source.type),
+                           static_cast<uint8_t>(Compression::None),
+                           static_cast<uint16_t>(source.name.size()), 0});
+        offset += size;
+    }
+    header.toc_offset = offset;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        file.write(reinterpret_cast<const char*>(&records[i]), sizeof(TocRecord));
+        file.write(sources[i].name.data(), static_cast<std::streamsize>(sources[i].name.size()));
+        header.toc_size += sizeof(TocRecord) + sources[i].name.size();
+    }
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (!file.good()) {
+        SDL_Log("[ERROR] Write pack file '%s' failed!", output.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint64_t ResourceSystem::loadManifest(const std::string &path) {
+    static const std::map<std::string, Resource::Type, std::less<>> TYPES = {
+            {"image", Resource::Image}, {"text", Resource::Text}, {"font", Resource::Font},
+            {"audio", Resource::Audio}, {"video", Resource::Video}, {"binary", Resource::Binary}
+    };
+    std::string real_path = FileSystem::getAbsolutePath(path);
+    std::ifstream file(real_path);
+    if (!file.is_open()) {
+        SDL_Log("[ERROR] Can't open manifest file '%s'!", real_path.c_str());
+        return 0;
+    }
+    auto base_dir = std::filesystem::path(real_path).parent_path();
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // 按文件大小预估条目数（每行约 32 字节），避免解析过程中反复扩容
+    std::error_code ec;
+    _manifest.reserve(_manifest.size() + std::filesystem::file_size(real_path, ec) / 32 + 1);
+
+    uint32_t group = NO_GROUP;
+    uint64_t count = 0, line_number = 0;
+    std::string line;
+    std::vector<std::string_view> tokens;
+    while (std::getline(file, line)) {
+        line_number += 1;
+        tokens.clear();
+        bool is_valid = true;
+        for (size_t i = 0; i < line.size();) {
+            if (std::isspace(static_cast<unsigned char>(line[i]))) { ++i; continue; }
+            if (line[i] == '#') break;
+            size_t end;
+            if (line[i] == '"') {
+                end = line.find('"', i + 1);
+                if (end == std::string::npos) {
+                    SDL_Log("[ERROR] %s:%llu: Missing the closing quotation mark!", real_path.c_str(),
+                            static_cast<unsigned long long>(line_number));
+                    is_valid = false;
+                    break;
+                }
+                tokens.emplace_back(line.data() + i + 1, end - i - 1);
+                i = end + 1;
+                continue;
+            }
+            end = i;
+            while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end])) && line[end] != '#') ++end;
+            tokens.emplace_back(line.data() + i, end - i);
+            i = end;
+        }
+        if (!is_valid || tokens.empty()) continue;
+        if (tokens[0].front() == '[') {
+            if (tokens.size() != 1 || tokens[0].size() < 3 || tokens[0].back() != ']') {
+                SDL_Log("[ERROR] %s:%llu: Invalid group declaration!", real_path.c_str(),
+                        static_cast<unsigned long long>(line_number));
+                continue;
+            }
+            group = intern(tokens[0].substr(1, tokens[0].size() - 2));
+            continue;
+        }
+        if (tokens.size() < 3) {
+            SDL_Log("[ERROR] %s:%llu: Expected `<type> <name> <path> [tag ...]`!", real_path.c_str(),
+                    static_cast<unsigned long long>(line_number));
+            continue;
+        }
+        std::string type_name(tokens[0]);
+        std::ranges::transform(type_name, type_name.begin(), [](unsigned char c) { return std::tolower(c); });
+        auto type = TYPES.find(type_name);
+        if (type == TYPES.end()) {
+            SDL_Log("[ERROR] %s:%llu: Unknown resource type '%s'!", real_path.c_str(),
+                    static_cast<unsigned long long>(line_number), type_name.c_str());
+            continue;
+        }
+        std::filesystem::path resource_path(tokens[2]);
+        if (resource_path.is_relative()) resource_path = base_dir / resource_path;
+        std::string name(tokens[1]);
+        if (!append(name, resource_path.string(), type->second)) continue;
+        uint64_t tags = 0;
+        for (size_t i = 3; i < tokens.size(); ++i) {
+            auto tag = intern(tokens[i]);
+            if (!_tag_bits.contains(tag)) {
+                if (_tag_bits.size() >= 64) {
+                    SDL_Log("[ERROR] %s:%llu: Too many tags! Tag '%s' is ignored.", real_path.c_str(),
+                            static_cast<unsigned long long>(line_number), _interned[tag].c_str());
+                    continue;
+                }
+                auto bit = static_cast<uint8_t>(_tag_bits.size());
+                _tag_bits.emplace(tag, bit);
+            }
+            tags |= (1ULL << _tag_bits.at(tag));
+        }
+        _manifest.push_back({intern(name), group, tags});
+        count += 1;
+    }
+    return count;
+}
+
+std::vector<std::string> ResourceSystem::groupResources(const std::string &group) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::vector<std::string> names;
+    uint32_t id;
+    if (!internedId(group, id)) return names;
+    for (auto& entry : _manifest) {
+        if (entry.group == id) names.push_back(_interned[entry.name]);
+    }
+    return names;
+}
+
+std::vector<std::string> ResourceSystem::taggedResources(const std::string &tag) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::vector<std::string> names;
+    uint32_t id;
+    if (!internedId(tag, id) || !_tag_bits.contains(id)) return names;
+    const uint64_t mask = 1ULL << _tag_bits.at(id);
+    for (auto& entry : _manifest) {
+        if (entry.tags & mask) names.push_back(_interned[entry.name]);
+    }
+    return names;
+}
+
+uint64_t ResourceSystem::preloadGroup(const std::string &group) {
+    auto names = groupResources(group);
+    // 空列表会被 preload 视为加载全部资源
+    if (names.empty()) return 0;
+    return preload(names);
+}
+
+void ResourceSystem::asyncLoadGroup(const std::string &group, const std::function<void(uint64_t)> &callback) {
+    auto names = groupResources(group);
+    if (names.empty()) {
+        if (callback) EventSystem::global()->postTask([callback] { callback(0); });
+        return;
+    }
+    asyncLoad(names, callback);
+}
+
+uint64_t ResourceSystem::unloadGroup(const std::string &group) {
+    return unload(groupResources(group));
+}
+
+uint32_t ResourceSystem::intern(std::string_view str) {
+    if (auto iter = _intern_index.find(str); iter != _intern_index.end()) return iter->second;
+    // std::deque 追加元素时不会使已有元素失效，索引可直接引用其中的字符串
+    auto& stored = _interned.emplace_back(str);
+    auto id = static_cast<uint32_t>(_interned.size() - 1);
+    _intern_index.emplace(std::string_view(stored), id);
+    return id;
+}
+
+bool ResourceSystem::internedId(std::string_view str, uint32_t &id) const {
+    auto iter = _intern_index.find(str);
+    if (iter == _intern_index.end()) return false;
+    id = iter->second;
+    return true;
+}
+
+void ResourceSystem::setBudget(Resource::Type type, uint64_t bytes) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _cache_stats[type].budget = bytes;
+    enforceBudget(type);
+}
+
+uint64_t ResourceSystem::budget(Resource::Type type) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _cache_stats.contains(type) ? _cache_stats.at(type).budget : 0;
+}
+
+bool ResourceSystem::pin(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+        return false;
+    }
+    _resource.at(name).pin_count += 1;
+    return true;
+}
+
+bool ResourceSystem::unpin(const std::string &name) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!isContain(name)) {
+        SDL_Log("[ERROR] Resource '%s' is not found!", name.c_str());
+        return false;
+    }
+    auto& resource = _resource.at(name);
+    if (!resource.pin_count) {
+        SDL_Log("[ERROR] Resource '%s' is not pinned!", name.c_str());
+        return false;
+    }
+    resource.pin_count -= 1;
+    // 解除固定后，该资源可能已超出预算
+    if (!resource.pin_count) enforceBudget(resource.type);
+    return true;
+}
+
+bool ResourceSystem::isPinned(const std::string &name) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return isContain(name) && _resource.at(name).pin_count > 0;
+}
+
+ResourceSystem::CacheStats ResourceSystem::cacheStats(Resource::Type type) const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return _cache_stats.contains(type) ? _cache_stats.at(type) : CacheStats{};
+}
+
+ResourceSystem::CacheStats ResourceSystem::cacheStats() const {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    CacheStats total;
+    for (auto& [type, stats] : _cache_stats) {
+        total.budget += stats.budget;
+        total.resident_bytes += stats.resident_bytes;
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+    }
+    return total;
+}
+
+void ResourceSystem::resetCacheStats() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    for (auto& stats : _cache_stats) {
+        stats.second.hits = 0;
+        stats.second.misses = 0;
+        stats.second.evictions = 0;
+    }
+}
+
+uint64_t ResourceSystem::measure(const Resource &resource) {
+    auto fileSize = [&resource]() -> uint64_t {
+        if (resource.pack_data.data()) return resource.pack_data.size();
+        std::error_code ec;
+        auto size = std::filesystem::file_size(resource.url, ec);
+        return ec ? 0 : size;
+    };
+    if (resource.type == Resource::Image) {
+        return surfaceBytes(std::get<SSurface*>(resource.meta_data));
+    } else if (resource.type == Resource::Font) {
+        return fileSize();
+    } else if (resource.type == Resource::Audio) {
+        // 音频已预解码，按 PCM 数据量计算
+        auto audio = reinterpret_cast<MIX_Audio*>(std::get<void*>(resource.meta_data));
+        SDL_AudioSpec spec;
+        auto frames = audio ? MIX_GetAudioDuration(audio) : -1;
+        if (frames > 0 && MIX_GetAudioFormat(audio, &spec))
+            return static_cast<uint64_t>(frames) * spec.channels * SDL_AUDIO_BYTESIZE(spec.format);
+        return fileSize();
+    } else if (auto text = std::get_if<std::string>(&resource.meta_data)) {
+        return text->size();
+    } else if (auto binary = std::get_if<std::vector<uint8_t>>(&resource.meta_data)) {
+        return binary->size();
+    }
+    return 0;
+}
+
+void ResourceSystem::enforceBudget(Resource::Type type, const std::string &keep) {
+    auto& stats = _cache_stats[type];
+    while (stats.budget && stats.resident_bytes > stats.budget) {
+        // 淘汰最近最少使用且未固定的资源，刚加载的资源除外
+        const std::string* victim = nullptr;
+        uint64_t oldest = UINT64_MAX;
+        for (auto& [name, resource] : _resource) {
+            if (resource.type != type || !resource.is_loaded || resource.pin_count || name == keep) continue;
+            if (resource.last_access < oldest) {
+                oldest = resource.last_access;
+                victim = &name;
+            }
+        }
+        if (!victim) break;
+        unload(*victim);
+        stats.evictions += 1;
+    }
+}
@@ -14,6 +14,8 @@
 
 namespace EasyEngine {
     class AudioSystem;
+    class PackFile;
+    class Painter;
     /**
      * @class FileSystem
      * @brief 文件系统
@@ -181,6 +183,194 @@ namespace EasyEngine {
         bool is_loaded;
         /// 元数据
         std::variant<std::monostate, std::string, SSurface*, char*, void*, std::vector<uint8_t>> meta_data;
+        /// 所属资源包（为空表示来自文件系统）
+        std::shared_ptr<PackFile> pack{};
+        /// 资源在资源包中的数据视图
+        std::span<const uint8_t> pack_data{};
+        /// 已加载时占用的字节数（估算）
+        uint64_t bytes{0};
+        /// 最近一次访问的序号（用于 LRU 淘汰）
+        mutable uint64_t last_access{0};
+        /// 固定计数，大于 0 时不会被淘汰
+        uint32_t pin_count{0};
+    };
+
+    /**
+     * @struct SharedTexture
+     * @brief 共享纹理
+     *
+     * 由 `ResourceSystem::sharedTexture()` 按（资源名称，渲染器）创建并缓存，
+     * 使用同一图片资源的多个精灵共同持有同一份纹理及表面。当最后一个持有者释放时，自动销毁。
+     * 在仅 GPU 驻留模式下，`surface` 将在纹理上传后被释放（为 `nullptr`）。
+     * @see ResourceSystem::sharedTexture
+     * @since v1.1.0-alpha
+     */
+    struct SharedTexture {
+        /// 资源名称
+        std::string resource_name;
+        /// 所属渲染器
+        SRenderer* renderer{nullptr};
+        /// 图片表面
+        SSurface* surface{nullptr};
+        /// 纹理
+        STexture* texture{nullptr};
+        SharedTexture(const std::string& resource_name, SRenderer* renderer, SSurface* surface, STexture* texture);
+        /// 纹理与表面只能有一个持有者，仅允许移动
+        SharedTexture(const SharedTexture&) = delete;
+        SharedTexture& operator=(const SharedTexture&) = delete;
+        SharedTexture(SharedTexture&& other) noexcept;
+        SharedTexture& operator=(SharedTexture&& other) noexcept;
+        ~SharedTexture();
+    };
+
+    /**
+     * @class PackFile
+     * @brief 资源包
+     *
+     * 将多个资源文件打包为一个带索引的归档文件，并以内存映射的方式只读打开，
+     * 各资源的数据可直接以 `std::span` 或 `SDL_IOStream` 的形式访问，无需复制。
+     *
+     * 文件布局（小端序）：
+     * - 文件头：魔数 `EEPK`、版本、条目数、对齐字节数、目录偏移及大小；
+     * - 数据块：各资源数据，起始位置按对齐字节数对齐；
+     * - 目录：每个条目的偏移、原始大小、存储大小、资源类型、压缩方式及名称。
+     *
+     * @note 目录中为每个条目预留了压缩方式字段，当前版本仅支持未压缩（`Compression::None`）的条目。
+     * @see ResourceSystem::mountPack
+     * @since v1.1.0-alpha
+     */
+    class PackFile {
+    public:
+        /// 文件魔数
+        static constexpr char MAGIC[4] = {'E', 'E', 'P', 'K'};
+        /// 当前格式版本
+        static constexpr uint32_t VERSION = 1;
+        /**
+         * @enum Compression
+         * @brief 条目压缩方式
+         */
+        enum class Compression : uint8_t {
+            /// 未压缩
+            None = 0,
+            /// LZ4（预留）
+            LZ4 = 1,
+            /// Zstandard（预留）
+            Zstd = 2
+        };
+        /**
+         * @struct Entry
+         * @brief 资源包条目
+         */
+        struct Entry {
+            /// 条目名称
+            std::string name;
+            /// 资源类型
+            Resource::Type type;
+            /// 压缩方式
+            Compression compression;
+            /// 数据在文件中的偏移
+            uint64_t offset;
+            /// 原始大小
+            uint64_t size;
+            /// 存储大小
+            uint64_t stored_size;
+        };
+        /**
+         * @struct Source
+         * @brief 打包时使用的源文件
+         * @see build
+         */
+        struct Source {
+            /// 条目名称
+            std::string name;
+            /// 源文件路径
+            std::string path;
+            /// 资源类型
+            Resource::Type type;
+        };
+        explicit PackFile() = default;
+        ~PackFile();
+        PackFile(const PackFile&) = delete;
+        PackFile& operator=(const PackFile&) = delete;
+        /**
+         * @brief 以内存映射方式打开资源包
+         * @param path 资源包路径
+         * @return 返回是否成功打开
+         */
+        bool open(const std::string& path);
+        /**
+         * @brief 关闭资源包并解除内存映射
+         * @warning 关闭后，之前获取的所有数据视图都将失效！
+         */
+        void close();
+        /**
+         * @brief 资源包是否已打开
+         */
+        bool isOpen() const;
+        /**
+         * @brief 获取资源包路径
+         */
+        const std::string& path() const;
+        /**
+         * @brief 获取所有条目
+         */
+        const std::vector<Entry>& entries() const;
+        /**
+         * @brief 资源包中是否包含指定条目
+         * @param name 条目名称
+         */
+        bool contains(const std::string& name) const;
+        /**
+         * @brief 获取指定条目
+         * @param name 条目名称
+         * @return 若不存在，则返回 `nullptr`
+         */
+        const Entry* entry(const std::string& name) const;
+        /**
+         * @brief 获取指定条目的数据视图（零拷贝）
+         * @param name 条目名称
+         * @return 若条目不存在或已压缩，则返回空视图
+         */
+        std::span<const uint8_t> data(const std::string& name) const;
+        /**
+         * @brief 为指定条目创建只读的 `SDL_IOStream`（零拷贝）
+         * @param name 条目名称
+         * @return 返回新的 IO 流，需由调用者关闭；失败时返回 `nullptr`
+         */
+        SDL_IOStream* openIO(const std::string& name) const;
+        /**
+         * @brief 将多个源文件打包为资源包
+         * @param output    输出路径
+         * @param sources   源文件列表
+         * @param alignment 数据块对齐字节数（须为 2 的幂，默认为 16）
+         * @return 返回是否打包成功
+         */
+        static bool build(const std::string& output, const std::vector<Source>& sources, uint32_t alignment = 16);
+
+    private:
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t entry_count;
+            uint32_t alignment;
+            uint64_t toc_offset;
+            uint64_t toc_size;
+        };
+        struct TocRecord {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t stored_size;
+            uint8_t type;
+            uint8_t compression;
+            uint16_t name_length;
+            uint32_t reserved;
+        };
+        bool parse();
+        std::string _path;
+        const uint8_t* _data{nullptr};
+        uint64_t _size{0};
+        std::vector<Entry> _entries;
+        std::unordered_map<std::string, size_t> _index;
     };
 
     /**
@@ -193,10 +383,45 @@ namespace EasyEngine {
         /// 资源类型
         using ResourceTypes =
                 std::variant<std::monostate, std::string, SSurface *, char *, void *, std::vector<uint8_t>>;
+        /**
+         * @struct Progress
+         * @brief 后台加载进度
+         * @see loadProgress
+         * @since v1.1.0-alpha
+         */
+        struct Progress {
+            /// 已提交的后台加载任务总数
+            uint64_t total{0};
+            /// 加载成功的个数
+            uint64_t loaded{0};
+            /// 加载失败的个数
+            uint64_t failed{0};
+            /// 已完成的比例（0.0 ~ 1.0），无任务时为 1.0
+            float ratio() const { return total ? static_cast<float>(loaded + failed) / total : 1.0f; }
+        };
+        /**
+         * @struct CacheStats
+         * @brief 资源驻留统计
+         * @see cacheStats
+         * @since v1.1.0-alpha
+         */
+        struct CacheStats {
+            /// 字节预算（0 表示不限制）
+            uint64_t budget{0};
+            /// 当前驻留的字节数
+            uint64_t resident_bytes{0};
+            /// 访问时资源已加载的次数
+            uint64_t hits{0};
+            /// 访问时资源未加载、需要（重新）加载的次数
+            uint64_t misses{0};
+            /// 因超出预算而被淘汰的次数
+            uint64_t evictions{0};
+        };
         /**
          * @brief 获取全局资源系统
          */
         static ResourceSystem* global();
+        ~ResourceSystem();
         /**
          * @brief 设置根目录
          * @param path 指定目录
@@ -222,24 +447,234 @@ namespace EasyEngine {
          * @brief 预加载多个现有的资源
          * @param resource_names 指定的资源名列表（若为空，则默认加载全部资源）
          * @return 返回加载失败的个数。若为 0，则加载所有资源成功！
+         *
+         * 自 v1.1.0-alpha 版本，资源将由后台工作线程并行解码，此函数阻塞直至全部完成。
          * @see load
          * @see asyncLoad
          */
         uint64_t preload(const std::vector<std::string>& resource_names);
         /**
          * @brief 异步加载多个现有的资源
-         * @param resource_names 指定的资源名列表（若为空，则默认加载全部资源）
-         * @param callback       当加载完成后执行回调函数（默认未定义）
+         * @param resource_names 指定的资源名列表（若为空，则默认加载全部未加载的资源）
+         * @param callback       当全部加载完成后执行回调函数，参数为加载失败的个数（默认未定义）
+         *
+         * 资源将由后台工作线程并行解码，函数立即返回。
+         * @note 自 v1.1.0-alpha 版本，回调函数将通过事件系统在主线程中执行。
          * @see load
          * @see preload
+         * @see loadAsync
          */
         void asyncLoad(const std::vector<std::string>& resource_names,
                        const std::function<void(uint64_t)>& callback = {});
+        /**
+         * @brief 在后台加载指定资源
+         * @param name     指定的资源名称
+         * @param callback 加载完成后执行的回调函数，参数表示是否加载成功（默认未定义）
+         * @return 返回可等待的加载结果。若该资源正在加载中，将返回同一个结果；若已加载，则直接返回 `true`
+         *
+         * 图片、字体、音频等资源的解码在后台工作线程中进行，完成后才写入资源表。
+         * @note 回调函数将通过事件系统在主线程中执行，因此需要引擎主循环正在运行。
+         * @see asyncLoad
+         * @see loadProgress
+         * @since v1.1.0-alpha
+         */
+        std::shared_future<bool> loadAsync(const std::string& name,
+                                           const std::function<void(bool)>& callback = {});
+        /**
+         * @brief 指定资源是否正在后台加载中
+         * @param name 指定的资源名称
+         * @since v1.1.0-alpha
+         */
+        bool isLoading(const std::string& name) const;
+        /**
+         * @brief 获取后台加载进度
+         * @see resetLoadProgress
+         * @since v1.1.0-alpha
+         */
+        Progress loadProgress() const;
+        /**
+         * @brief 重置后台加载进度计数
+         * @note 通常在开始加载新的关卡之前调用
+         * @since v1.1.0-alpha
+         */
+        void resetLoadProgress();
+        /**
+         * @brief 设置后台加载的工作线程数
+         * @param count 线程数（为 0 时使用硬件并发数减一，至少为 1）
+         * @note 仅在工作线程启动（首次后台加载）之前有效
+         * @since v1.1.0-alpha
+         */
+        void setWorkerCount(uint32_t count);
+        /**
+         * @brief 获取后台加载的工作线程数
+         * @since v1.1.0-alpha
+         */
+        uint32_t workerCount() const;
+        /**
+         * @brief 挂载资源包
+         * @param path   资源包路径
+         * @param prefix 资源名称前缀（默认为空）
+         * @return 返回成功添加的资源个数，打开失败时返回 0
+         *
+         * 资源包中的每个条目都将以 `prefix + 条目名称` 添加到资源系统中，其路径形如 `包路径#条目名称`。
+         * 加载这些资源时将直接从内存映射中解码，不再逐个打开文件。
+         * @see PackFile
+         * @see unmountPack
+         * @since v1.1.0-alpha
+         */
+        uint64_t mountPack(const std::string& path, const std::string& prefix = "");
+        /**
+         * @brief 卸载资源包，并移除其中的所有资源
+         * @param path 资源包路径
+         * @see mountPack
+         * @since v1.1.0-alpha
+         */
+        void unmountPack(const std::string& path);
+        /**
+         * @brief 获取来自资源包的资源原始数据（零拷贝）
+         * @param name 指定的资源名称
+         * @return 若资源不来自资源包，则返回空视图
+         * @note 无需加载资源即可访问，视图在资源包卸载前有效
+         * @since v1.1.0-alpha
+         */
+        std::span<const uint8_t> packData(const std::string& name) const;
+        /**
+         * @brief 从文件路径或资源包路径（`包路径#条目名称`）解码图片
+         * @param url 指定路径，通常来自 `resourcePath()`
+         * @return 返回新的表面（由调用者持有），失败时返回 `nullptr`
+         * @since v1.1.0-alpha
+         */
+        SSurface* decodeImage(const std::string& url) const;
+        /**
+         * @brief 从文件路径或资源包路径（`包路径#条目名称`）创建只读的 IO 流
+         * @param url 指定路径，通常来自 `resourcePath()`
+         * @return 返回新的 IO 流（由调用者关闭），失败时返回 `nullptr`
+         * @note 来自资源包的 IO 流直接引用内存映射，在资源包卸载前有效
+         * @since v1.1.0-alpha
+         */
+        SDL_IOStream* openIO(const std::string& url) const;
+        /**
+         * @brief 从资源清单文件中添加资源
+         * @param path 清单文件路径（如 `assets/resource.def`）
+         * @return 返回成功添加的资源个数
+         *
+         * 清单文件逐行解析，不会一次性读入内存。每行格式如下（`#` 之后为注释）：
+         * @code
+         * [group]                         # 之后的资源均属于此分组，直到下一个分组
+         * <type> <name> <path> [tag ...]  # type: image/text/font/audio/video/binary
+         * @endcode
+         * 路径相对于清单文件所在目录，包含空格时可使用双引号括起。
+         * 每个资源最多属于一个分组，可带有多个标签（全局最多 64 个不同的标签）。
+         * @see groupResources
+         * @see taggedResources
+         * @since v1.1.0-alpha
+         */
+        uint64_t loadManifest(const std::string& path);
+        /**
+         * @brief 获取清单中指定分组下的所有资源名称
+         * @param group 分组名称
+         * @see loadManifest
+         * @since v1.1.0-alpha
+         */
+        std::vector<std::string> groupResources(const std::string& group) const;
+        /**
+         * @brief 获取清单中带有指定标签的所有资源名称
+         * @param tag 标签名称
+         * @see loadManifest
+         * @since v1.1.0-alpha
+         */
+        std::vector<std::string> taggedResources(const std::string& tag) const;
+        /**
+         * @brief 预加载指定分组下的所有资源
+         * @param group 分组名称
+         * @return 返回加载失败的个数
+         * @see preload
+         * @since v1.1.0-alpha
+         */
+        uint64_t preloadGroup(const std::string& group);
+        /**
+         * @brief 在后台加载指定分组下的所有资源，常用于切换场景前的预取
+         * @param group    分组名称
+         * @param callback 全部加载完成后执行的回调函数，参数为加载失败的个数
+         * @see asyncLoad
+         * @since v1.1.0-alpha
+         */
+        void asyncLoadGroup(const std::string& group, const std::function<void(uint64_t)>& callback = {});
+        /**
+         * @brief 卸载指定分组下的所有资源
+         * @param group 分组名称
+         * @return 返回卸载失败的个数
+         * @since v1.1.0-alpha
+         */
+        uint64_t unloadGroup(const std::string& group);
+        /**
+         * @brief 设置指定资源类型的驻留字节预算
+         * @param type  资源类型
+         * @param bytes 字节预算（为 0 时不限制，默认不限制）
+         *
+         * 每当该类型的资源加载完成后，若驻留字节数超出预算，将按最近最少使用（LRU）的顺序
+         * 卸载未固定的资源，直至回到预算以内。被卸载的资源将在下次通过 `metaData()` 访问时自动重新加载。
+         * @note 设置后立即按新的预算进行一次淘汰
+         * @see pin
+         * @see cacheStats
+         * @since v1.1.0-alpha
+         */
+        void setBudget(Resource::Type type, uint64_t bytes);
+        /**
+         * @brief 获取指定资源类型的驻留字节预算
+         * @see setBudget
+         * @since v1.1.0-alpha
+         */
+        uint64_t budget(Resource::Type type) const;
+        /**
+         * @brief 固定指定资源，使其不会被淘汰
+         * @param name 指定的资源名称
+         * @note 可多次固定，需调用相同次数的 `unpin()` 才会解除
+         * @since v1.1.0-alpha
+         */
+        bool pin(const std::string& name);
+        /**
+         * @brief 解除固定指定资源
+         * @param name 指定的资源名称
+         * @see pin
+         * @since v1.1.0-alpha
+         */
+        bool unpin(const std::string& name);
+        /**
+         * @brief 指定资源是否已被固定
+         * @since v1.1.0-alpha
+         */
+        bool isPinned(const std::string& name) const;
+        /**
+         * @brief 获取指定资源类型的驻留统计
+         * @see CacheStats
+         * @since v1.1.0-alpha
+         */
+        CacheStats cacheStats(Resource::Type type) const;
+        /**
+         * @brief 获取所有资源类型的驻留统计之和
+         * @see CacheStats
+         * @since v1.1.0-alpha
+         */
+        CacheStats cacheStats() const;
+        /**
+         * @brief 重置命中、未命中及淘汰计数
+         * @since v1.1.0-alpha
+         */
+        void resetCacheStats();
         /**
          * @brief 卸载指定资源
          * @param name 指定卸载的资源名
          */
         bool unload(const std::string& name);
+        /**
+         * @brief 卸载多个指定资源
+         * @param resource_names 指定的资源名列表
+         * @return 返回卸载失败的个数
+         * @see unloadGroup
+         * @since v1.1.0-alpha
+         */
+        uint64_t unload(const std::vector<std::string>& resource_names);
         /**
          * @brief 卸载全部资源
          */
@@ -270,8 +705,19 @@ namespace EasyEngine {
          * @param name 指定的资源名称
          * @return 返回对应的元数据
          * @warning 对于未找到的资源名或未加载的资源，将报错并异常退出！
+         * @warning 返回的引用在该资源被卸载、移除或替换前有效，请勿在其它线程中同时卸载该资源。
          */
         const ResourceTypes& metaData(const std::string &name) const;
+        /**
+         * @brief 从指定资源中获取元数据，若资源未加载（或已被淘汰）则自动重新加载
+         * @param name 指定的资源名称
+         * @return 返回对应的元数据
+         * @warning 对于未找到的资源名或加载失败的资源，将报错并异常退出！
+         * @warning 未固定的资源可能在之后的加载中被淘汰，需要长期持有元数据时请使用 `pin()`。
+         * @see pin
+         * @since v1.1.0-alpha
+         */
+        const ResourceTypes& metaData(const std::string &name);
         /**
          * @brief 从指定资源中获取资源所在路径
          */
@@ -293,14 +739,140 @@ namespace EasyEngine {
          * @param name 指定查找的资源名
          */
         bool isContain(const std::string &name) const;
+        /**
+         * @brief 获取指定图片资源在指定渲染器下的共享纹理
+         * @param name      指定图片资源名称
+         * @param renderer  指定渲染器
+         * @return 返回共享纹理，若资源不存在、不是图片或加载失败，则返回 `nullptr`
+         *
+         * 同一（资源名称，渲染器）仅会解码并上传一次纹理，之后直接返回缓存。
+         * 若资源已被加载，将直接复用已加载的表面，无需再次解码。
+         * @see SharedTexture
+         * @since v1.1.0-alpha
+         */
+        std::shared_ptr<SharedTexture> sharedTexture(const std::string &name, SRenderer* renderer);
+        /**
+         * @brief 获取当前仍在使用中的共享纹理个数
+         * @see sharedTexture
+         * @since v1.1.0-alpha
+         */
+        size_t sharedTextureCount() const;
+        /**
+         * @brief 获取指定图片资源的 1 位透明度遮罩
+         * @param name      指定图片资源名称
+         * @param threshold 透明度阈值，不低于此值的像素视为不透明
+         * @return 返回遮罩，若资源不存在、不是图片或加载失败，则返回 `nullptr`
+         *
+         * 同一（资源名称，阈值）仅会生成一次遮罩，使用同一资源的所有精灵及碰撞器共享同一份遮罩，
+         * 当最后一个持有者释放时自动销毁。优先复用已加载的表面或共享纹理的表面，否则临时解码图片。
+         * @see Components::Collider::setSelf
+         * @see Components::Sprite::alphaMask
+         * @since v1.1.0-alpha
+         */
+        std::shared_ptr<const AlphaMask> alphaMask(const std::string &name, uint8_t threshold = 128);
+        /**
+         * @brief 启用/禁用仅 GPU 驻留模式
+         * @param enabled 是否启用
+         *
+         * 启用后，共享纹理上传完成即释放其自行解码的图片表面，避免同一张图片同时在 CPU 与 GPU 上各驻留一份。
+         * 需要表面时（如渲染设备重置）将从资源重新解码。
+         * @note 通过 `load()` 显式加载的图片资源不会被卸载，如需释放请自行调用 `unload()`。
+         * @note 仅影响此后创建的共享纹理及从资源路径创建的精灵，已有的表面不会被释放。
+         * @see sharedTexture
+         * @see restoreSharedTextures
+         * @since v1.1.0-alpha
+         */
+        void setGPUOnlyMode(bool enabled);
+        /**
+         * @brief 是否启用仅 GPU 驻留模式
+         * @see setGPUOnlyMode
+         * @since v1.1.0-alpha
+         */
+        bool isGPUOnlyMode() const;
+        /**
+         * @brief 重新创建指定绘制器中所有仍在使用中的共享纹理
+         * @param painter 指定绘制器
+         * @return 返回重新创建失败的个数
+         *
+         * 用于渲染设备重置（`SDL_EVENT_RENDER_DEVICE_RESET`）后恢复纹理，已释放的表面将从资源重新解码。
+         * 主循环在收到该事件后会为每个绘制器自动调用此函数。
+         * 恢复期间持有渲染器锁，旧纹理待引用它的帧执行完毕后再释放。
+         * @note 精灵直接创建的纹理与纹理图集页面不在恢复范围内。
+         * @since v1.1.0-alpha
+         */
+        uint64_t restoreSharedTextures(Painter* painter);
+        /**
+         * @brief 获取当前驻留的内存总量
+         *
+         * 统计已加载的图片资源、共享纹理以及所有精灵持有的表面与纹理，被多方共享的对象仅计算一次。
+         * @see MemoryUsage
+         * @see Components::Sprite::memoryUsage
+         * @since v1.1.0-alpha
+         */
+        MemoryUsage memoryUsage() const;
+        /**
+         * @brief 计算指定表面占用的字节数
+         * @since v1.1.0-alpha
+         */
+        static uint64_t surfaceBytes(const SSurface* surface);
+        /**
+         * @brief 计算指定纹理占用的字节数（按像素格式估算）
+         * @since v1.1.0-alpha
+         */
+        static uint64_t textureBytes(const STexture* texture);
 
         ResourceSystem(ResourceSystem&) = delete;
         ResourceSystem& operator=(const ResourceSystem&) = delete;
     private:
+        struct PendingLoad {
+            std::shared_future<bool> future;
+            std::vector<std::function<void(bool)>> callbacks;
+        };
         explicit ResourceSystem() = default;
         static std::unique_ptr<ResourceSystem> _instance;
+        void removeSharedTexture(const std::string &name);
+        void pruneSharedTextures();
+        void removeAlphaMask(const std::string &name);
+        static bool decode(const std::string &name, const Resource::Type &type, const std::string &url,
+                           std::span<const uint8_t> pack_data, ResourceTypes &meta_data);
+        static void release(const Resource::Type &type, ResourceTypes &meta_data);
+        static uint64_t measure(const Resource &resource);
+        void enforceBudget(Resource::Type type, const std::string &keep = "");
+        bool store(const std::string &name, const Resource::Type &type, const std::string &url,
+                   ResourceTypes &meta_data);
+        void enqueue(std::function<void()> job);
+        void workerLoop();
+        mutable std::recursive_mutex _mutex;
+        std::map<std::string, PendingLoad> _pending;
+        std::map<std::string, std::shared_ptr<PackFile>> _packs;
+        mutable std::map<Resource::Type, CacheStats> _cache_stats;
+        mutable uint64_t _access_clock{0};
+        struct ManifestEntry {
+            uint32_t name;
+            uint32_t group;
+            uint64_t tags;
+        };
+        static constexpr uint32_t NO_GROUP = UINT32_MAX;
+        uint32_t intern(std::string_view str);
+        bool internedId(std::string_view str, uint32_t& id) const;
+        std::vector<ManifestEntry> _manifest;
+        std::deque<std::string> _interned;
+        std::unordered_map<std::string_view, uint32_t> _intern_index;
+        std::unordered_map<uint32_t, uint8_t> _tag_bits;
+        std::vector<std::thread> _workers;
+        std::deque<std::function<void()>> _jobs;
+        std::mutex _job_mutex;
+        std::condition_variable _job_cv;
+        bool _stop_workers{false};
+        uint32_t _worker_count{0};
+        std::atomic<uint64_t> _progress_total{0};
+        std::atomic<uint64_t> _progress_loaded{0};
+        std::atomic<uint64_t> _progress_failed{0};
         std::map<std::string, Resource> _resource;
+        std::map<std::pair<std::string, SRenderer*>, std::weak_ptr<SharedTexture>> _texture_cache;
+        std::map<std::pair<std::string, uint8_t>, std::weak_ptr<const AlphaMask>> _mask_cache;
         std::string _null_str{};
+        bool _gpu_only{false};
     };
 }
 
@@ -2,6 +2,51 @@
 
 using namespace EasyEngine;
 
+namespace {
+    /// 计算元素绘制时的包围盒，返回元素是否可见
+    bool elementBounds(const Components::Elements& element, GeometryF& bounds) {
+        using namespace Components;
+        switch (element.index()) {
+            case 0: {
+                auto sprite = std::get<0>(element).get();
+                auto properties = sprite->properties();
+                if (!properties) {
+                    bounds.reset(Vector2(0, 0), sprite->size());
+                } else if (properties->clip_mode) {
+                    bounds.reset(Algorithm::spiritScaledPosition(*properties), properties->clip_size * properties->scaled);
+                } else {
+                    bounds.reset(Algorithm::spiritScaledPosition(*properties),
+                                 Algorithm::spriteScaledSize(*sprite, *properties));
+                }
+                return true;
+            }
+            case 1: {
+                auto group = std::get<1>(element).get();
+                bounds.reset(group->position(), group->size());
+                return true;
+            }
+            case 2: {
+                auto animation = std::get<2>(element).get();
+                if (animation->framesCount() == 0) return false;
+                bounds.reset(animation->position(), animation->sprite(animation->currentFrame())->size());
+                return true;
+            }
+            case 3: {
+                auto entity = std::get<3>(element).get();
+                bounds.reset(entity->position(), entity->size());
+                return entity->visible();
+            }
+            case 4: {
+                auto control = std::get<4>(element).get();
+                bounds.reset(control->position(), control->size());
+                return control->visible();
+            }
+            default:
+                return false;
+        }
+    }
+}
+
 Components::Layer::Layer(const std::string &name) : _name(name) {}
 
 Components::Layer::~Layer() {
@@ -24,6 +69,7 @@ bool Components::Layer::append(uint32_t z_order, Components::Sprite *sprite) {
         return false;
     }
     _elements.emplace(z_order, std::shared_ptr<Sprite>(sprite));
+    _index_stale = true;
     return true;
 }
 
@@ -40,6 +86,7 @@ bool Components::Layer::append(uint32_t z_order, Components::SpriteGroup *group)
         return false;
     }
     _elements.emplace(z_order, std::shared_ptr<SpriteGroup>(group));
+    _index_stale = true;
     return true;
 }
 
@@ -56,6 +103,7 @@ bool Components::Layer::append(uint32_t z_order, Components::FrameAnimation *ani
         return false;
     }
     _elements.emplace(z_order, std::shared_ptr<FrameAnimation>(animation));
+    _index_stale = true;
     return true;
 }
 
@@ -72,6 +120,7 @@ bool Components::Layer::append(uint32_t z_order, Components::Entity *entity) {
         return false;
     }
     _elements.emplace(z_order, std::shared_ptr<Entity>(entity));
+    _index_stale = true;
     return true;
 }
 
@@ -88,12 +137,14 @@ bool Components::Layer::append(uint32_t z_order, Components::Control *control) {
         return false;
     }
     _elements.emplace(z_order, std::shared_ptr<Control>(control));
+    _index_stale = true;
     return true;
 }
 
 void Components::Layer::remove(uint32_t z_order) {
     if (_elements.contains(z_order)) {
         _elements.erase(z_order);
+        _index_stale = true;
     } else {
         SDL_Log("[ERROR] The specified z_order is not found!");
     }
@@ -215,6 +266,7 @@ bool Components::Layer::swap(uint32_t z_order1, uint32_t z_order2) {
     auto temp = _elements.at(z_order1);
     _elements.at(z_order1) = _elements.at(z_order2);
     _elements.at(z_order2) = temp;
+    _index_stale = true;
     return true;
 }
 
@@ -229,6 +281,7 @@ bool Components::Layer::setZOrder(uint32_t old_z_order, uint32_t new_z_order) {
     }
     _elements.emplace(new_z_order, _elements.at(old_z_order));
     _elements.erase(old_z_order);
+    _index_stale = true;
     return true;
 }
 
@@ -273,6 +326,8 @@ void Components::Layer::update() {
             t->update();
         }
     }
+    // 绘制时元素可能已移动，下次查询前再按需更新空间索引
+    _index_stale = true;
 }
 
 void Components::Layer::setViewport(const Geometry &geometry) {
@@ -307,7 +362,9 @@ void Components::Layer::draw(bool viewport_mode, bool clip_mode) {
     if (_painter) {
         if (viewport_mode) _painter->setViewport(_viewport_geometry, _scaled);
         if (clip_mode) _painter->setClipView(_clipViewport_geometry);
+        if (_sortable) _painter->_beginSortRange();
         update();
+        if (_sortable) _painter->_endSortRange();
         if (viewport_mode) _painter->setViewport({0, 0, 0, 0});
         if (clip_mode) _painter->setClipView({0, 0, 0, 0});
         return;
@@ -315,6 +372,14 @@ void Components::Layer::draw(bool viewport_mode, bool clip_mode) {
     update();
 }
 
+void Components::Layer::setSortable(bool sortable) {
+    _sortable = sortable;
+}
+
+bool Components::Layer::sortable() const {
+    return _sortable;
+}
+
 const Geometry &Components::Layer::viewport() const {
     return _viewport_geometry;
 }
@@ -331,6 +396,88 @@ const Painter *Components::Layer::viewportPainter() const {
     return _painter;
 }
 
+std::vector<uint32_t> Components::Layer::pick(const Vector2 &point) {
+    return query(GeometryF(point, Size(0, 0)));
+}
+
+std::vector<uint32_t> Components::Layer::query(const GeometryF &area) {
+    if (!_visible) return {};
+    updateSpatialIndex();
+    return toZOrders(_spatial_index->query(area));
+}
+
+std::vector<uint32_t> Components::Layer::raycast(const Vector2 &origin, const Vector2 &delta) {
+    if (!_visible) return {};
+    updateSpatialIndex();
+    std::vector<Collider*> colliders;
+    for (auto& hit : _spatial_index->raycast(origin, delta)) colliders.push_back(hit.collider);
+    return toZOrders(colliders);
+}
+
+std::vector<uint32_t> Components::Layer::nearest(const Vector2 &point, size_t count) {
+    if (!_visible) return {};
+    updateSpatialIndex();
+    return toZOrders(_spatial_index->nearest(point, count));
+}
+
+void Components::Layer::refreshSpatialIndex() {
+    if (!_spatial_index) _spatial_index = std::make_unique<CollisionWorld>(CollisionWorld::AABBTree);
+    // 两者均按 z_order 排列，同步遍历即可找出新增及已移除的元素
+    auto it = _index_colliders.begin();
+    const auto erase = [this](std::map<uint32_t, Collider*>::iterator pos) {
+        _index_z_orders.erase(pos->second);
+        _spatial_index->remove(pos->second);
+        return _index_colliders.erase(pos);
+    };
+    GeometryF bounds;
+    for (auto& [z_order, element] : _elements) {
+        while (it != _index_colliders.end() && it->first < z_order) it = erase(it);
+        const bool visible = elementBounds(element, bounds);
+        Collider* collider;
+        if (it != _index_colliders.end() && it->first == z_order) {
+            collider = it->second;
+            ++it;
+            auto& current = collider->bounds();
+            if (current.pos.x != bounds.pos.x || current.pos.y != bounds.pos.y ||
+                current.size.width != bounds.size.width || current.size.height != bounds.size.height) {
+                collider->setBoundsGeometry(bounds);
+            }
+        } else {
+            collider = _spatial_index->create(bounds.pos.x, bounds.pos.y, bounds.size.width, bounds.size.height, 1);
+            _index_colliders.emplace_hint(it, z_order, collider);
+            _index_z_orders.emplace(collider, z_order);
+        }
+        collider->setEnabled(visible);
+    }
+    while (it != _index_colliders.end()) it = erase(it);
+    _index_stale = false;
+}
+
+void Components::Layer::updateSpatialIndex() {
+    if (!_spatial_index || _index_stale) refreshSpatialIndex();
+}
+
+std::vector<uint32_t> Components::Layer::toZOrders(const std::vector<Collider *> &colliders) const {
+    std::vector<uint32_t> z_orders;
+    z_orders.reserve(colliders.size());
+    for (auto collider : colliders) z_orders.push_back(_index_z_orders.at(collider));
+    std::sort(z_orders.begin(), z_orders.end(), std::greater<>());
+    return z_orders;
+}
+
+std::vector<std::pair<float, uint32_t>> Components::Layer::nearestWithDistance(const Vector2 &point, size_t count) {
+    std::vector<std::pair<float, uint32_t>> result;
+    if (!_visible) return result;
+    updateSpatialIndex();
+    for (auto collider : _spatial_index->nearest(point, count)) {
+        auto& box = collider->bounds();
+        const float dx = std::max({box.pos.x - point.x, 0.0f, point.x - box.pos.x - box.size.width});
+        const float dy = std::max({box.pos.y - point.y, 0.0f, point.y - box.pos.y - box.size.height});
+        result.emplace_back(dx * dx + dy * dy, _index_z_orders.at(collider));
+    }
+    return result;
+}
+
 Components::Scene::Scene(const std::string &name) : _name(name), _event() {}
 
 void Components::Scene::setName(const std::string &name) {
@@ -524,6 +671,49 @@ void Components::Scene::drawLayers() {
     }
 }
 
+std::vector<Components::Scene::Hit> Components::Scene::pick(const Vector2 &point) const {
+    std::vector<Hit> hits;
+    for (auto it = _layers.rbegin(); it != _layers.rend(); ++it) {
+        for (auto z_order : it->second->pick(point)) hits.push_back({it->second.get(), z_order});
+    }
+    return hits;
+}
+
+std::vector<Components::Scene::Hit> Components::Scene::query(const GeometryF &area) const {
+    std::vector<Hit> hits;
+    for (auto it = _layers.rbegin(); it != _layers.rend(); ++it) {
+        for (auto z_order : it->second->query(area)) hits.push_back({it->second.get(), z_order});
+    }
+    return hits;
+}
+
+std::vector<Components::Scene::Hit> Components::Scene::raycast(const Vector2 &origin, const Vector2 &delta) const {
+    std::vector<Hit> hits;
+    for (auto it = _layers.rbegin(); it != _layers.rend(); ++it) {
+        for (auto z_order : it->second->raycast(origin, delta)) hits.push_back({it->second.get(), z_order});
+    }
+    return hits;
+}
+
+std::vector<Components::Scene::Hit> Components::Scene::nearest(const Vector2 &point, size_t count) const {
+    // 先从每个图层取出最近的若干个，再从中选出整体最近的若干个
+    std::vector<std::tuple<float, uint32_t, uint32_t>> found;
+    for (auto& [layer_z_order, layer] : _layers) {
+        for (auto& [distance, z_order] : layer->nearestWithDistance(point, count)) {
+            found.emplace_back(distance, layer_z_order, z_order);
+        }
+    }
+    const size_t size = std::min(count, found.size());
+    std::partial_sort(found.begin(), found.begin() + static_cast<ptrdiff_t>(size), found.end());
+    found.resize(size);
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<1>(a), std::get<2>(a)) > std::tie(std::get<1>(b), std::get<2>(b));
+    });
+    std::vector<Hit> hits;
+    for (auto& [distance, layer_z_order, z_order] : found) hits.push_back({_layers.at(layer_z_order).get(), z_order});
+    return hits;
+}
+
 SceneManager::SceneManager() : _leave_delayer(new Components::Timer()) {
     EventSystem::global()->addSceneManager(this);
 };
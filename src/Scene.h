@@ -12,6 +12,7 @@
  * @author CatIsNotFound
  */
 #include "Components.h"
+#include "Collision.h"
 #include "Transition.h"
 
 namespace EasyEngine {
@@ -250,6 +251,25 @@ namespace EasyEngine {
              * @note 必需设置，否则即便设置视图大小位置，也是无用！
              */
             void setViewportPainter(Painter* painter);
+            /**
+             * @brief 设置图层是否为可排序模式
+             * @param sortable 是否可排序（默认不可排序）
+             *
+             * 启用后，绘制器将在该图层内按纹理（及其混合模式）重新排列精灵绘制命令，
+             * 使同一纹理的精灵尽量相邻，以便合批绘制。
+             * 仅当精灵之间的绘制区域互不重叠时才会调整顺序，否则保持原有的 `z_order` 顺序。
+             * @note 需调用 `setViewportPainter()` 才能生效！
+             * @see Painter::setSpriteBatchEnabled
+             * @see Painter::drawCallsSaved
+             * @since v1.1.0-alpha
+             */
+            void setSortable(bool sortable);
+            /**
+             * @brief 获取当前图层是否为可排序模式
+             * @see setSortable
+             * @since v1.1.0-alpha
+             */
+            bool sortable() const;
             /**
              * @brief 绘制图层
              * @param viewport_mode 是否使用视图（需调用 `setViewport()`）
@@ -260,6 +280,51 @@ namespace EasyEngine {
              * 执行后，这将会按照图层的渲染顺序依次绘制！`z_order` 越大，渲染越靠后，显示最靠前！
              */
             void draw(bool viewport_mode = false, bool clip_mode = false);
+            /**
+             * @brief 查找位于指定点下的所有元素
+             * @param point 指定点（图层内的坐标，与元素的位置一致）
+             * @return 返回元素的 `z_order`，按显示顺序从上到下排列（`z_order` 从大到小）
+             *
+             * 空间查询通过按元素包围盒建立的动态 AABB 树完成，无需逐个比较。
+             * 首次查询时建立；之后每次绘制图层或增删元素后，在下一次查询时按元素的位置、大小更新，
+             * 仅重新插入包围盒发生变化的元素，不查询时不产生开销。
+             * @note 精灵的旋转不计入包围盒；隐藏的实体及控件不会被查找到
+             * @see refreshSpatialIndex
+             * @since v1.1.0-alpha
+             */
+            std::vector<uint32_t> pick(const Vector2& point);
+            /**
+             * @brief 查找与指定区域相交的所有元素
+             * @param area 指定区域（图层内的坐标）
+             * @return 返回元素的 `z_order`，按显示顺序从上到下排列
+             * @since v1.1.0-alpha
+             */
+            std::vector<uint32_t> query(const GeometryF& area);
+            /**
+             * @brief 查找与指定线段相交的所有元素
+             * @param origin 线段起点（图层内的坐标）
+             * @param delta  线段的位移（终点 = 起点 + 位移）
+             * @return 返回元素的 `z_order`，按显示顺序从上到下排列
+             * @since v1.1.0-alpha
+             */
+            std::vector<uint32_t> raycast(const Vector2& origin, const Vector2& delta);
+            /**
+             * @brief 查找距离指定点最近的若干个元素
+             * @param point 指定点（图层内的坐标）
+             * @param count 最多返回的数量
+             * @return 返回元素的 `z_order`，按显示顺序从上到下排列
+             * @note 距离以元素包围盒计算，点位于包围盒内时距离为 0
+             * @since v1.1.0-alpha
+             */
+            std::vector<uint32_t> nearest(const Vector2& point, size_t count);
+            /**
+             * @brief 立即按元素当前的位置、大小更新空间索引
+             *
+             * 空间索引默认在绘制图层后的首次查询时更新，查询结果与画面一致；
+             * 若在同一帧内移动了元素并需要立即查询，可先调用此函数。
+             * @since v1.1.0-alpha
+             */
+            void refreshSpatialIndex();
             /**
              * @brief 获取当前视图的位置和大小
              */
@@ -279,6 +344,12 @@ namespace EasyEngine {
         private:
             bool checkAppendError(uint32_t z_order);
             void update();
+            /// 将碰撞器转换为 `z_order` 并按显示顺序排列
+            std::vector<uint32_t> toZOrders(const std::vector<Collider*>& colliders) const;
+            /// 空间索引尚未建立或可能已过期时更新
+            void updateSpatialIndex();
+            /// 查找最近的元素，并返回与指定点的距离
+            std::vector<std::pair<float, uint32_t>> nearestWithDistance(const Vector2& point, size_t count);
             std::string _name;
             std::map<uint32_t, Elements> _elements;
             Geometry _viewport_geometry;
@@ -286,7 +357,14 @@ namespace EasyEngine {
             Size _scaled{1.0f, 1.0f};
             Painter* _painter{nullptr};
             bool _visible{true};
+            bool _sortable{false};
             uint32_t _z_order{0};
+            /// 空间索引（首次查询时建立）
+            std::unique_ptr<CollisionWorld> _spatial_index;
+            std::map<uint32_t, Collider*> _index_colliders;
+            std::unordered_map<const Collider*, uint32_t> _index_z_orders;
+            /// 绘制或增删元素后，元素的包围盒可能已变化
+            bool _index_stale{false};
         };
 
         /**
@@ -413,6 +491,50 @@ namespace EasyEngine {
              * @brief 绘制所有图层
              */
             void drawLayers();
+            /**
+             * @struct Hit
+             * @brief 空间查询的结果
+             * @since v1.1.0-alpha
+             */
+            struct Hit {
+                /// 元素所在的图层
+                Layer* layer;
+                /// 元素在图层中的 `z_order`
+                uint32_t z_order;
+            };
+            /**
+             * @brief 在所有可见图层中查找位于指定点下的元素
+             * @param point 指定点
+             * @return 返回按显示顺序从上到下排列的元素（先按图层，再按元素的 `z_order`）
+             * @note 坐标为图层内的坐标；未设置视图时即为窗口坐标，可直接用于鼠标拾取
+             * @see Layer::pick
+             * @since v1.1.0-alpha
+             */
+            std::vector<Hit> pick(const Vector2& point) const;
+            /**
+             * @brief 在所有可见图层中查找与指定区域相交的元素
+             * @param area 指定区域
+             * @see Layer::query
+             * @since v1.1.0-alpha
+             */
+            std::vector<Hit> query(const GeometryF& area) const;
+            /**
+             * @brief 在所有可见图层中查找与指定线段相交的元素
+             * @param origin 线段起点
+             * @param delta  线段的位移
+             * @see Layer::raycast
+             * @since v1.1.0-alpha
+             */
+            std::vector<Hit> raycast(const Vector2& origin, const Vector2& delta) const;
+            /**
+             * @brief 在所有可见图层中查找距离指定点最近的若干个元素
+             * @param point 指定点
+             * @param count 最多返回的数量
+             * @return 返回按显示顺序从上到下排列的元素
+             * @see Layer::nearest
+             * @since v1.1.0-alpha
+             */
+            std::vector<Hit> nearest(const Vector2& point, size_t count) const;
         private:
             std::string _name;
             SColor _back_color{StdColor::Black};
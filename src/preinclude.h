@@ -35,18 +35,25 @@
 #include <variant>
 #include <vector>
 #include <array>
+#include <span>
 #include <deque>
 #include <map>
 #include <tuple>
+#include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <typeindex>
 #include <thread>
 #include <mutex>
 #include <stdexcept>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 #include <chrono>
 #include <future>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
 
 #endif //EASYENGINE_PREINCLUDE_H
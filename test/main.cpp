@@ -7,20 +7,14 @@ int main() {
     engine.show();
 
     auto res = ResourceSystem::global();
-    res->append("block", "assets/gear.png", Resource::Image);
-    res->append("load1", "assets/Load1.png", Resource::Image);
-    res->append("load2", "assets/Load2.png", Resource::Image);
-    res->append("load3", "assets/Load3.png", Resource::Image);
-    res->append("load4", "assets/Load4.png", Resource::Image);
-    res->append("load5", "assets/Load5.png", Resource::Image);
+    res->loadManifest("assets/resource.def");
+    res->preloadGroup("loading");
 
     Components::Sprite block("block", "block", engine.painter());
-    Components::FrameAnimation ani("loading", std::vector<Components::Sprite *>{
-                                               new Components::Sprite("load1", "load1", engine.painter()),
-                                               new Components::Sprite("load2", "load2", engine.painter()),
-                                               new Components::Sprite("load3", "load3", engine.painter()),
-                                               new Components::Sprite("load4", "load4", engine.painter()),
-                                               new Components::Sprite("load5", "load5", engine.painter())});
+    Components::TextureAtlas atlas("loading", engine.painter());
+    atlas.append(res->taggedResources("atlas"));
+    atlas.build();
+    Components::FrameAnimation ani("loading", &atlas, {"load1", "load2", "load3", "load4", "load5"});
     Components::Entity entity("block", block);
     entity.setPosition(engine.window()->geometry.width / 2 - block.size().width,
                        engine.window()->geometry.height / 2 - block.size().height);
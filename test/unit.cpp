@@ -0,0 +1,276 @@
+#include "../src/Core.h"
+
+#include <random>
+
+using namespace EasyEngine;
+
+namespace {
+    int failures = 0;
+
+    /// 检查条件是否成立，失败时输出所在行并计数
+    void expect(bool condition, const char* expression, int line) {
+        if (condition) return;
+        fmt::print(stderr, "[FAILED] unit.cpp:{}: {}\n", line, expression);
+        failures += 1;
+    }
+
+    std::filesystem::path tempDir() {
+        auto dir = std::filesystem::temp_directory_path() / "easyengine_unit";
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    std::vector<char> readFile(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+    }
+
+    void writeFile(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+}
+
+#define EXPECT(condition) expect((condition), #condition, __LINE__)
+
+/// 资源包的目录中存在越界或不一致的条目时应拒绝打开
+void testPackFileRejectsDamagedToc() {
+    const auto dir = tempDir();
+    const auto source = (dir / "entry.bin").string(), pack = (dir / "entry.pak").string();
+    writeFile(source, {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'});
+    EXPECT(PackFile::build(pack, {{"entry", source, Resource::Text}}));
+    const auto original = readFile(pack);
+    {
+        PackFile file;
+        EXPECT(file.open(pack));
+        EXPECT(file.data("entry").size() == 16);
+    }
+    // 文件头中 `toc_offset` 位于第 16 字节；目录记录依次为 offset、size、stored_size
+    uint64_t toc_offset = 0;
+    std::memcpy(&toc_offset, original.data() + 16, sizeof(uint64_t));
+    const auto openDamaged = [&pack](const std::vector<char>& bytes) {
+        writeFile(pack, bytes);
+        PackFile file;
+        return file.open(pack);
+    };
+    const auto patched = [&original, toc_offset](uint64_t size, uint64_t stored_size) {
+        auto bytes = original;
+        std::memcpy(bytes.data() + toc_offset + 8, &size, sizeof(uint64_t));
+        std::memcpy(bytes.data() + toc_offset + 16, &stored_size, sizeof(uint64_t));
+        return bytes;
+    };
+    // 未压缩条目的原始大小与存储大小不一致（仍位于文件范围内）
+    EXPECT(!openDamaged(patched(17, 16)));
+    // 原始大小超出文件范围
+    EXPECT(!openDamaged(patched(UINT64_MAX / 2, 16)));
+    // 两种大小均超出文件范围
+    EXPECT(!openDamaged(patched(UINT64_MAX / 2, UINT64_MAX / 2)));
+    // 目录被截断
+    auto truncated = original;
+    truncated.resize(truncated.size() - 4);
+    EXPECT(!openDamaged(truncated));
+    EXPECT(openDamaged(original));
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+/// 空间哈希中覆盖大量单元格或坐标无效的碰撞器不应拖慢或破坏查询
+void testSpatialHashBoundsLargeColliders() {
+    Components::CollisionWorld world(Components::CollisionWorld::SpatialHash, 1.0f);
+    auto huge = world.create(0, 0, 1e7f, 1e7f, 1);
+    auto small = world.create(5e6f, 5e6f, 1, 1, 1);
+    auto far = world.create(1e30f, 1e30f, 1, 1, 1);
+    auto broken = world.create(NAN, 0, 1, 1, 1);
+    EXPECT(huge && small && far && broken);
+    world.step();
+    EXPECT(world.beginContacts().size() == 1);
+    EXPECT(world.query(GeometryF(Vector2(5e6f, 5e6f), Size(2, 2))).size() == 2);
+    EXPECT(world.query(GeometryF(Vector2(1e30f, 1e30f), Size(1, 1))).size() == 1);
+    EXPECT(world.query(GeometryF(Vector2(NAN, NAN), Size(1, 1))).empty());
+    EXPECT(world.raycast(Vector2(-1, 1), Vector2(2e7f, 0)).size() == 1);
+    EXPECT(world.nearest(Vector2(5e6f, 5e6f), 4).size() == 3);
+    EXPECT(world.nearest(Vector2(NAN, 0), 1).empty());
+    EXPECT(world.nearest(Vector2(0, INFINITY), 1).empty());
+    // 大型碰撞器移动后仍可被找到，移入单元格范围后也能正确移除
+    huge->moveBounds(-2e7f, 0);
+    world.step();
+    EXPECT(world.endContacts().size() == 1);
+    huge->setBoundsGeometry(0, 0, 4, 4);
+    world.step();
+    EXPECT(world.query(GeometryF(Vector2(1, 1), Size(1, 1))).size() == 1);
+    EXPECT(world.remove(huge));
+    EXPECT(world.query(GeometryF(Vector2(1, 1), Size(1, 1))).empty());
+}
+
+/// 移动带遮罩碰撞器的实体时，遮罩应与矩形一样以左上角对齐实体位置
+void testEntityMovesMaskCollider() {
+    auto mask = std::make_shared<AlphaMask>();
+    mask->width = mask->height = 4;
+    mask->words_per_row = 1;
+    mask->bits.assign(4, 0xF);
+    Components::Entity entity("entity");
+    entity.setCenterPosition(2, 2);
+    entity.collider()->setSelf(Vector2(0, 0), mask);
+    entity.collider()->setEnabled(true);
+    Components::Collider other(Vector2(10, 10), mask);
+    other.setEnabled(true);
+    entity.setPosition(6, 6);
+    EXPECT(entity.collider()->bounds().pos.x == 6 && entity.collider()->bounds().pos.y == 6);
+    EXPECT(entity.collider()->check(other) < 0);
+    entity.setPosition(7, 7);
+    EXPECT(entity.collider()->check(other) >= 0);
+}
+
+/// 创建带有矩形碰撞器的实体，并加入碰撞世界
+void addSweptEntity(Components::CollisionWorld& world, Components::Entity& entity, float x, float y) {
+    entity.collider()->setSelf(Graphics::Rectangle(Vector2(x, y), Size(4, 4), StdColor::Black));
+    entity.collider()->setEnabled(true);
+    entity.setPosition(x, y);
+    entity.resetMotion();
+    world.append(&entity);
+}
+
+/// 停止移动的实体不应在之后的扫掠中被再次检测
+void testSweepIgnoresStationaryEntity() {
+    Components::CollisionWorld world;
+    Components::Entity bullet("bullet"), wall("wall");
+    addSweptEntity(world, bullet, 0, 0);
+    addSweptEntity(world, wall, 50, 0);
+    bullet.setPosition(100, 0);
+    EXPECT(world.sweepEntities().size() == 1);
+    // 未处理碰撞且未再移动，不应重复报告
+    EXPECT(world.sweepEntities().empty());
+    EXPECT(world.sweepEntities().empty());
+}
+
+/// 按文档示例退回到接触位置后，下一次扫掠不应从目标内部开始
+void testSweepStopsAtTarget() {
+    Components::CollisionWorld world;
+    Components::Entity bullet("bullet"), wall("wall");
+    addSweptEntity(world, bullet, 0, 0);
+    addSweptEntity(world, wall, 50, 0);
+    bullet.setPosition(100, 0);
+    const auto& hits = world.sweepEntities();
+    EXPECT(hits.size() == 1);
+    if (hits.size() == 1) {
+        auto& hit = hits.front();
+        EXPECT(hit.target_entity == &wall);
+        EXPECT(hit.from.x == 0 && hit.to.x == 100);
+        hit.entity->setPosition(hit.from + (hit.to - hit.from) * hit.impact.time);
+        hit.entity->resetMotion();
+    }
+    EXPECT(std::fabs(bullet.position().x - 46) < 0.01f);
+    EXPECT(world.sweepEntities().empty());
+    // 传送回起点后再次移动，仍可正常检测
+    bullet.setPosition(0, 0);
+    bullet.resetMotion();
+    EXPECT(world.sweepEntities().empty());
+    bullet.setPosition(60, 0);
+    EXPECT(world.sweepEntities().size() == 1);
+}
+
+/// 移动元素并绘制图层后，拾取结果应跟随元素的新位置
+void testLayerPickFollowsMovedElement() {
+    Components::Layer layer("layer");
+    auto entity = new Components::Entity("entity");
+    entity->setVisible(true);
+    entity->setPosition(10, 10);
+    EXPECT(layer.append(1, entity));
+    EXPECT(layer.pick(Vector2(10, 10)) == std::vector<uint32_t>{1});
+    entity->setPosition(100, 100);
+    layer.draw();
+    EXPECT(layer.pick(Vector2(100, 100)) == std::vector<uint32_t>{1});
+    EXPECT(layer.pick(Vector2(10, 10)).empty());
+    // 未绘制时也可立即更新
+    entity->setPosition(200, 200);
+    layer.refreshSpatialIndex();
+    EXPECT(layer.pick(Vector2(200, 200)) == std::vector<uint32_t>{1});
+    layer.remove(1);
+    EXPECT(layer.pick(Vector2(200, 200)).empty());
+}
+
+/// 各个指令集的批量检测（包括不足一组的尾部）应与逐个调用的标量结果一致
+void testBatchMatchesScalarOnEveryLevel() {
+    const auto previous = Algorithm::simdLevel();
+    // 使用整数坐标，让边界恰好相切的情况大量出现
+    std::mt19937 random(20261018);
+    std::uniform_int_distribution<int> coord(-20, 20), extent(0, 12);
+    const auto bit = [](const std::vector<uint64_t>& mask, size_t i) {
+        return i / 64 < mask.size() && ((mask[i / 64] >> (i % 64)) & 1) != 0;
+    };
+    for (auto level : {Algorithm::Scalar, Algorithm::SSE2, Algorithm::AVX2}) {
+        Algorithm::setSIMDLevel(level);
+        // CPU 不支持的级别会被降级，无需重复检测
+        if (Algorithm::simdLevel() != level) continue;
+        for (size_t count : {1, 3, 7, 9, 63, 65, 131}) {
+            std::vector<Graphics::Rectangle> rects;
+            std::vector<Graphics::Ellipse> ellipses;
+            Algorithm::ShapeArray rect_array, ellipse_array;
+            for (size_t i = 0; i < count; ++i) {
+                rects.emplace_back(static_cast<float>(coord(random)), static_cast<float>(coord(random)),
+                                   static_cast<float>(extent(random)), static_cast<float>(extent(random)),
+                                   StdColor::Black);
+                ellipses.emplace_back(static_cast<float>(coord(random)), static_cast<float>(coord(random)),
+                                      static_cast<float>(extent(random)), static_cast<float>(extent(random)),
+                                      StdColor::Black);
+                rect_array.append(rects.back());
+                ellipse_array.append(ellipses.back());
+            }
+            const Vector2 pos(static_cast<float>(coord(random)), static_cast<float>(coord(random)));
+            const Graphics::Rectangle rect(static_cast<float>(coord(random)), static_cast<float>(coord(random)),
+                                           static_cast<float>(extent(random)), static_cast<float>(extent(random)),
+                                           StdColor::Black);
+            const Graphics::Ellipse ellipse(static_cast<float>(coord(random)), static_cast<float>(coord(random)),
+                                            static_cast<float>(extent(random)), static_cast<float>(extent(random)),
+                                            StdColor::Black);
+            std::vector<uint64_t> mask;
+            size_t expected = 0, hits = Algorithm::comparePosRectBatch(pos, rect_array, mask);
+            for (size_t i = 0; i < count; ++i) {
+                const bool hit = Algorithm::comparePosRect(pos, rects[i]) >= 0;
+                expected += hit;
+                EXPECT(bit(mask, i) == hit);
+            }
+            EXPECT(hits == expected);
+            expected = 0, hits = Algorithm::comparePosEllipseBatch(pos, ellipse_array, mask);
+            for (size_t i = 0; i < count; ++i) {
+                const bool hit = Algorithm::comparePosEllipse(pos, ellipses[i]) >= 0;
+                expected += hit;
+                EXPECT(bit(mask, i) == hit);
+            }
+            EXPECT(hits == expected);
+            expected = 0, hits = Algorithm::compareRectBatch(rect, rect_array, mask);
+            for (size_t i = 0; i < count; ++i) {
+                const bool hit = Algorithm::compareRect(rect, rects[i]) >= 0;
+                expected += hit;
+                EXPECT(bit(mask, i) == hit);
+            }
+            EXPECT(hits == expected);
+            expected = 0, hits = Algorithm::compareEllipseBatch(ellipse, ellipse_array, mask);
+            for (size_t i = 0; i < count; ++i) {
+                const bool hit = Algorithm::compareEllipse(ellipse, ellipses[i]) >= 0;
+                expected += hit;
+                EXPECT(bit(mask, i) == hit);
+            }
+            EXPECT(hits == expected);
+            // 尾部之后的位必须为 0
+            EXPECT(!bit(mask, count));
+        }
+    }
+    Algorithm::setSIMDLevel(previous);
+}
+
+int main() {
+    testPackFileRejectsDamagedToc();
+    testSpatialHashBoundsLargeColliders();
+    testEntityMovesMaskCollider();
+    testSweepIgnoresStationaryEntity();
+    testSweepStopsAtTarget();
+    testLayerPickFollowsMovedElement();
+    testBatchMatchesScalarOnEveryLevel();
+    if (failures) {
+        fmt::print(stderr, "{} check(s) failed!\n", failures);
+        return 1;
+    }
+    fmt::print("All checks passed!\n");
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file main.cpp
+ * @brief 资源包打包工具
+ *
+ * 将指定目录下的所有文件打包为一个资源包（`.pak`），条目名称为文件相对于该目录的路径。
+ *
+ * 用法：`EasyEnginePacker <输入目录> <输出文件> [对齐字节数]`
+ * @see EasyEngine::PackFile
+ */
+#include "Resources.h"
+
+#include <bit>
+#include <charconv>
+
+using namespace EasyEngine;
+
+static Resource::Type guessType(const std::filesystem::path& path) {
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".gif" ||
+        ext == ".webp" || ext == ".tga" || ext == ".svg") return Resource::Image;
+    if (ext == ".ttf" || ext == ".otf" || ext == ".ttc") return Resource::Font;
+    if (ext == ".wav" || ext == ".ogg" || ext == ".mp3" || ext == ".flac" || ext == ".opus") return Resource::Audio;
+    if (ext == ".txt" || ext == ".json" || ext == ".def" || ext == ".xml" || ext == ".ini") return Resource::Text;
+    return Resource::Binary;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        fmt::println("Usage: {} <input directory> <output file> [alignment]", argv[0]);
+        return 1;
+    }
+    std::filesystem::path input(argv[1]);
+    if (!std::filesystem::is_directory(input)) {
+        fmt::println("[ERROR] '{}' is not a directory!", input.string());
+        return 1;
+    }
+    uint32_t alignment = 16;
+    if (argc > 3) {
+        // 对齐字节数必须是完整的十进制数字，且为 2 的幂
+        std::string_view text(argv[3]);
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), alignment);
+        if (ec != std::errc() || end != text.data() + text.size() || !std::has_single_bit(alignment)) {
+            fmt::println("[ERROR] Invalid alignment '{}', expected a power of two!", text);
+            fmt::println("Usage: {} <input directory> <output file> [alignment]", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<PackFile::Source> sources;
+    for (auto& item : std::filesystem::recursive_directory_iterator(input)) {
+        if (!item.is_regular_file()) continue;
+        auto name = std::filesystem::relative(item.path(), input).generic_string();
+        sources.push_back({name, item.path().string(), guessType(item.path())});
+    }
+    // 按名称排序，保证输出稳定
+    std::ranges::sort(sources, {}, &PackFile::Source::name);
+
+    if (!PackFile::build(argv[2], sources, alignment)) {
+        fmt::println("[ERROR] Build pack file '{}' failed!", argv[2]);
+        return 1;
+    }
+    fmt::println("[INFO] Packed {} file(s) into '{}'.", sources.size(), argv[2]);
+    return 0;
+}